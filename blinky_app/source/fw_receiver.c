@@ -0,0 +1,531 @@
+/******************************************************************************
+* File Name:   fw_receiver.c
+*
+* Description: Firmware receiver of the Blinky app. Receives a signed image
+*              into the secondary slot with double-buffered, row-aligned writes
+*              and hashes it while it arrives.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fw_receiver.h"
+
+#if defined(CY_APP_FW_RECEIVER) || defined(CY_HOST_SIM)
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "fw_sha256.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* MCUboot image layout, see bootutil/image.h */
+#define FW_RECEIVER_IMAGE_MAGIC         (0x96f3b83dU)
+#define FW_RECEIVER_IMAGE_HEADER_SIZE   (32U)
+#define FW_RECEIVER_IMAGE_F_ENCRYPTED   (0x0000000CU)   /* AES128 | AES256 */
+#define FW_RECEIVER_TLV_INFO_MAGIC      (0x6907U)
+#define FW_RECEIVER_TLV_INFO_SIZE       (4U)
+#define FW_RECEIVER_TLV_SHA256          (0x10U)
+
+#define FW_RECEIVER_MIN(a, b)           (((a) < (b)) ? (a) : (b))
+#define FW_RECEIVER_ROUND_UP(x)         ((((x) + FW_RECEIVER_ROW_SIZE) - 1U) & \
+                                         ~(FW_RECEIVER_ROW_SIZE - 1U))
+
+#if (0U != (FW_RECEIVER_BLOCK_SIZE % FW_RECEIVER_ROW_SIZE)) || \
+    (FW_RECEIVER_BLOCK_SIZE < FW_RECEIVER_IMAGE_HEADER_SIZE)
+#error "FW_RECEIVER_BLOCK_SIZE must be a multiple of FW_RECEIVER_ROW_SIZE"
+#endif
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* One block is programmed while the next one is received into the other */
+static uint32_t fw_receiver_buf[2][FW_RECEIVER_BLOCK_SIZE / sizeof(uint32_t)];
+
+/* Last row of a block, padded with the erased value */
+static uint32_t fw_receiver_row[FW_RECEIVER_ROW_SIZE / sizeof(uint32_t)];
+
+/******************************************************************************
+ * Function Name: fw_receiver_get_le16/fw_receiver_get_le32
+ ******************************************************************************
+ * Summary:
+ *  Reads a little endian field of the start frame or of the image.
+ *
+ ******************************************************************************/
+static uint32_t fw_receiver_get_le16(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t fw_receiver_get_le32(const uint8_t *p)
+{
+    return fw_receiver_get_le16(p) | (fw_receiver_get_le16(p + 2) << 16);
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_reply
+ ******************************************************************************
+ * Summary:
+ *  Sends an ACK for FW_RECEIVER_OK, or a NAK followed by the error code.
+ *
+ ******************************************************************************/
+static int fw_receiver_reply(const fw_receiver_port_t *port, int rc)
+{
+    uint8_t reply[2] = { FW_RECEIVER_NAK, (uint8_t)rc };
+
+    if (FW_RECEIVER_OK == rc)
+    {
+        reply[0] = FW_RECEIVER_ACK;
+    }
+
+    if (0 != port->send(port->ctx, reply, (FW_RECEIVER_OK == rc) ? 1U : 2U))
+    {
+        return FW_RECEIVER_ERR_UART;
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_recv
+ ******************************************************************************
+ * Summary:
+ *  Receives len bytes and waits for them.
+ *
+ ******************************************************************************/
+static int fw_receiver_recv(const fw_receiver_port_t *port, uint8_t *buf, uint32_t len)
+{
+    if (0 != port->recv_start(port->ctx, buf, len))
+    {
+        return FW_RECEIVER_ERR_UART;
+    }
+
+    if (0 != port->recv_wait(port->ctx, FW_RECEIVER_TIMEOUT_MS))
+    {
+        return FW_RECEIVER_ERR_TIMEOUT;
+    }
+
+    return FW_RECEIVER_OK;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_program
+ ******************************************************************************
+ * Summary:
+ *  Programs a block row by row. The last row is padded with the erased value.
+ *  The first hash_len bytes are hashed while the flash programs their row.
+ *
+ * Parameters:
+ *  port     - Serial link and slot
+ *  off      - Slot offset of the block, row aligned
+ *  data     - Block
+ *  len      - Bytes in the block
+ *  sha      - Running image hash, NULL if hash_len is 0
+ *  hash_len - Bytes of the block covered by the image hash
+ *
+ * Return:
+ *  FW_RECEIVER_OK or FW_RECEIVER_ERR_FLASH
+ *
+ ******************************************************************************/
+static int fw_receiver_program(const fw_receiver_port_t *port, uint32_t off,
+                               const uint8_t *data, uint32_t len,
+                               fw_sha256_t *sha, uint32_t hash_len)
+{
+    for (uint32_t pos = 0U; pos < len; pos += FW_RECEIVER_ROW_SIZE)
+    {
+        const uint8_t *row = data + pos;
+        uint32_t chunk = FW_RECEIVER_MIN(len - pos, FW_RECEIVER_ROW_SIZE);
+
+        if (FW_RECEIVER_ROW_SIZE != chunk)
+        {
+            memcpy(fw_receiver_row, row, chunk);
+            memset((uint8_t *)fw_receiver_row + chunk, port->erased_val,
+                   FW_RECEIVER_ROW_SIZE - chunk);
+            row = (const uint8_t *)fw_receiver_row;
+        }
+
+        if (0 != port->program_start(port->ctx, off + pos, row))
+        {
+            return FW_RECEIVER_ERR_FLASH;
+        }
+
+        if (pos < hash_len)
+        {
+            fw_sha256_update(sha, data + pos, FW_RECEIVER_MIN(chunk, hash_len - pos));
+        }
+
+        if (0 != port->program_wait(port->ctx))
+        {
+            return FW_RECEIVER_ERR_FLASH;
+        }
+    }
+
+    return FW_RECEIVER_OK;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_check_start
+ ******************************************************************************
+ * Summary:
+ *  Checks that the announced image and trailer fit the slot without
+ *  overlapping, then erases the row holding the trailer magic so that an
+ *  interrupted transfer never leaves an upgrade pending.
+ *
+ ******************************************************************************/
+static int fw_receiver_check_start(const fw_receiver_port_t *port,
+                                   const fw_receiver_start_t *start)
+{
+    if (FW_RECEIVER_MAGIC != start->magic)
+    {
+        return FW_RECEIVER_ERR_FRAME;
+    }
+
+    if ((port->slot_size != start->slot_size) ||
+        (0U != (start->trailer_size % FW_RECEIVER_ROW_SIZE)) ||
+        (start->trailer_size > start->slot_size) ||
+        (start->image_size < (FW_RECEIVER_IMAGE_HEADER_SIZE + FW_RECEIVER_TLV_INFO_SIZE)) ||
+        (start->image_size > (start->slot_size - start->trailer_size)) ||
+        (FW_RECEIVER_ROUND_UP(start->image_size) > (start->slot_size - start->trailer_size)))
+    {
+        return FW_RECEIVER_ERR_SIZE;
+    }
+
+    memset(fw_receiver_row, port->erased_val, sizeof(fw_receiver_row));
+
+    return fw_receiver_program(port, start->slot_size - FW_RECEIVER_ROW_SIZE,
+                               (const uint8_t *)fw_receiver_row, FW_RECEIVER_ROW_SIZE,
+                               NULL, 0U);
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_parse_header
+ ******************************************************************************
+ * Summary:
+ *  Parses the MCUboot image header at the start of the first block and
+ *  returns the length of the hashed part: header, image and protected TLVs.
+ *
+ ******************************************************************************/
+static int fw_receiver_parse_header(const uint8_t *hdr, uint32_t image_size,
+                                    uint32_t *hashed_len)
+{
+    uint32_t len;
+
+    if ((FW_RECEIVER_IMAGE_MAGIC != fw_receiver_get_le32(hdr)) ||
+        (0U != (fw_receiver_get_le32(hdr + 16) & FW_RECEIVER_IMAGE_F_ENCRYPTED)))
+    {
+        return FW_RECEIVER_ERR_HEADER;
+    }
+
+    /* ih_hdr_size + ih_img_size + ih_protect_tlv_size */
+    len = fw_receiver_get_le16(hdr + 8) + fw_receiver_get_le32(hdr + 12) +
+          fw_receiver_get_le16(hdr + 10);
+
+    if ((len < FW_RECEIVER_IMAGE_HEADER_SIZE) ||
+        (len > (image_size - FW_RECEIVER_TLV_INFO_SIZE)))
+    {
+        return FW_RECEIVER_ERR_HEADER;
+    }
+
+    *hashed_len = len;
+
+    return FW_RECEIVER_OK;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_check_hash
+ ******************************************************************************
+ * Summary:
+ *  Reads the SHA-256 TLV back from the slot and compares it with the hash
+ *  computed while the image was received. Reading it from the flash instead
+ *  of the receive buffers also checks that the TLV area was programmed.
+ *
+ ******************************************************************************/
+static int fw_receiver_check_hash(const fw_receiver_port_t *port, fw_sha256_t *sha,
+                                  uint32_t hashed_len, uint32_t image_size)
+{
+    uint8_t digest[FW_SHA256_DIGEST_SIZE];
+    uint8_t tlv[FW_SHA256_DIGEST_SIZE];
+    uint32_t off = hashed_len + FW_RECEIVER_TLV_INFO_SIZE;
+    uint32_t end;
+
+    fw_sha256_finish(sha, digest);
+
+    if (0 != port->read(port->ctx, hashed_len, tlv, FW_RECEIVER_TLV_INFO_SIZE))
+    {
+        return FW_RECEIVER_ERR_FLASH;
+    }
+
+    end = hashed_len + fw_receiver_get_le16(tlv + 2);
+    if ((FW_RECEIVER_TLV_INFO_MAGIC != fw_receiver_get_le16(tlv)) || (end > image_size))
+    {
+        return FW_RECEIVER_ERR_HASH;
+    }
+
+    while ((off + FW_RECEIVER_TLV_INFO_SIZE) <= end)
+    {
+        uint32_t type;
+        uint32_t len;
+
+        if (0 != port->read(port->ctx, off, tlv, FW_RECEIVER_TLV_INFO_SIZE))
+        {
+            return FW_RECEIVER_ERR_FLASH;
+        }
+
+        type = fw_receiver_get_le16(tlv);
+        len = fw_receiver_get_le16(tlv + 2);
+        off += FW_RECEIVER_TLV_INFO_SIZE;
+
+        if ((FW_RECEIVER_TLV_SHA256 == type) && (FW_SHA256_DIGEST_SIZE == len) &&
+            ((off + len) <= end))
+        {
+            if (0 != port->read(port->ctx, off, tlv, len))
+            {
+                return FW_RECEIVER_ERR_FLASH;
+            }
+
+            return (0 == memcmp(tlv, digest, sizeof(digest))) ?
+                   FW_RECEIVER_OK : FW_RECEIVER_ERR_HASH;
+        }
+
+        off += len;
+    }
+
+    return FW_RECEIVER_ERR_HASH;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_recv_image
+ ******************************************************************************
+ * Summary:
+ *  Streams the image into the slot. The receive of the next block is started
+ *  before the current one is programmed and acknowledged, so the UART keeps
+ *  receiving while the flash programs.
+ *
+ ******************************************************************************/
+static int fw_receiver_recv_image(const fw_receiver_port_t *port, uint32_t image_size,
+                                  fw_sha256_t *sha, uint32_t *hashed_len)
+{
+    uint32_t pos = 0U;
+    uint32_t len = FW_RECEIVER_MIN(image_size, FW_RECEIVER_BLOCK_SIZE);
+    uint32_t cur = 0U;
+    bool armed = false;
+    int rc = FW_RECEIVER_OK;
+
+    if (0 != port->recv_start(port->ctx, (uint8_t *)fw_receiver_buf[cur], len))
+    {
+        return FW_RECEIVER_ERR_UART;
+    }
+    armed = true;
+
+    while (pos < image_size)
+    {
+        const uint8_t *block = (const uint8_t *)fw_receiver_buf[cur];
+        uint32_t next_len = FW_RECEIVER_MIN(image_size - (pos + len), FW_RECEIVER_BLOCK_SIZE);
+
+        if (0 != port->recv_wait(port->ctx, FW_RECEIVER_TIMEOUT_MS))
+        {
+            return FW_RECEIVER_ERR_TIMEOUT;
+        }
+        armed = false;
+
+        if (0U == pos)
+        {
+            rc = fw_receiver_parse_header(block, image_size, hashed_len);
+            if (FW_RECEIVER_OK != rc)
+            {
+                break;
+            }
+        }
+
+        if (0U != next_len)
+        {
+            if (0 != port->recv_start(port->ctx, (uint8_t *)fw_receiver_buf[cur ^ 1U], next_len))
+            {
+                return FW_RECEIVER_ERR_UART;
+            }
+            armed = true;
+        }
+
+        rc = fw_receiver_program(port, pos, block, len, sha,
+                                 (pos < *hashed_len) ? (*hashed_len - pos) : 0U);
+        if (FW_RECEIVER_OK == rc)
+        {
+            rc = fw_receiver_reply(port, FW_RECEIVER_OK);
+        }
+        if (FW_RECEIVER_OK != rc)
+        {
+            break;
+        }
+
+        pos += len;
+        len = next_len;
+        cur ^= 1U;
+    }
+
+    if (armed)
+    {
+        port->recv_abort(port->ctx);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_recv_trailer
+ ******************************************************************************
+ * Summary:
+ *  Writes the end of the padded slot, one acknowledged block at a time. It
+ *  holds the trailer magic that makes the bootloader pick up the image.
+ *
+ ******************************************************************************/
+static int fw_receiver_recv_trailer(const fw_receiver_port_t *port, uint32_t slot_size,
+                                    uint32_t trailer_size)
+{
+    uint8_t *block = (uint8_t *)fw_receiver_buf[0];
+    int rc = FW_RECEIVER_OK;
+
+    for (uint32_t pos = 0U; (FW_RECEIVER_OK == rc) && (pos < trailer_size);
+         pos += FW_RECEIVER_BLOCK_SIZE)
+    {
+        uint32_t len = FW_RECEIVER_MIN(trailer_size - pos, FW_RECEIVER_BLOCK_SIZE);
+
+        rc = fw_receiver_recv(port, block, len);
+        if (FW_RECEIVER_OK == rc)
+        {
+            rc = fw_receiver_program(port, (slot_size - trailer_size) + pos, block, len,
+                                     NULL, 0U);
+        }
+
+        /* The ACK of the last block ends the transfer */
+        (void)fw_receiver_reply(port, rc);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_run
+ ******************************************************************************
+ * Summary:
+ *  Receives a signed image into the secondary slot: the start frame, the
+ *  image, which is hashed as it arrives and checked against its SHA-256 TLV,
+ *  and the slot trailer. Only the bytes up to the end of the image and the
+ *  trailer are sent, the padding in between is left as it is, because
+ *  MCUboot only reads the image and the trailer.
+ *
+ * Parameters:
+ *  port  - Serial link and slot
+ *  stats - Throughput of a successful transfer, may be NULL
+ *
+ * Return:
+ *  FW_RECEIVER_OK or the error code that was sent to the sender
+ *
+ ******************************************************************************/
+int fw_receiver_run(const fw_receiver_port_t *port, fw_receiver_stats_t *stats)
+{
+    uint8_t *frame = (uint8_t *)fw_receiver_buf[0];
+    fw_receiver_start_t start;
+    fw_sha256_t sha;
+    uint32_t hashed_len = 0U;
+    uint32_t start_ms;
+    bool baud_changed = false;
+    int rc;
+
+    rc = fw_receiver_recv(port, frame, sizeof(start));
+    if (FW_RECEIVER_OK != rc)
+    {
+        return fw_receiver_reply(port, rc);
+    }
+
+    start_ms = port->now_ms(port->ctx);
+    start.magic = fw_receiver_get_le32(frame);
+    start.slot_size = fw_receiver_get_le32(frame + 4);
+    start.image_size = fw_receiver_get_le32(frame + 8);
+    start.trailer_size = fw_receiver_get_le32(frame + 12);
+    start.baud = fw_receiver_get_le32(frame + 16);
+
+    rc = fw_receiver_reply(port, fw_receiver_check_start(port, &start));
+    if (FW_RECEIVER_OK != rc)
+    {
+        return rc;
+    }
+
+    if ((0U != start.baud) && (NULL != port->set_baud) && (start.baud != port->baud))
+    {
+        if (0 != port->set_baud(port->ctx, start.baud))
+        {
+            return FW_RECEIVER_ERR_UART;
+        }
+        baud_changed = true;
+    }
+
+    fw_sha256_init(&sha);
+    rc = fw_receiver_recv_image(port, start.image_size, &sha, &hashed_len);
+    if (FW_RECEIVER_OK == rc)
+    {
+        rc = fw_receiver_check_hash(port, &sha, hashed_len, start.image_size);
+        rc = fw_receiver_reply(port, rc);
+    }
+    else
+    {
+        (void)fw_receiver_reply(port, rc);
+    }
+
+    if (FW_RECEIVER_OK == rc)
+    {
+        rc = fw_receiver_recv_trailer(port, start.slot_size, start.trailer_size);
+    }
+
+    if (baud_changed)
+    {
+        (void)port->set_baud(port->ctx, port->baud);
+    }
+
+    if ((FW_RECEIVER_OK == rc) && (NULL != stats))
+    {
+        stats->bytes = start.image_size + start.trailer_size;
+        stats->elapsed_ms = port->now_ms(port->ctx) - start_ms;
+        stats->bytes_per_s = (0U != stats->elapsed_ms) ?
+                             (uint32_t)(((uint64_t)stats->bytes * 1000U) / stats->elapsed_ms) :
+                             0U;
+    }
+
+    return rc;
+}
+
+#endif /* CY_APP_FW_RECEIVER || CY_HOST_SIM */
+
+/* [] END OF FILE */
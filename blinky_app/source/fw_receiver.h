@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:   fw_receiver.h
+*
+* Description: Firmware receiver of the Blinky app. Streams a signed image over
+*              a serial link into the secondary slot and checks its hash.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FW_RECEIVER_H
+#define FW_RECEIVER_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Program unit of the secondary slot, the PSoC 6 flash row */
+#ifndef FW_RECEIVER_ROW_SIZE
+#define FW_RECEIVER_ROW_SIZE        (512U)
+#endif /* FW_RECEIVER_ROW_SIZE */
+
+/* Size of each of the two receive buffers, a multiple of the row size. Every
+ * block is acknowledged once it is programmed.
+ */
+#ifndef FW_RECEIVER_BLOCK_SIZE
+#define FW_RECEIVER_BLOCK_SIZE      (4U * FW_RECEIVER_ROW_SIZE)
+#endif /* FW_RECEIVER_BLOCK_SIZE */
+
+/* Longest wait for the start frame or a block */
+#ifndef FW_RECEIVER_TIMEOUT_MS
+#define FW_RECEIVER_TIMEOUT_MS      (3000U)
+#endif /* FW_RECEIVER_TIMEOUT_MS */
+
+#define FW_RECEIVER_MAGIC           (0x58525746U)   /* "FWRX" */
+
+/* Responses to the sender. A NAK is followed by one of the error codes. */
+#define FW_RECEIVER_ACK             (0x06U)
+#define FW_RECEIVER_NAK             (0x15U)
+
+/* Return values of fw_receiver_run() */
+#define FW_RECEIVER_OK              (0)
+#define FW_RECEIVER_ERR_FRAME       (1)     /* No or malformed start frame */
+#define FW_RECEIVER_ERR_SIZE        (2)     /* Image does not fit the slot */
+#define FW_RECEIVER_ERR_HEADER      (3)     /* Not an MCUboot image */
+#define FW_RECEIVER_ERR_TIMEOUT     (4)
+#define FW_RECEIVER_ERR_FLASH       (5)
+#define FW_RECEIVER_ERR_HASH        (6)     /* SHA-256 TLV missing or wrong */
+#define FW_RECEIVER_ERR_UART        (7)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Start frame of a transfer, little endian. The image follows in blocks of
+ * FW_RECEIVER_BLOCK_SIZE bytes: the sender may send two blocks ahead, and one
+ * more for every ACK. After the ACK of the image check, the trailer follows
+ * one block at a time.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t slot_size;         /* Slot size the image was padded for */
+    uint32_t image_size;        /* Signed image, from the header to the last TLV */
+    uint32_t trailer_size;      /* End of the padded slot, written last */
+    uint32_t baud;              /* Baud rate of the transfer, 0 to keep it */
+} fw_receiver_start_t;
+
+/* Serial link and secondary slot. Offsets are relative to the slot. */
+typedef struct
+{
+    /* Starts receiving len bytes into buf and returns at once */
+    int (*recv_start)(void *ctx, uint8_t *buf, uint32_t len);
+    /* Waits for the started receive, fails and aborts it after timeout_ms */
+    int (*recv_wait)(void *ctx, uint32_t timeout_ms);
+    void (*recv_abort)(void *ctx);
+    int (*send)(void *ctx, const uint8_t *buf, uint32_t len);
+    /* Optional, changes the baud rate once the sent bytes are out */
+    int (*set_baud)(void *ctx, uint32_t baud);
+    /* Starts erasing and programming one row, and waits for it */
+    int (*program_start)(void *ctx, uint32_t off, const uint8_t *row);
+    int (*program_wait)(void *ctx);
+    int (*read)(void *ctx, uint32_t off, uint8_t *buf, uint32_t len);
+    uint32_t (*now_ms)(void *ctx);
+    uint32_t slot_size;
+    uint32_t baud;              /* Baud rate restored after the transfer */
+    uint8_t erased_val;
+    void *ctx;
+} fw_receiver_port_t;
+
+typedef struct
+{
+    uint32_t bytes;             /* Image and trailer bytes received */
+    uint32_t elapsed_ms;        /* From the start frame to the last ACK */
+    uint32_t bytes_per_s;
+} fw_receiver_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int fw_receiver_run(const fw_receiver_port_t *port, fw_receiver_stats_t *stats);
+
+#endif /* FW_RECEIVER_H */
+
+/* [] END OF FILE */
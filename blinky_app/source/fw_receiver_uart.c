@@ -0,0 +1,284 @@
+/******************************************************************************
+* File Name:   fw_receiver_uart.c
+*
+* Description: Port of the firmware receiver to the debug UART of retarget-io,
+*              with DMA receives, and to the internal flash through the HAL.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fw_receiver_uart.h"
+
+#if defined(CY_APP_FW_RECEIVER)
+
+#include <stdbool.h>
+
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set by the Blinky app Makefile from the flash map */
+#ifndef SECONDARY_IMG_START
+#error "SECONDARY_IMG_START is not defined"
+#endif /* SECONDARY_IMG_START */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    cyhal_uart_t *uart;
+    cyhal_flash_t flash;
+    uint32_t cycles_per_ms;
+    uint32_t last_cycles;       /* DWT->CYCCNT at the last now_ms() call */
+    uint32_t ms;
+    uint32_t rem_cycles;        /* Cycles not yet counted in ms */
+} fw_uart_ctx_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static fw_uart_ctx_t fw_uart_ctx;
+
+/******************************************************************************
+ * Function Name: fw_uart_now_ms
+ ******************************************************************************
+ * Summary:
+ *  Milliseconds from the DWT cycle counter. The counter wraps within a
+ *  minute at the usual core clocks, so the elapsed cycles are accumulated at
+ *  every call. The receive loop calls it well within that period.
+ *
+ ******************************************************************************/
+static uint32_t fw_uart_now_ms(void *ctx)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+    uint32_t cycles = DWT->CYCCNT;
+
+    uc->rem_cycles += cycles - uc->last_cycles;
+    uc->last_cycles = cycles;
+    uc->ms += uc->rem_cycles / uc->cycles_per_ms;
+    uc->rem_cycles %= uc->cycles_per_ms;
+
+    return uc->ms;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_recv_start
+ ******************************************************************************
+ * Summary:
+ *  Starts a DMA receive, so the next block arrives while a row programs.
+ *
+ ******************************************************************************/
+static int fw_uart_recv_start(void *ctx, uint8_t *buf, uint32_t len)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+
+    return (CY_RSLT_SUCCESS == cyhal_uart_read_async(uc->uart, buf, len)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_recv_wait
+ ******************************************************************************/
+static int fw_uart_recv_wait(void *ctx, uint32_t timeout_ms)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+    uint32_t start_ms = fw_uart_now_ms(ctx);
+
+    while (cyhal_uart_is_rx_active(uc->uart))
+    {
+        if ((fw_uart_now_ms(ctx) - start_ms) > timeout_ms)
+        {
+            (void)cyhal_uart_read_abort(uc->uart);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_recv_abort
+ ******************************************************************************/
+static void fw_uart_recv_abort(void *ctx)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+
+    (void)cyhal_uart_read_abort(uc->uart);
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_send
+ ******************************************************************************/
+static int fw_uart_send(void *ctx, const uint8_t *buf, uint32_t len)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+    size_t n = len;
+
+    return ((CY_RSLT_SUCCESS == cyhal_uart_write(uc->uart, (void *)buf, &n)) && (len == n)) ?
+           0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_set_baud
+ ******************************************************************************
+ * Summary:
+ *  Changes the baud rate once the last ACK is out.
+ *
+ ******************************************************************************/
+static int fw_uart_set_baud(void *ctx, uint32_t baud)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+    uint32_t actual = 0U;
+
+    while (cyhal_uart_is_tx_active(uc->uart))
+    {
+    }
+
+    return (CY_RSLT_SUCCESS == cyhal_uart_set_baud(uc->uart, baud, &actual)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_program_start
+ ******************************************************************************
+ * Summary:
+ *  Starts erasing and programming a row of the secondary slot without
+ *  blocking, so the row is hashed while the flash is busy.
+ *
+ ******************************************************************************/
+static int fw_uart_program_start(void *ctx, uint32_t off, const uint8_t *row)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+
+    return (CY_RSLT_SUCCESS == cyhal_flash_start_write(&uc->flash, SECONDARY_IMG_START + off,
+                                                       (const uint32_t *)(const void *)row)) ?
+           0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_program_wait
+ ******************************************************************************/
+static int fw_uart_program_wait(void *ctx)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+
+    while (!cyhal_flash_is_operation_complete(&uc->flash))
+    {
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: fw_uart_read
+ ******************************************************************************/
+static int fw_uart_read(void *ctx, uint32_t off, uint8_t *buf, uint32_t len)
+{
+    fw_uart_ctx_t *uc = (fw_uart_ctx_t *)ctx;
+
+    return (CY_RSLT_SUCCESS == cyhal_flash_read(&uc->flash, SECONDARY_IMG_START + off,
+                                                buf, len)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: fw_receiver_uart_run
+ ******************************************************************************
+ * Summary:
+ *  Receives an image into the secondary slot over the debug UART of
+ *  retarget-io, see fw_receiver_run(). Call it when the first byte of the
+ *  start frame is readable. The UART is put back in the blocking mode of
+ *  retarget-io afterwards.
+ *
+ * Parameters:
+ *  stats - Throughput of a successful transfer
+ *
+ * Return:
+ *  FW_RECEIVER_OK or an FW_RECEIVER_ERR_ code
+ *
+ ******************************************************************************/
+int fw_receiver_uart_run(fw_receiver_stats_t *stats)
+{
+    static const fw_receiver_port_t port_template =
+    {
+        .recv_start = fw_uart_recv_start,
+        .recv_wait = fw_uart_recv_wait,
+        .recv_abort = fw_uart_recv_abort,
+        .send = fw_uart_send,
+        .set_baud = fw_uart_set_baud,
+        .program_start = fw_uart_program_start,
+        .program_wait = fw_uart_program_wait,
+        .read = fw_uart_read,
+        .now_ms = fw_uart_now_ms,
+        .slot_size = USER_APP_SIZE,
+        .baud = CY_RETARGET_IO_BAUDRATE,
+        .erased_val = 0U,
+        .ctx = &fw_uart_ctx
+    };
+    int rc;
+
+    fw_uart_ctx.uart = &cy_retarget_io_uart_obj;
+    fw_uart_ctx.cycles_per_ms = SystemCoreClock / 1000U;
+    fw_uart_ctx.ms = 0U;
+    fw_uart_ctx.rem_cycles = 0U;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    fw_uart_ctx.last_cycles = DWT->CYCCNT;
+
+    if (CY_RSLT_SUCCESS != cyhal_flash_init(&fw_uart_ctx.flash))
+    {
+        return FW_RECEIVER_ERR_FLASH;
+    }
+
+    if (CY_RSLT_SUCCESS != cyhal_uart_set_async_mode(fw_uart_ctx.uart, CYHAL_ASYNC_DMA,
+                                                     CYHAL_DMA_PRIORITY_DEFAULT))
+    {
+        cyhal_flash_free(&fw_uart_ctx.flash);
+        return FW_RECEIVER_ERR_UART;
+    }
+
+    rc = fw_receiver_run(&port_template, stats);
+
+    (void)cyhal_uart_set_async_mode(fw_uart_ctx.uart, CYHAL_ASYNC_SW, CYHAL_DMA_PRIORITY_DEFAULT);
+    cyhal_flash_free(&fw_uart_ctx.flash);
+
+    return rc;
+}
+
+#endif /* CY_APP_FW_RECEIVER */
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/******************************************************************************
+* File Name:   fw_sha256.c
+*
+* Description: Compact SHA-256 (FIPS 180-4) used by the firmware receiver to
+*              hash an image while it is received, without the crypto libraries
+*              of the bootloader.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fw_sha256.h"
+
+#if defined(CY_APP_FW_RECEIVER) || defined(CY_HOST_SIM)
+
+#include <string.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define FW_SHA256_ROTR(x, n)        (((x) >> (n)) | ((x) << (32U - (n))))
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t fw_sha256_k[64] =
+{
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+/******************************************************************************
+ * Function Name: fw_sha256_block
+ ******************************************************************************
+ * Summary:
+ *  Processes one 64-byte block.
+ *
+ ******************************************************************************/
+static void fw_sha256_block(fw_sha256_t *ctx, const uint8_t *data)
+{
+    uint32_t w[64];
+    uint32_t v[8];
+
+    for (uint32_t i = 0U; i < 16U; i++)
+    {
+        w[i] = ((uint32_t)data[4U * i] << 24) | ((uint32_t)data[(4U * i) + 1U] << 16) |
+               ((uint32_t)data[(4U * i) + 2U] << 8) | (uint32_t)data[(4U * i) + 3U];
+    }
+
+    for (uint32_t i = 16U; i < 64U; i++)
+    {
+        uint32_t s0 = FW_SHA256_ROTR(w[i - 15U], 7U) ^ FW_SHA256_ROTR(w[i - 15U], 18U) ^
+                      (w[i - 15U] >> 3);
+        uint32_t s1 = FW_SHA256_ROTR(w[i - 2U], 17U) ^ FW_SHA256_ROTR(w[i - 2U], 19U) ^
+                      (w[i - 2U] >> 10);
+
+        w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+    }
+
+    memcpy(v, ctx->state, sizeof(v));
+
+    for (uint32_t i = 0U; i < 64U; i++)
+    {
+        uint32_t s1 = FW_SHA256_ROTR(v[4], 6U) ^ FW_SHA256_ROTR(v[4], 11U) ^
+                      FW_SHA256_ROTR(v[4], 25U);
+        uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint32_t t1 = v[7] + s1 + ch + fw_sha256_k[i] + w[i];
+        uint32_t s0 = FW_SHA256_ROTR(v[0], 2U) ^ FW_SHA256_ROTR(v[0], 13U) ^
+                      FW_SHA256_ROTR(v[0], 22U);
+        uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + s0 + maj;
+    }
+
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        ctx->state[i] += v[i];
+    }
+}
+
+/******************************************************************************
+ * Function Name: fw_sha256_init
+ ******************************************************************************/
+void fw_sha256_init(fw_sha256_t *ctx)
+{
+    static const uint32_t init[8] =
+    {
+        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+        0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+    };
+
+    memcpy(ctx->state, init, sizeof(init));
+    ctx->length = 0U;
+    ctx->used = 0U;
+}
+
+/******************************************************************************
+ * Function Name: fw_sha256_update
+ ******************************************************************************
+ * Summary:
+ *  Hashes len more bytes. Whole blocks are processed without being copied.
+ *
+ ******************************************************************************/
+void fw_sha256_update(fw_sha256_t *ctx, const uint8_t *data, uint32_t len)
+{
+    ctx->length += len;
+
+    if (0U != ctx->used)
+    {
+        uint32_t n = FW_SHA256_BLOCK_SIZE - ctx->used;
+
+        n = (len < n) ? len : n;
+        memcpy(&ctx->block[ctx->used], data, n);
+        ctx->used += n;
+        data += n;
+        len -= n;
+
+        if (FW_SHA256_BLOCK_SIZE == ctx->used)
+        {
+            fw_sha256_block(ctx, ctx->block);
+            ctx->used = 0U;
+        }
+    }
+
+    while (len >= FW_SHA256_BLOCK_SIZE)
+    {
+        fw_sha256_block(ctx, data);
+        data += FW_SHA256_BLOCK_SIZE;
+        len -= FW_SHA256_BLOCK_SIZE;
+    }
+
+    if (0U != len)
+    {
+        memcpy(ctx->block, data, len);
+        ctx->used = len;
+    }
+}
+
+/******************************************************************************
+ * Function Name: fw_sha256_finish
+ ******************************************************************************/
+void fw_sha256_finish(fw_sha256_t *ctx, uint8_t digest[FW_SHA256_DIGEST_SIZE])
+{
+    uint64_t bits = ctx->length * 8U;
+
+    ctx->block[ctx->used++] = 0x80U;
+    if (ctx->used > (FW_SHA256_BLOCK_SIZE - 8U))
+    {
+        memset(&ctx->block[ctx->used], 0, FW_SHA256_BLOCK_SIZE - ctx->used);
+        fw_sha256_block(ctx, ctx->block);
+        ctx->used = 0U;
+    }
+    memset(&ctx->block[ctx->used], 0, FW_SHA256_BLOCK_SIZE - 8U - ctx->used);
+
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        ctx->block[FW_SHA256_BLOCK_SIZE - 1U - i] = (uint8_t)(bits >> (8U * i));
+    }
+    fw_sha256_block(ctx, ctx->block);
+
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        digest[4U * i] = (uint8_t)(ctx->state[i] >> 24);
+        digest[(4U * i) + 1U] = (uint8_t)(ctx->state[i] >> 16);
+        digest[(4U * i) + 2U] = (uint8_t)(ctx->state[i] >> 8);
+        digest[(4U * i) + 3U] = (uint8_t)ctx->state[i];
+    }
+}
+
+#endif /* CY_APP_FW_RECEIVER || CY_HOST_SIM */
+
+/* [] END OF FILE */
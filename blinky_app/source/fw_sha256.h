@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name:   fw_sha256.h
+*
+* Description: SHA-256 used by the firmware receiver of the Blinky app to hash
+*              an image while it is received.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FW_SHA256_H
+#define FW_SHA256_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define FW_SHA256_DIGEST_SIZE       (32U)
+#define FW_SHA256_BLOCK_SIZE        (64U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t state[8];
+    uint64_t length;            /* Bytes hashed so far */
+    uint8_t  block[FW_SHA256_BLOCK_SIZE];
+    uint32_t used;              /* Bytes in block */
+} fw_sha256_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fw_sha256_init(fw_sha256_t *ctx);
+void fw_sha256_update(fw_sha256_t *ctx, const uint8_t *data, uint32_t len);
+void fw_sha256_finish(fw_sha256_t *ctx, uint8_t digest[FW_SHA256_DIGEST_SIZE]);
+
+#endif /* FW_SHA256_H */
+
+/* [] END OF FILE */
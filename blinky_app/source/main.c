@@ -47,6 +47,15 @@
 /* Header file which contains the function to Write Image OK flag to the slot trailer */
 #include "set_img_ok.h"
 #endif
+#if defined(CY_BOOT_TIMING) || defined(CY_BOOT_LOG_TOKENIZED)
+#include <string.h>
+/* Layout of the boot timing and boot log records left by the bootloader */
+#include "boot_shared_data.h"
+#endif
+#if defined(CY_APP_FW_RECEIVER)
+/* Receives an UPGRADE image into the secondary slot over the debug UART */
+#include "fw_receiver_uart.h"
+#endif
 
 /*******************************************************************************
 * Macros
@@ -71,6 +80,176 @@
 /* UART function parameter value to wait forever */
 #define UART_WAIT_FOR_EVER                      (0)
 
+#if defined(CY_APP_FW_RECEIVER)
+/* Interval at which the UART is checked for the start of a transfer */
+#define FW_RECEIVER_POLL_MS                     (10u)
+
+/* Time for the last message to leave the UART before the reset */
+#define FW_RECEIVER_RESET_DELAY_MS              (50u)
+#endif
+
+#if defined(CY_BOOT_TIMING)
+/* Names of the boot phases, in the order of boot_timing_phase_t */
+#define BOOT_TIMING_PHASE_NAMES     { "start", "bsp_init", "retarget_io", \
+                                      "qspi_init", "boot_go", "wdt_init", \
+                                      "handoff" }
+
+/******************************************************************************
+ * Function Name: print_boot_timing
+ ******************************************************************************
+ * Summary:
+ *  Prints the duration of every bootloader phase found in the shared data
+ *  area, followed by the raw record in hex for scripts/boot_timing_decode.py.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+static void print_boot_timing(void)
+{
+    static const char *const phase_names[BOOT_TIMING_PHASE_COUNT] = BOOT_TIMING_PHASE_NAMES;
+    const uint8_t *data;
+    boot_timing_record_t record;
+    uint16_t len = 0U;
+    uint32_t prev = 0U;
+
+    data = boot_shared_data_find((const uint8_t *)BOOT_SHARED_DATA_ADDRESS,
+                                 BOOT_SHARED_DATA_SIZE,
+                                 BOOT_SHARED_DATA_TLV_TYPE(BOOT_SHARED_DATA_MAJOR_CY,
+                                                           BOOT_SHARED_DATA_MINOR_TIMING),
+                                 &len);
+
+    if ((NULL == data) || (sizeof(record) != len))
+    {
+        printf("[Blinky App] No boot timing record from the bootloader\r\n");
+        return;
+    }
+
+    memcpy(&record, data, sizeof(record));
+    if ((BOOT_TIMING_RECORD_VERSION != record.version) || (0U == record.core_clock_hz))
+    {
+        printf("[Blinky App] Unsupported boot timing record\r\n");
+        return;
+    }
+
+    printf("[Blinky App] Bootloader phases at %lu Hz:\r\n", (unsigned long)record.core_clock_hz);
+    for (uint32_t i = 1U; i < BOOT_TIMING_PHASE_COUNT; i++)
+    {
+        if (0U != (record.valid_mask & (1U << i)))
+        {
+            printf("  %-12s %8lu us\r\n", phase_names[i],
+                   (unsigned long)(((uint64_t)(record.stamps[i] - prev) * 1000000U) /
+                                   record.core_clock_hz));
+            prev = record.stamps[i];
+        }
+    }
+    printf("  %-12s %8lu us\r\n", "total",
+           (unsigned long)(((uint64_t)prev * 1000000U) / record.core_clock_hz));
+
+    printf("BOOT_TIMING_RAW:");
+    for (uint32_t i = 0U; i < sizeof(record); i++)
+    {
+        printf("%02x", data[i]);
+    }
+    printf("\r\n");
+}
+#endif /* CY_BOOT_TIMING */
+
+#if defined(CY_BOOT_LOG_TOKENIZED)
+/******************************************************************************
+ * Function Name: print_boot_log
+ ******************************************************************************
+ * Summary:
+ *  Prints the tokenized log records of the bootloader as hex lines for
+ *  scripts/boot_log_detokenize.py. The records stay in the bootloader RAM,
+ *  which this app does not use, and are located through the shared data area.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+static void print_boot_log(void)
+{
+    const uint8_t *data;
+    boot_log_handoff_t handoff;
+    uint16_t len = 0U;
+    uint32_t first = 0U;
+
+    data = boot_shared_data_find((const uint8_t *)BOOT_SHARED_DATA_ADDRESS,
+                                 BOOT_SHARED_DATA_SIZE,
+                                 BOOT_SHARED_DATA_TLV_TYPE(BOOT_SHARED_DATA_MAJOR_CY,
+                                                           BOOT_SHARED_DATA_MINOR_LOG),
+                                 &len);
+
+    if ((NULL == data) || (sizeof(handoff) != len))
+    {
+        printf("[Blinky App] No boot log from the bootloader\r\n");
+        return;
+    }
+
+    memcpy(&handoff, data, sizeof(handoff));
+    if ((sizeof(boot_log_record_t) != handoff.record_size) || (0U == handoff.capacity))
+    {
+        printf("[Blinky App] Unsupported boot log\r\n");
+        return;
+    }
+
+    printf("[Blinky App] Bootloader log, decode with scripts/boot_log_detokenize.py:\r\n");
+    if (handoff.count > handoff.capacity)
+    {
+        first = handoff.count - handoff.capacity;
+        printf("BOOT_LOG_LOST:%lu\r\n", (unsigned long)first);
+    }
+
+    for (uint32_t n = first; n < handoff.count; n++)
+    {
+        const uint8_t *record = (const uint8_t *)handoff.records +
+                                ((n % handoff.capacity) * handoff.record_size);
+
+        printf("BOOT_LOG_RAW:");
+        for (uint32_t i = 0U; i < handoff.record_size; i++)
+        {
+            printf("%02x", record[i]);
+        }
+        printf("\r\n");
+    }
+}
+#endif /* CY_BOOT_LOG_TOKENIZED */
+
+#if defined(CY_APP_FW_RECEIVER)
+/******************************************************************************
+ * Function Name: receive_firmware
+ ******************************************************************************
+ * Summary:
+ *  Receives an UPGRADE image sent by scripts/fw_send.py into the secondary
+ *  slot and resets, so that the bootloader installs it. The image brings its
+ *  own trailer, which marks the upgrade pending.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+static void receive_firmware(void)
+{
+    fw_receiver_stats_t stats;
+    int rc = fw_receiver_uart_run(&stats);
+
+    if (FW_RECEIVER_OK != rc)
+    {
+        printf("[Blinky App] Firmware receive failed with error %d\r\n", rc);
+        return;
+    }
+
+    printf("[Blinky App] Firmware received: %lu bytes in %lu ms (%lu bytes/s)\r\n",
+           (unsigned long)stats.bytes, (unsigned long)stats.elapsed_ms,
+           (unsigned long)stats.bytes_per_s);
+    printf("[Blinky App] Resetting to start the upgrade\r\n");
+
+    cyhal_system_delay_ms(FW_RECEIVER_RESET_DELAY_MS);
+    NVIC_SystemReset();
+}
+#endif /* CY_APP_FW_RECEIVER */
+
 /******************************************************************************
  * Function Name: main
  ******************************************************************************
@@ -135,6 +314,14 @@ int main(void)
 
     printf("[Blinky App] Watchdog timer started by the bootloader is now turned off to mark the successful start of Blinky app.\r\n");
 
+#if defined(CY_BOOT_TIMING)
+    print_boot_timing();
+#endif
+
+#if defined(CY_BOOT_LOG_TOKENIZED)
+    print_boot_log();
+#endif
+
 /* After a successful swap-based upgrade*/
 #if !(SWAP_DISABLED) && defined(UPGRADE_IMAGE)
     int img_ok_status = IMG_OK_SET_FAILED;
@@ -175,10 +362,26 @@ int main(void)
 
     printf("[Blinky App] User LED toggles at %d msec interval\r\n\n", LED_TOGGLE_INTERVAL_MS);
 
+#if defined(CY_APP_FW_RECEIVER)
+    printf("[Blinky App] Waiting for an UPGRADE image from scripts/fw_send.py\r\n");
+#endif
+
     for (;;)
     {
+#if defined(CY_APP_FW_RECEIVER)
+        /* Check for the start of a transfer until the next toggle */
+        for (uint32_t ms = 0u; ms < LED_TOGGLE_INTERVAL_MS; ms += FW_RECEIVER_POLL_MS)
+        {
+            cyhal_system_delay_ms(FW_RECEIVER_POLL_MS);
+            if (0u != cyhal_uart_readable(&cy_retarget_io_uart_obj))
+            {
+                receive_firmware();
+            }
+        }
+#else
         /* Toggle the user LED periodically */
         cyhal_system_delay_ms(LED_TOGGLE_INTERVAL_MS);
+#endif
         /* Invert the user LED state */
         cyhal_gpio_toggle(CYBSP_USER_LED);
     }
@@ -0,0 +1,156 @@
+/******************************************************************************
+* File Name:   boot_log.c
+*
+* Description: Tokenized boot log, see boot_log.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "boot_log.h"
+
+/* MCUboot header files */
+#include "bootutil/boot_record.h"
+
+#if (0U != (BOOT_LOG_CAPACITY & (BOOT_LOG_CAPACITY - 1U)))
+#error "BOOT_LOG_CAPACITY must be a power of 2"
+#endif
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Left in place for the user app, which does not use the bootloader RAM */
+static boot_log_record_t boot_log_records[BOOT_LOG_CAPACITY];
+static uint32_t boot_log_count;
+
+/******************************************************************************
+ * Function Name: boot_log_write
+ ******************************************************************************
+ * Summary:
+ *  Stores one log record. Called through BOOT_LOG_TOKENIZED(), the arguments
+ *  are already converted to 32-bit words.
+ *
+ * Parameters:
+ *  info - log level << 4 | argument count
+ *  token - offset of the format string in the .boot_log_fmt section
+ *  ... - arguments, uint32_t each
+ *
+ ******************************************************************************/
+void boot_log_write(uint32_t info, uint32_t token, ...)
+{
+    boot_log_record_t *record = &boot_log_records[boot_log_count & (BOOT_LOG_CAPACITY - 1U)];
+    uint32_t nargs = BOOT_LOG_INFO_NARGS(info);
+    va_list args;
+
+    record->token = (uint16_t)token;
+    record->info = (uint8_t)info;
+    record->seq = (uint8_t)boot_log_count;
+
+    va_start(args, token);
+    for (uint32_t i = 0U; (i < nargs) && (i < BOOT_LOG_MAX_ARGS); i++)
+    {
+        record->args[i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    boot_log_count++;
+}
+
+/******************************************************************************
+ * Function Name: boot_log_publish
+ ******************************************************************************
+ * Summary:
+ *  Adds the location of the log records to the MCUboot shared data area, so
+ *  the user app can print them once the boot time no longer matters.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  0 on success, otherwise the error of boot_add_data_to_shared_area()
+ *
+ ******************************************************************************/
+int boot_log_publish(void)
+{
+    boot_log_handoff_t handoff;
+
+    handoff.records = (uint32_t)(uintptr_t)boot_log_records;
+    handoff.capacity = (uint16_t)BOOT_LOG_CAPACITY;
+    handoff.record_size = (uint16_t)sizeof(boot_log_record_t);
+    handoff.count = boot_log_count;
+
+    return boot_add_data_to_shared_area(BOOT_SHARED_DATA_MAJOR_CY,
+                                        BOOT_SHARED_DATA_MINOR_LOG,
+                                        sizeof(handoff),
+                                        (const uint8_t *)&handoff);
+}
+
+/******************************************************************************
+ * Function Name: boot_log_dump
+ ******************************************************************************
+ * Summary:
+ *  Prints the records as hex lines for scripts/boot_log_detokenize.py. Used
+ *  when no user app is started to take over the log, so it may block.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+void boot_log_dump(void)
+{
+    uint32_t first = 0U;
+
+    if (boot_log_count > BOOT_LOG_CAPACITY)
+    {
+        first = boot_log_count - BOOT_LOG_CAPACITY;
+        printf("BOOT_LOG_LOST:%lu\r\n", (unsigned long)first);
+    }
+
+    for (uint32_t n = first; n < boot_log_count; n++)
+    {
+        const uint8_t *data = (const uint8_t *)&boot_log_records[n & (BOOT_LOG_CAPACITY - 1U)];
+
+        printf("BOOT_LOG_RAW:");
+        for (uint32_t i = 0U; i < sizeof(boot_log_record_t); i++)
+        {
+            printf("%02x", data[i]);
+        }
+        printf("\r\n");
+    }
+}
+
+/* [] END OF FILE */
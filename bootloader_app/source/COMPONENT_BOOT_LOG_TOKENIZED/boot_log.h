@@ -0,0 +1,105 @@
+/******************************************************************************
+* File Name:   boot_log.h
+*
+* Description: Tokenized boot log. Log calls store a 16-bit token and their
+*              arguments as a fixed-size binary record in a RAM ring instead of
+*              formatting text and waiting for the UART.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_LOG_H
+#define BOOT_LOG_H
+
+#include <stdint.h>
+
+#include "boot_shared_data.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of records kept in RAM, must be a power of 2. The oldest records are
+ * overwritten when the bootloader logs more.
+ */
+#ifndef BOOT_LOG_CAPACITY
+#define BOOT_LOG_CAPACITY           (32U)
+#endif /* BOOT_LOG_CAPACITY */
+
+/* Argument count of a log call, up to 8 */
+#define BOOT_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define BOOT_LOG_NARGS(...) \
+    BOOT_LOG_NARGS_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+/* Every argument is stored as a 32-bit word. Pointers (%s, %p) are stored as
+ * addresses, the host tool reads constant strings from the ELF file.
+ */
+#define BOOT_LOG_ARG_(a)            ((uint32_t)(uintptr_t)(a))
+#define BOOT_LOG_ARGS_0()
+#define BOOT_LOG_ARGS_1(a)          , BOOT_LOG_ARG_(a)
+#define BOOT_LOG_ARGS_2(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_1(__VA_ARGS__)
+#define BOOT_LOG_ARGS_3(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_2(__VA_ARGS__)
+#define BOOT_LOG_ARGS_4(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_3(__VA_ARGS__)
+#define BOOT_LOG_ARGS_5(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_4(__VA_ARGS__)
+#define BOOT_LOG_ARGS_6(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_5(__VA_ARGS__)
+#define BOOT_LOG_ARGS_7(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_6(__VA_ARGS__)
+#define BOOT_LOG_ARGS_8(a, ...)     , BOOT_LOG_ARG_(a) BOOT_LOG_ARGS_7(__VA_ARGS__)
+#define BOOT_LOG_ARGS__(n, ...)     BOOT_LOG_ARGS_##n(__VA_ARGS__)
+#define BOOT_LOG_ARGS_(n, ...)      BOOT_LOG_ARGS__(n, __VA_ARGS__)
+
+/* Places the format string into the .boot_log_fmt section, which the linker
+ * script keeps out of the flash image, and logs its offset as the token.
+ */
+#define BOOT_LOG_TOKENIZED(level, _fmt, ...)                                \
+    do {                                                                    \
+        static const char boot_log_fmt_[]                                   \
+            __attribute__((section(".boot_log_fmt"), used, aligned(1))) =   \
+            _fmt;                                                           \
+        boot_log_write(((uint32_t)(level) << 4U) |                          \
+                       (uint32_t)BOOT_LOG_NARGS(__VA_ARGS__),               \
+                       (uint32_t)(uintptr_t)boot_log_fmt_                   \
+                       BOOT_LOG_ARGS_(BOOT_LOG_NARGS(__VA_ARGS__),          \
+                                      ##__VA_ARGS__));                      \
+    } while (0)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void boot_log_write(uint32_t info, uint32_t token, ...);
+int  boot_log_publish(void);
+void boot_log_dump(void);
+
+#endif /* BOOT_LOG_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/******************************************************************************
+* File Name:   mcuboot_p256_crypto_config.h
+*
+* Description: mbedTLS configuration of the minimal crypto build
+*              (USE_MINIMAL_CRYPTO=1). Compiles only what the ECDSA P-256
+*              verification and the SHA-256 image hash of MCUboot need.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef MCUBOOT_P256_CRYPTO_CONFIG_H
+#define MCUBOOT_P256_CRYPTO_CONFIG_H
+
+/*******************************************************************************
+* System support
+*******************************************************************************/
+/* Inline assembly multiply-accumulate of bn_mul.h for the Cortex-M cores */
+#define MBEDTLS_HAVE_ASM
+
+/* MBEDTLS_PLATFORM_C and MBEDTLS_PLATFORM_MEMORY are defined by the Makefile
+ * when the crypto arena is enabled (USE_CRYPTO_ARENA=1) */
+
+/*******************************************************************************
+* Elliptic curve: NIST P-256 only
+*******************************************************************************/
+/* The fast modular reduction of ecp_curves.c is the field arithmetic
+ * specialized for the P-256 prime. The generic reduction is not linked. */
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+
+/* Sizes the MPI limb storage for a 256-bit curve, instead of 8192-bit RSA */
+#define MBEDTLS_MPI_WINDOW_SIZE         1
+#define MBEDTLS_MPI_MAX_SIZE            32
+
+/* The comb table of the generator point is a constant table of ecp_curves.c,
+ * built only for the enabled curve. A window of 4 keeps the table of the
+ * public key point computed at run time in about 1 KB of RAM. */
+#define MBEDTLS_ECP_WINDOW_SIZE         4
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM   1
+
+/*******************************************************************************
+* Modules
+*******************************************************************************/
+/* ECDSA verification of the image signature (bootutil/src/image_ec256.c) */
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECDSA_C
+
+/* Parse of the public key and of the DER signature. check_config.h requires
+ * the ASN.1 writer with ECDSA, only its sign path references it. */
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+
+/* Image and key hash */
+#define MBEDTLS_SHA256_C
+
+#include "mbedtls/check_config.h"
+
+#endif /* MCUBOOT_P256_CRYPTO_CONFIG_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,365 @@
+/******************************************************************************
+* File Name:   boot_mem.c
+*
+* Description: Crypto arena and stack high-water measurement, see boot_mem.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "boot_mem.h"
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+
+#include <stdbool.h>
+#include <string.h>
+
+#if !defined(CY_HOST_SIM)
+#include "cy_pdl.h"
+#endif /* !defined(CY_HOST_SIM) */
+#include "mbedtls/platform.h"
+
+#if !defined(MBEDTLS_PLATFORM_MEMORY)
+#error "The crypto arena requires MBEDTLS_PLATFORM_MEMORY"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Allocations are aligned like malloc() */
+#define BOOT_MEM_ALIGN              (8U)
+#define BOOT_MEM_HDR_SIZE           (sizeof(boot_mem_hdr_t))
+
+/* Bit of the block size that marks a freed block */
+#define BOOT_MEM_FREE_FLAG          (1U)
+
+/* Size of a block without the free flag */
+#define BOOT_MEM_SIZE(hdr)          ((hdr)->size & ~BOOT_MEM_FREE_FLAG)
+
+/* A free block is only split if the rest can hold an allocation */
+#define BOOT_MEM_MIN_SPLIT          (BOOT_MEM_HDR_SIZE + BOOT_MEM_ALIGN)
+
+/* Value painted into the unused stack */
+#define BOOT_MEM_STACK_PATTERN      (0xA5A5A5A5U)
+
+/* Part of the stack below the stack pointer of boot_mem_init() that is left
+ * unpainted, for its own frame
+ */
+#define BOOT_MEM_STACK_GUARD        (64U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Header in front of every block. The header of the previous block is
+ * found through prev_size, so free neighbours can be merged and the arena
+ * can be unwound from the top. A free block is never the topmost block and
+ * never follows another free block.
+ */
+typedef struct
+{
+    uint32_t size;                  /* Block size with header, free flag */
+    uint32_t prev_size;             /* Size of the block below, 0 for the first */
+} boot_mem_hdr_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if !defined(CY_HOST_SIM)
+/* Stack limits from the linker script */
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+#endif /* !defined(CY_HOST_SIM) */
+
+static uint64_t boot_mem_arena[CRYPTO_ARENA_SIZE / sizeof(uint64_t)];
+static uint32_t boot_mem_top;           /* Offset of the first unused byte */
+static uint32_t boot_mem_last;          /* Size of the topmost block */
+static uint32_t boot_mem_used;          /* Bytes of the allocated blocks */
+static boot_mem_stats_t boot_mem_stats;
+
+/******************************************************************************
+ * Function Name: boot_mem_block
+ ******************************************************************************
+ * Summary:
+ *  Returns the header of the block at an arena offset.
+ *
+ ******************************************************************************/
+static boot_mem_hdr_t *boot_mem_block(uint32_t off)
+{
+    return (boot_mem_hdr_t *)(void *)&((uint8_t *)boot_mem_arena)[off];
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_take_free
+ ******************************************************************************
+ * Summary:
+ *  Takes the first free block below the top of the arena that fits. The
+ *  part that is not needed stays free.
+ *
+ * Return:
+ *  Header of the block, NULL if no free block fits
+ *
+ ******************************************************************************/
+static boot_mem_hdr_t *boot_mem_take_free(uint32_t need)
+{
+    boot_mem_hdr_t *hdr;
+    boot_mem_hdr_t *rest;
+    uint32_t off = 0U;
+    uint32_t size;
+
+    while (off < boot_mem_top)
+    {
+        hdr = boot_mem_block(off);
+        size = BOOT_MEM_SIZE(hdr);
+
+        if ((0U != (hdr->size & BOOT_MEM_FREE_FLAG)) && (size >= need))
+        {
+            /* A free block is never topmost, so a block follows it */
+            if ((size - need) >= BOOT_MEM_MIN_SPLIT)
+            {
+                rest = boot_mem_block(off + need);
+                rest->size = (size - need) | BOOT_MEM_FREE_FLAG;
+                rest->prev_size = need;
+                boot_mem_block(off + size)->prev_size = size - need;
+                size = need;
+            }
+
+            hdr->size = size;
+            return hdr;
+        }
+
+        off += size;
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_calloc
+ ******************************************************************************
+ * Summary:
+ *  Allocates zeroed memory from the first free block that fits, or else
+ *  from the top of the arena. mbedTLS frees its temporaries mostly in
+ *  reverse order, so most blocks are given back at the top of the arena.
+ *
+ * Return:
+ *  Pointer to the memory, NULL if it does not fit into the arena
+ *
+ ******************************************************************************/
+void *boot_mem_calloc(size_t n, size_t size)
+{
+    boot_mem_hdr_t *hdr;
+    uint32_t need;
+
+    if ((0U != n) && (size > ((CRYPTO_ARENA_SIZE - BOOT_MEM_HDR_SIZE) / n)))
+    {
+        boot_mem_stats.arena_failed++;
+        return NULL;
+    }
+
+    need = (uint32_t)(n * size) + BOOT_MEM_HDR_SIZE;
+    need = (need + BOOT_MEM_ALIGN - 1U) & ~(BOOT_MEM_ALIGN - 1U);
+
+    hdr = boot_mem_take_free(need);
+    if (NULL == hdr)
+    {
+        if (need > (CRYPTO_ARENA_SIZE - boot_mem_top))
+        {
+            boot_mem_stats.arena_failed++;
+            return NULL;
+        }
+
+        hdr = boot_mem_block(boot_mem_top);
+        hdr->size = need;
+        hdr->prev_size = boot_mem_last;
+
+        boot_mem_top += need;
+        boot_mem_last = need;
+    }
+
+    boot_mem_used += hdr->size;
+    boot_mem_stats.arena_allocs++;
+    if (boot_mem_top > boot_mem_stats.arena_peak)
+    {
+        boot_mem_stats.arena_peak = boot_mem_top;
+    }
+
+    (void)memset(&hdr[1], 0, hdr->size - BOOT_MEM_HDR_SIZE);
+
+    return &hdr[1];
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_free
+ ******************************************************************************
+ * Summary:
+ *  Frees a block and merges it with its free neighbours. A block that ends
+ *  at the top of the arena is given back to it.
+ *
+ ******************************************************************************/
+void boot_mem_free(void *ptr)
+{
+    boot_mem_hdr_t *hdr;
+    boot_mem_hdr_t *next;
+    boot_mem_hdr_t *prev;
+    uint32_t off;
+    uint32_t size;
+
+    if (NULL == ptr)
+    {
+        return;
+    }
+
+    hdr = (boot_mem_hdr_t *)ptr - 1;
+    off = (uint32_t)((uint8_t *)hdr - (uint8_t *)boot_mem_arena);
+    size = BOOT_MEM_SIZE(hdr);
+    boot_mem_used -= size;
+
+    if ((off + size) < boot_mem_top)
+    {
+        next = boot_mem_block(off + size);
+        if (0U != (next->size & BOOT_MEM_FREE_FLAG))
+        {
+            size += BOOT_MEM_SIZE(next);
+        }
+    }
+
+    if (0U != hdr->prev_size)
+    {
+        prev = boot_mem_block(off - hdr->prev_size);
+        if (0U != (prev->size & BOOT_MEM_FREE_FLAG))
+        {
+            off -= hdr->prev_size;
+            size += BOOT_MEM_SIZE(prev);
+            hdr = prev;
+        }
+    }
+
+    if ((off + size) == boot_mem_top)
+    {
+        /* The block below is in use, free blocks are merged */
+        boot_mem_top = off;
+        boot_mem_last = hdr->prev_size;
+    }
+    else
+    {
+        hdr->size = size | BOOT_MEM_FREE_FLAG;
+        boot_mem_block(off + size)->prev_size = size;
+    }
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_arena_reset
+ ******************************************************************************
+ * Summary:
+ *  Drops all allocations, e.g. after boot_go(). Bytes still allocated are
+ *  recorded in the statistics first.
+ *
+ ******************************************************************************/
+void boot_mem_arena_reset(void)
+{
+    boot_mem_stats.arena_in_use = boot_mem_used;
+    boot_mem_top = 0U;
+    boot_mem_last = 0U;
+    boot_mem_used = 0U;
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_stack_peak
+ ******************************************************************************
+ * Summary:
+ *  Finds the lowest stack word that no longer holds the paint pattern.
+ *
+ ******************************************************************************/
+static uint32_t boot_mem_stack_peak(void)
+{
+#if !defined(CY_HOST_SIM)
+    const uint32_t *word = __StackLimit;
+
+    while ((word < __StackTop) && (BOOT_MEM_STACK_PATTERN == *word))
+    {
+        word++;
+    }
+
+    return (uint32_t)((uintptr_t)__StackTop - (uintptr_t)word);
+#else
+    /* The host stack is not measured */
+    return 0U;
+#endif /* !defined(CY_HOST_SIM) */
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_init
+ ******************************************************************************
+ * Summary:
+ *  Paints the unused stack for the high-water measurement and routes the
+ *  mbedTLS allocations to the arena. Call it early in main().
+ *
+ ******************************************************************************/
+void boot_mem_init(void)
+{
+#if !defined(CY_HOST_SIM)
+    uint32_t *word = __StackLimit;
+    uint32_t *end = (uint32_t *)(uintptr_t)(__get_MSP() - BOOT_MEM_STACK_GUARD);
+
+    while (word < end)
+    {
+        *word = BOOT_MEM_STACK_PATTERN;
+        word++;
+    }
+#endif /* !defined(CY_HOST_SIM) */
+
+    (void)memset(&boot_mem_stats, 0, sizeof(boot_mem_stats));
+    boot_mem_stats.arena_size = CRYPTO_ARENA_SIZE;
+#if !defined(CY_HOST_SIM)
+    boot_mem_stats.stack_size = (uint32_t)((uintptr_t)__StackTop - (uintptr_t)__StackLimit);
+#endif /* !defined(CY_HOST_SIM) */
+    boot_mem_top = 0U;
+    boot_mem_last = 0U;
+    boot_mem_used = 0U;
+
+    (void)mbedtls_platform_set_calloc_free(boot_mem_calloc, boot_mem_free);
+}
+
+/******************************************************************************
+ * Function Name: boot_mem_get_stats
+ ******************************************************************************/
+void boot_mem_get_stats(boot_mem_stats_t *stats)
+{
+    boot_mem_stats.stack_peak = boot_mem_stack_peak();
+    *stats = boot_mem_stats;
+}
+
+#endif /* CY_BOOT_CRYPTO_ARENA */
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   boot_mem.h
+*
+* Description: Static arena for the mbedTLS allocations of the image validation
+*              and stack high-water measurement of the Bootloader app.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_MEM_H
+#define BOOT_MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the arena for the mbedTLS allocations, set by the Makefile */
+#ifndef CRYPTO_ARENA_SIZE
+#define CRYPTO_ARENA_SIZE           (0x3000U)
+#endif /* CRYPTO_ARENA_SIZE */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Arena and stack usage since boot_mem_init() */
+typedef struct
+{
+    uint32_t arena_size;
+    uint32_t arena_peak;            /* Highest arena use, headers included */
+    uint32_t arena_allocs;          /* Successful allocations */
+    uint32_t arena_failed;          /* Allocations that did not fit */
+    uint32_t arena_in_use;          /* Bytes not freed at the arena reset */
+    uint32_t stack_size;
+    uint32_t stack_peak;            /* Stack high-water mark */
+} boot_mem_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void boot_mem_init(void);
+void *boot_mem_calloc(size_t n, size_t size);
+void boot_mem_free(void *ptr);
+void boot_mem_arena_reset(void);
+void boot_mem_get_stats(boot_mem_stats_t *stats);
+
+#endif /* BOOT_MEM_H */
+
+/* [] END OF FILE */
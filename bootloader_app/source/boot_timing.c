@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   boot_timing.c
+*
+* Description: Boot phase timing of the Bootloader app, see boot_timing.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "boot_timing.h"
+
+#if defined(CY_BOOT_TIMING)
+
+#include <string.h>
+
+/* MCUboot header files */
+#include "bootutil/boot_record.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+uint32_t boot_timing_stamps[BOOT_TIMING_PHASE_COUNT];
+uint16_t boot_timing_valid_mask;
+
+/******************************************************************************
+ * Function Name: boot_timing_start
+ ******************************************************************************
+ * Summary:
+ *  Starts the DWT cycle counter from zero and takes the first stamp. Call it
+ *  first thing in main().
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+void boot_timing_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    boot_timing_mark(BOOT_TIMING_PHASE_START);
+}
+
+/******************************************************************************
+ * Function Name: boot_timing_publish
+ ******************************************************************************
+ * Summary:
+ *  Adds the timing record to the MCUboot shared data area, where the user
+ *  app can find it. Call it right before the jump to the user app.
+ *
+ *  The stamps are converted by the reader with the core clock at the time of
+ *  the call. cybsp_init() switches the clocks, so the BSP_INIT phase is only
+ *  approximate.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  0 on success, otherwise the error of boot_add_data_to_shared_area()
+ *
+ ******************************************************************************/
+int boot_timing_publish(void)
+{
+    boot_timing_record_t record;
+
+    record.version = BOOT_TIMING_RECORD_VERSION;
+    record.phase_count = (uint8_t)BOOT_TIMING_PHASE_COUNT;
+    record.valid_mask = boot_timing_valid_mask;
+    record.core_clock_hz = SystemCoreClock;
+    (void)memcpy(record.stamps, boot_timing_stamps, sizeof(record.stamps));
+
+    return boot_add_data_to_shared_area(BOOT_SHARED_DATA_MAJOR_CY,
+                                        BOOT_SHARED_DATA_MINOR_TIMING,
+                                        sizeof(record),
+                                        (const uint8_t *)&record);
+}
+
+#endif /* CY_BOOT_TIMING */
+
+/* [] END OF FILE */
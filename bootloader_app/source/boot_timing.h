@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name:   boot_timing.h
+*
+* Description: Boot phase timing of the Bootloader app. The DWT cycle counter
+*              is sampled at the end of every phase of main() and the stamps
+*              are passed to the user app through the MCUboot shared data area.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_TIMING_H
+#define BOOT_TIMING_H
+
+#include "boot_shared_data.h"
+
+#if defined(CY_BOOT_TIMING)
+
+#include "cy_pdl.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern uint32_t boot_timing_stamps[BOOT_TIMING_PHASE_COUNT];
+extern uint16_t boot_timing_valid_mask;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void boot_timing_start(void);
+int  boot_timing_publish(void);
+
+/******************************************************************************
+ * Function Name: boot_timing_mark
+ ******************************************************************************
+ * Summary:
+ *  Stores the cycle counter as the end of a boot phase. Inlined, so a stamp
+ *  costs a load and two stores.
+ *
+ * Parameters:
+ *  phase - boot phase that has just finished
+ *
+ ******************************************************************************/
+__STATIC_FORCEINLINE void boot_timing_mark(boot_timing_phase_t phase)
+{
+    boot_timing_stamps[phase] = DWT->CYCCNT;
+    boot_timing_valid_mask |= (uint16_t)(1U << (uint32_t)phase);
+}
+
+#define BOOT_TIMING_START()         boot_timing_start()
+#define BOOT_TIMING_MARK(phase)     boot_timing_mark(phase)
+#define BOOT_TIMING_PUBLISH()       (void)boot_timing_publish()
+
+#else
+
+#define BOOT_TIMING_START()
+#define BOOT_TIMING_MARK(phase)
+#define BOOT_TIMING_PUBLISH()
+
+#endif /* CY_BOOT_TIMING */
+
+#endif /* BOOT_TIMING_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:   copy_pipe.c
+*
+* Description: Double-buffered flash copy, see copy_pipe.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "copy_pipe.h"
+
+#if defined(CY_BOOT_SECTOR_SKIP_COPY) || defined(CY_HOST_SIM)
+
+#include <stddef.h>
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Chunk buffers, word aligned for the flash driver */
+static uint32_t copy_pipe_buf[2][COPY_PIPE_CHUNK_SIZE / sizeof(uint32_t)];
+
+/******************************************************************************
+ * Function Name: copy_pipe_fetch
+ ******************************************************************************
+ * Summary:
+ *  Reads a chunk of the source and passes it to the callback.
+ *
+ ******************************************************************************/
+static int copy_pipe_fetch(const copy_pipe_port_t *port, uint32_t off, uint32_t len,
+                           uint8_t *buf, copy_pipe_chunk_cb_t cb, void *arg, uint32_t *ops)
+{
+    int rc = port->read(port->ctx, off, buf, len);
+
+    *ops = COPY_PIPE_ERASE | COPY_PIPE_PROGRAM;
+    if ((0 == rc) && (NULL != cb))
+    {
+        rc = cb(arg, off, buf, len);
+        if (rc >= 0)
+        {
+            *ops = (uint32_t)rc;
+            rc = 0;
+        }
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: copy_pipe_run
+ ******************************************************************************
+ * Summary:
+ *  Copies the source to the destination chunk by chunk. In pipelined mode,
+ *  chunk n + 1 is read into the other buffer and passed to the callback
+ *  while chunk n is erased and programmed, then the copy waits for chunk n.
+ *  In serial mode, each chunk is completed before the next one is read.
+ *
+ * Parameters:
+ *  port - source and destination
+ *  size - number of bytes to copy, a multiple of COPY_PIPE_CHUNK_SIZE
+ *  cb - called for every chunk, may be NULL to copy every chunk
+ *  arg - callback argument
+ *  pipelined - overlap reading with programming
+ *
+ * Return:
+ *  0 on success, otherwise the first error of the port or the callback
+ *
+ ******************************************************************************/
+int copy_pipe_run(const copy_pipe_port_t *port, uint32_t size, copy_pipe_chunk_cb_t cb,
+                  void *arg, bool pipelined)
+{
+    uint32_t ops[2] = { COPY_PIPE_SKIP, COPY_PIPE_SKIP };
+    uint32_t cur = 0U;
+    int rc = 0;
+
+    if (0U != (size % COPY_PIPE_CHUNK_SIZE))
+    {
+        return -1;
+    }
+
+    if (0U != size)
+    {
+        rc = copy_pipe_fetch(port, 0U, COPY_PIPE_CHUNK_SIZE, (uint8_t *)copy_pipe_buf[0],
+                             cb, arg, &ops[0]);
+    }
+
+    for (uint32_t off = 0U; (0 == rc) && (off < size); off += COPY_PIPE_CHUNK_SIZE)
+    {
+        uint32_t next = off + COPY_PIPE_CHUNK_SIZE;
+        bool started = false;
+
+        if (COPY_PIPE_SKIP != ops[cur])
+        {
+            rc = port->start(port->ctx, off, (const uint8_t *)copy_pipe_buf[cur],
+                             COPY_PIPE_CHUNK_SIZE, ops[cur]);
+            started = (0 == rc);
+        }
+
+        if (started && !pipelined)
+        {
+            rc = port->wait(port->ctx);
+            started = false;
+        }
+
+        /* The buffer of the chunk being programmed is not touched */
+        if ((0 == rc) && (next < size))
+        {
+            rc = copy_pipe_fetch(port, next, COPY_PIPE_CHUNK_SIZE,
+                                 (uint8_t *)copy_pipe_buf[cur ^ 1U], cb, arg, &ops[cur ^ 1U]);
+        }
+
+        if (started)
+        {
+            int wait_rc = port->wait(port->ctx);
+
+            rc = (0 == rc) ? wait_rc : rc;
+        }
+
+        cur ^= 1U;
+    }
+
+    return rc;
+}
+
+#endif /* CY_BOOT_SECTOR_SKIP_COPY || CY_HOST_SIM */
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/******************************************************************************
+* File Name:   copy_pipe.h
+*
+* Description: Double-buffered flash copy. The next chunk is read and inspected
+*              while the previous one is being erased and programmed, so the
+*              read and the CPU work overlap with the flash program time.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef COPY_PIPE_H
+#define COPY_PIPE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of each of the two chunk buffers */
+#ifndef COPY_PIPE_CHUNK_SIZE
+#define COPY_PIPE_CHUNK_SIZE        (MCUBOOT_PLATFORM_CHUNK_SIZE)
+#endif /* COPY_PIPE_CHUNK_SIZE */
+
+/* Operations on a destination chunk, returned by the chunk callback */
+#define COPY_PIPE_SKIP              (0U)
+#define COPY_PIPE_ERASE             (1U)
+#define COPY_PIPE_PROGRAM           (2U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Source and destination of a copy. start() may return before the
+ * destination operation completes, wait() then blocks until it has.
+ */
+typedef struct
+{
+    int (*read)(void *ctx, uint32_t off, uint8_t *buf, uint32_t len);
+    int (*start)(void *ctx, uint32_t off, const uint8_t *buf, uint32_t len, uint32_t ops);
+    int (*wait)(void *ctx);
+    void *ctx;
+} copy_pipe_port_t;
+
+/* Inspects (e.g. hashes or compares) a chunk after it has been read and
+ * returns the COPY_PIPE_ERASE and COPY_PIPE_PROGRAM operations to perform,
+ * or a negative value to stop the copy
+ */
+typedef int (*copy_pipe_chunk_cb_t)(void *arg, uint32_t off, const uint8_t *buf, uint32_t len);
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int copy_pipe_run(const copy_pipe_port_t *port, uint32_t size, copy_pipe_chunk_cb_t cb,
+                  void *arg, bool pipelined);
+
+#endif /* COPY_PIPE_H */
+
+/* [] END OF FILE */
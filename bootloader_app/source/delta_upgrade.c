@@ -0,0 +1,823 @@
+/******************************************************************************
+* File Name:   delta_upgrade.c
+*
+* Description: Delta upgrade images, see delta_upgrade.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "delta_upgrade.h"
+
+#if defined(CY_BOOT_DELTA_UPGRADE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/bootutil_log.h"
+
+#include "stream_verify.h"
+
+#if !defined(MCUBOOT_OVERWRITE_ONLY)
+#error "Delta upgrade images require the overwrite upgrade mode"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Unit in which the primary slot is rewritten, one flash row by default */
+#define DELTA_PAGE_SIZE             (MCUBOOT_PLATFORM_CHUNK_SIZE)
+
+/* Size of the buffer of the page operation reader */
+#define DELTA_INPUT_SIZE            (64U)
+
+#define DELTA_NO_PAGE               (0xFFFFFFFFUL)
+#define DELTA_SHA256_SIZE           (32U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* State of a patch */
+typedef struct
+{
+    const struct flash_area *pri;
+    const struct flash_area *sec;
+    delta_upgrade_header_t hdr;
+    uint32_t pages;                     /* Pages of the new image */
+    uint32_t ops_off;                   /* Offset of the page operations */
+    uint32_t resume_step;               /* First step that is not completed */
+    uint32_t jrn_page;                  /* Page saved in delta_aux_buf */
+    uint32_t jrn_seq;                   /* Sequence of the last record */
+    uint32_t jrn_slot;                  /* Journal slot of the last record */
+    bool jrn_valid;                     /* A record exists */
+} delta_ctx_t;
+
+/* Buffered reader of the page operations */
+typedef struct
+{
+    const struct flash_area *fap;
+    uint32_t off;                       /* Next offset to read */
+    uint32_t end;                       /* End of the page operations */
+    uint32_t pos;                       /* Read position in delta_in_buf */
+    uint32_t len;                       /* Valid bytes in delta_in_buf */
+} delta_input_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Static working memory, three pages and the TLV buffer of stream_verify.c.
+ * delta_aux_buf holds the page saved in the journal while an interrupted
+ * patch is resumed, and the journal record page afterwards.
+ */
+static uint8_t delta_page_buf[DELTA_PAGE_SIZE];
+static uint8_t delta_old_buf[DELTA_PAGE_SIZE];
+static uint8_t delta_aux_buf[DELTA_PAGE_SIZE];
+static uint8_t delta_in_buf[DELTA_INPUT_SIZE];
+
+/******************************************************************************
+ * Function Name: delta_page_of_step
+ ******************************************************************************
+ * Summary:
+ *  Returns the page that is rewritten in the given step. The same mapping
+ *  returns the step of a page.
+ *
+ ******************************************************************************/
+static uint32_t delta_page_of_step(const delta_ctx_t *ctx, uint32_t step)
+{
+    return (0U != (ctx->hdr.flags & DELTA_FLAG_REVERSE)) ? (ctx->pages - 1U - step) : step;
+}
+
+/******************************************************************************
+ * Function Name: delta_page_len
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of bytes of the new image in a page.
+ *
+ ******************************************************************************/
+static uint32_t delta_page_len(const delta_ctx_t *ctx, uint32_t page)
+{
+    uint32_t rest = ctx->hdr.new_size - (page * DELTA_PAGE_SIZE);
+
+    return (rest < DELTA_PAGE_SIZE) ? rest : DELTA_PAGE_SIZE;
+}
+
+/******************************************************************************
+ * Function Name: delta_src_allowed
+ ******************************************************************************
+ * Summary:
+ *  Checks that the pages first..last of the old image are still unchanged
+ *  when the given page is rewritten. Pages after the end of the new image
+ *  are never rewritten.
+ *
+ ******************************************************************************/
+static bool delta_src_allowed(const delta_ctx_t *ctx, uint32_t page, uint32_t first, uint32_t last)
+{
+    if (0U != (ctx->hdr.flags & DELTA_FLAG_REVERSE))
+    {
+        return (last <= page) || (first >= ctx->pages);
+    }
+
+    return first >= page;
+}
+
+/******************************************************************************
+ * Function Name: delta_read_byte
+ ******************************************************************************
+ * Summary:
+ *  Returns the next byte of the page operations.
+ *
+ * Parameters:
+ *  in - operation reader
+ *  byte - receives the byte
+ *
+ * Return:
+ *  0 on success, -1 at the end of the operations or on a read error
+ *
+ ******************************************************************************/
+static int delta_read_byte(delta_input_t *in, uint8_t *byte)
+{
+    if (in->pos == in->len)
+    {
+        uint32_t len = in->end - in->off;
+
+        if (0U == len)
+        {
+            return -1;
+        }
+        if (len > sizeof(delta_in_buf))
+        {
+            len = sizeof(delta_in_buf);
+        }
+        if (0 != flash_area_read(in->fap, in->off, delta_in_buf, len))
+        {
+            return -1;
+        }
+
+        in->off += len;
+        in->pos = 0U;
+        in->len = len;
+    }
+
+    *byte = delta_in_buf[in->pos];
+    in->pos++;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: delta_read_old
+ ******************************************************************************
+ * Summary:
+ *  Reads the old image from the primary slot. The page saved in the journal
+ *  is taken from delta_aux_buf, its flash content may be partly rewritten.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *  off - offset in the old image
+ *  dst - destination
+ *  len - number of bytes
+ *
+ * Return:
+ *  0 on success, otherwise the flash read error
+ *
+ ******************************************************************************/
+static int delta_read_old(const delta_ctx_t *ctx, uint32_t off, uint8_t *dst, uint32_t len)
+{
+    int rc = 0;
+
+    while ((0 == rc) && (0U != len))
+    {
+        uint32_t page_off = off % DELTA_PAGE_SIZE;
+        uint32_t part = DELTA_PAGE_SIZE - page_off;
+
+        if (part > len)
+        {
+            part = len;
+        }
+
+        if ((off / DELTA_PAGE_SIZE) == ctx->jrn_page)
+        {
+            (void)memcpy(dst, &delta_aux_buf[page_off], part);
+        }
+        else
+        {
+            rc = flash_area_read(ctx->pri, off, dst, part);
+        }
+
+        off += part;
+        dst += part;
+        len -= part;
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: delta_build_page
+ ******************************************************************************
+ * Summary:
+ *  Runs the operations of a page of the new image. A copy may only read
+ *  pages that are rewritten in this step or later, which are still unchanged
+ *  in the primary slot. The page is padded with the erased value.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *  page - page of the new image
+ *  out - receives the page, DELTA_PAGE_SIZE bytes
+ *  self_ref - set if the page copies from its own old content
+ *
+ * Return:
+ *  0 on success, -1 for malformed operations or a read error
+ *
+ ******************************************************************************/
+static int delta_build_page(const delta_ctx_t *ctx, uint32_t page, uint8_t *out, bool *self_ref)
+{
+    delta_input_t in = { ctx->sec, 0U, ctx->ops_off + ctx->hdr.ops_size, 0U, 0U };
+    uint32_t page_start = page * DELTA_PAGE_SIZE;
+    uint32_t len = delta_page_len(ctx, page);
+    uint32_t entry = 0U;
+    uint32_t fill = 0U;
+    int rc;
+
+    *self_ref = false;
+    (void)memset(&out[len], flash_area_erased_val(ctx->pri), DELTA_PAGE_SIZE - len);
+
+    rc = flash_area_read(ctx->sec, ctx->hdr.hdr_size + (page * sizeof(entry)), &entry, sizeof(entry));
+
+    if ((0 == rc) && (DELTA_PAGE_UNCHANGED == entry))
+    {
+        if ((page_start + len) > ctx->hdr.old_size)
+        {
+            return -1;
+        }
+        *self_ref = true;
+        return delta_read_old(ctx, page_start, out, len);
+    }
+
+    if ((0 != rc) || (entry >= ctx->hdr.ops_size))
+    {
+        return -1;
+    }
+    in.off = ctx->ops_off + entry;
+
+    while ((0 == rc) && (fill < len))
+    {
+        uint8_t op = 0U;
+        uint32_t n;
+
+        rc = delta_read_byte(&in, &op);
+        n = ((uint32_t)op & DELTA_OP_LEN_MASK) + 1U;
+
+        if ((0 != rc) || (n > (len - fill)))
+        {
+            rc = -1;
+        }
+        else if (0U == (op & DELTA_OP_COPY))
+        {
+            for (uint32_t i = 0U; (0 == rc) && (i < n); i++)
+            {
+                rc = delta_read_byte(&in, &out[fill + i]);
+            }
+        }
+        else
+        {
+            uint32_t zz = 0U;
+            uint32_t src;
+            uint32_t first;
+            uint32_t last;
+            uint8_t b = 0x80U;
+
+            for (uint32_t shift = 0U; (0 == rc) && (0U != (b & 0x80U)); shift += 7U)
+            {
+                rc = ((shift < 32U) ? delta_read_byte(&in, &b) : -1);
+                zz |= ((uint32_t)b & 0x7FU) << shift;
+            }
+
+            /* Zigzag decoding, the distance may be negative */
+            src = page_start + fill + ((zz >> 1U) ^ (0U - (zz & 1U)));
+            first = src / DELTA_PAGE_SIZE;
+            last = (src + n - 1U) / DELTA_PAGE_SIZE;
+
+            if ((0 != rc) || (src > ctx->hdr.old_size) || (n > (ctx->hdr.old_size - src)) ||
+                !delta_src_allowed(ctx, page, first, last))
+            {
+                /* Outside the old image or reads a page rewritten before */
+                rc = -1;
+            }
+            else
+            {
+                *self_ref = *self_ref || ((first <= page) && (last >= page));
+                rc = delta_read_old(ctx, src, &out[fill], n);
+            }
+        }
+
+        fill += n;
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: delta_journal_off
+ ******************************************************************************
+ * Summary:
+ *  Returns the offset of the saved page, or of the record, of a journal slot
+ *  at the end of the secondary slot.
+ *
+ ******************************************************************************/
+static uint32_t delta_journal_off(const delta_ctx_t *ctx, uint32_t slot, bool record)
+{
+    return ctx->sec->fa_size - ((DELTA_JOURNAL_PAGES - (2U * slot)) * DELTA_PAGE_SIZE) +
+           (record ? DELTA_PAGE_SIZE : 0U);
+}
+
+/******************************************************************************
+ * Function Name: delta_journal_check
+ ******************************************************************************
+ * Summary:
+ *  Computes the check value of a journal record and its saved page, which
+ *  detects records and pages torn by a power failure.
+ *
+ ******************************************************************************/
+static void delta_journal_check(const delta_journal_t *rec, const uint8_t *data, uint8_t *check)
+{
+    bootutil_sha256_context sha;
+    uint8_t hash[DELTA_SHA256_SIZE];
+
+    bootutil_sha256_init(&sha);
+    (void)bootutil_sha256_update(&sha, rec, offsetof(delta_journal_t, check));
+    if (NULL != data)
+    {
+        (void)bootutil_sha256_update(&sha, data, DELTA_PAGE_SIZE);
+    }
+    (void)bootutil_sha256_finish(&sha, hash);
+    bootutil_sha256_drop(&sha);
+
+    (void)memcpy(check, hash, sizeof(rec->check));
+}
+
+/******************************************************************************
+ * Function Name: delta_journal_load
+ ******************************************************************************
+ * Summary:
+ *  Looks for the newest valid journal record of the patch. If there is one,
+ *  the patch was interrupted: the steps before the record are completed and
+ *  the page saved with the record is loaded into delta_aux_buf.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *
+ * Return:
+ *  0 on success, -1 if the saved page cannot be read
+ *
+ ******************************************************************************/
+static int delta_journal_load(delta_ctx_t *ctx)
+{
+    delta_journal_t rec;
+    uint8_t check[sizeof(rec.check)];
+    uint32_t has_data = 0U;
+
+    ctx->jrn_valid = false;
+    ctx->jrn_page = DELTA_NO_PAGE;
+    ctx->resume_step = 0U;
+
+    for (uint32_t slot = 0U; slot < 2U; slot++)
+    {
+        const uint8_t *data = NULL;
+
+        if ((0 != flash_area_read(ctx->sec, delta_journal_off(ctx, slot, true), &rec, sizeof(rec))) ||
+            (DELTA_JOURNAL_MAGIC != rec.magic) || (ctx->hdr.patch_id != rec.patch_id) ||
+            (rec.step >= ctx->pages))
+        {
+            continue;
+        }
+
+        if (0U != (rec.flags & DELTA_JOURNAL_HAS_DATA))
+        {
+            if (0 != flash_area_read(ctx->sec, delta_journal_off(ctx, slot, false),
+                                     delta_aux_buf, DELTA_PAGE_SIZE))
+            {
+                continue;
+            }
+            data = delta_aux_buf;
+        }
+
+        delta_journal_check(&rec, data, check);
+        if (0 != memcmp(check, rec.check, sizeof(check)))
+        {
+            continue;
+        }
+
+        if ((!ctx->jrn_valid) || ((int32_t)(rec.seq - ctx->jrn_seq) > 0))
+        {
+            ctx->jrn_valid = true;
+            ctx->jrn_seq = rec.seq;
+            ctx->jrn_slot = slot;
+            ctx->resume_step = rec.step;
+            has_data = rec.flags & DELTA_JOURNAL_HAS_DATA;
+        }
+    }
+
+    if (ctx->jrn_valid && (0U != has_data))
+    {
+        if (0 != flash_area_read(ctx->sec, delta_journal_off(ctx, ctx->jrn_slot, false),
+                                 delta_aux_buf, DELTA_PAGE_SIZE))
+        {
+            return -1;
+        }
+        ctx->jrn_page = delta_page_of_step(ctx, ctx->resume_step);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: delta_journal_write
+ ******************************************************************************
+ * Summary:
+ *  Records that a step is about to rewrite its page, with the old content of
+ *  the page if the new content is built from it. The record goes to the
+ *  other journal slot than the previous one.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *  step - step that is about to be written
+ *  data - old content of the page, or NULL
+ *
+ * Return:
+ *  0 on success, otherwise the flash error
+ *
+ ******************************************************************************/
+static int delta_journal_write(delta_ctx_t *ctx, uint32_t step, const uint8_t *data)
+{
+    uint32_t slot = ctx->jrn_valid ? (ctx->jrn_slot ^ 1U) : 0U;
+    delta_journal_t rec;
+    int rc = 0;
+
+    rec.magic = DELTA_JOURNAL_MAGIC;
+    rec.patch_id = ctx->hdr.patch_id;
+    rec.seq = ctx->jrn_valid ? (ctx->jrn_seq + 1U) : 0U;
+    rec.step = step;
+    rec.flags = (NULL != data) ? DELTA_JOURNAL_HAS_DATA : 0U;
+    delta_journal_check(&rec, data, rec.check);
+
+    if (NULL != data)
+    {
+        uint32_t off = delta_journal_off(ctx, slot, false);
+
+        rc = flash_area_erase(ctx->sec, off, DELTA_PAGE_SIZE);
+        if (0 == rc)
+        {
+            rc = flash_area_write(ctx->sec, off, data, DELTA_PAGE_SIZE);
+        }
+    }
+
+    if (0 == rc)
+    {
+        uint32_t off = delta_journal_off(ctx, slot, true);
+
+        (void)memset(delta_aux_buf, flash_area_erased_val(ctx->sec), DELTA_PAGE_SIZE);
+        (void)memcpy(delta_aux_buf, &rec, sizeof(rec));
+
+        rc = flash_area_erase(ctx->sec, off, DELTA_PAGE_SIZE);
+        if (0 == rc)
+        {
+            rc = flash_area_write(ctx->sec, off, delta_aux_buf, DELTA_PAGE_SIZE);
+        }
+    }
+
+    if (0 == rc)
+    {
+        ctx->jrn_valid = true;
+        ctx->jrn_seq = rec.seq;
+        ctx->jrn_slot = slot;
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: delta_check_old
+ ******************************************************************************
+ * Summary:
+ *  Checks that the primary slot holds the image the patch was made for.
+ *
+ ******************************************************************************/
+static bool delta_check_old(const delta_ctx_t *ctx)
+{
+    bootutil_sha256_context sha;
+    uint8_t hash[DELTA_SHA256_SIZE];
+    int rc = 0;
+
+    bootutil_sha256_init(&sha);
+    for (uint32_t off = 0U; (0 == rc) && (off < ctx->hdr.old_size); off += DELTA_PAGE_SIZE)
+    {
+        uint32_t len = ctx->hdr.old_size - off;
+
+        if (len > DELTA_PAGE_SIZE)
+        {
+            len = DELTA_PAGE_SIZE;
+        }
+        rc = flash_area_read(ctx->pri, off, delta_page_buf, len);
+        if (0 == rc)
+        {
+            (void)bootutil_sha256_update(&sha, delta_page_buf, len);
+        }
+    }
+    (void)bootutil_sha256_finish(&sha, hash);
+    bootutil_sha256_drop(&sha);
+
+    return (0 == rc) && (0 == memcmp(hash, ctx->hdr.old_hash, DELTA_SHA256_SIZE));
+}
+
+/******************************************************************************
+ * Function Name: delta_validate
+ ******************************************************************************
+ * Summary:
+ *  First pass: builds the new image without writing it and checks its
+ *  header, SHA-256 hash and signature. Pages completed before an
+ *  interruption are read from the primary slot.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *  sv - receives the image header
+ *
+ * Return:
+ *  true if the new image is valid
+ *
+ ******************************************************************************/
+static bool delta_validate(const delta_ctx_t *ctx, stream_verify_t *sv)
+{
+    int rc = 0;
+
+    stream_verify_init(sv, ctx->hdr.new_size);
+
+    for (uint32_t page = 0U; (0 == rc) && (page < ctx->pages); page++)
+    {
+        uint32_t len = delta_page_len(ctx, page);
+        bool self_ref;
+
+        if (delta_page_of_step(ctx, page) < ctx->resume_step)
+        {
+            rc = flash_area_read(ctx->pri, page * DELTA_PAGE_SIZE, delta_page_buf, len);
+        }
+        else
+        {
+            rc = delta_build_page(ctx, page, delta_page_buf, &self_ref);
+        }
+
+        if (0 == rc)
+        {
+            rc = stream_verify_update(sv, page * DELTA_PAGE_SIZE, delta_page_buf, len);
+        }
+    }
+
+    if (0 != rc)
+    {
+        bootutil_sha256_drop(&sv->sha);
+        BOOT_LOG_ERR("Delta image: malformed patch");
+        return false;
+    }
+
+    return stream_verify_finish(sv);
+}
+
+/******************************************************************************
+ * Function Name: delta_write
+ ******************************************************************************
+ * Summary:
+ *  Second pass: rewrites the pages of the primary slot in the order of the
+ *  patch, starting at the interrupted step. Pages that do not change are
+ *  not written, so the flash wear follows the size of the change. The rest
+ *  of the old image after the new one is erased at the end.
+ *
+ * Parameters:
+ *  ctx - patch state
+ *
+ * Return:
+ *  0 on success, otherwise the flash error or -1 for malformed operations
+ *
+ ******************************************************************************/
+static int delta_write(delta_ctx_t *ctx)
+{
+    uint8_t erased_val = flash_area_erased_val(ctx->pri);
+    uint32_t written = 0U;
+    int rc = 0;
+
+    for (uint32_t step = ctx->resume_step; (0 == rc) && (step < ctx->pages); step++)
+    {
+        uint32_t page = delta_page_of_step(ctx, step);
+        uint32_t off = page * DELTA_PAGE_SIZE;
+        bool self_ref = false;
+
+        rc = delta_build_page(ctx, page, delta_page_buf, &self_ref);
+        if (0 == rc)
+        {
+            rc = flash_area_read(ctx->pri, off, delta_old_buf, DELTA_PAGE_SIZE);
+        }
+
+        if ((0 == rc) && (0 != memcmp(delta_page_buf, delta_old_buf, DELTA_PAGE_SIZE)))
+        {
+            /* The record of an interrupted step is already in the journal */
+            if ((!ctx->jrn_valid) || (step != ctx->resume_step))
+            {
+                rc = delta_journal_write(ctx, step, self_ref ? delta_old_buf : NULL);
+            }
+            if (0 == rc)
+            {
+                rc = flash_area_erase(ctx->pri, off, DELTA_PAGE_SIZE);
+            }
+            if (0 == rc)
+            {
+                rc = flash_area_write(ctx->pri, off, delta_page_buf, DELTA_PAGE_SIZE);
+            }
+            written++;
+        }
+
+        /* Later steps never read this page */
+        ctx->jrn_page = DELTA_NO_PAGE;
+    }
+
+    for (uint32_t off = ctx->pages * DELTA_PAGE_SIZE; (0 == rc) && (off < ctx->hdr.old_size);
+         off += DELTA_PAGE_SIZE)
+    {
+        bool erased = true;
+
+        rc = flash_area_read(ctx->pri, off, delta_old_buf, DELTA_PAGE_SIZE);
+        for (uint32_t i = 0U; erased && (i < DELTA_PAGE_SIZE); i++)
+        {
+            erased = (erased_val == delta_old_buf[i]);
+        }
+        if ((0 == rc) && !erased)
+        {
+            rc = flash_area_erase(ctx->pri, off, DELTA_PAGE_SIZE);
+        }
+    }
+
+    BOOT_LOG_INF("Delta image: %u of %u pages rewritten", (unsigned int)written, (unsigned int)ctx->pages);
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: delta_upgrade_apply
+ ******************************************************************************
+ * Summary:
+ *  Applies a delta image found in the secondary slot to the image in the
+ *  primary slot. Call it before boot_go(), which then validates and boots the
+ *  primary slot as usual.
+ *
+ *  The new image is built twice from the old image and the patch: first to
+ *  validate its signature, then to rewrite the primary slot page by page. A
+ *  journal at the end of the secondary slot records every rewritten page,
+ *  so an interrupted patch is resumed on the next boot. The secondary slot
+ *  is erased last. A patch that is invalid or made for another image is
+ *  erased, the primary slot stays untouched.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *
+ * Return:
+ *  DELTA_UPGRADE_NONE if there is no delta image, DELTA_UPGRADE_DONE when it
+ *  has been applied, DELTA_UPGRADE_ERROR otherwise
+ *
+ ******************************************************************************/
+int delta_upgrade_apply(uint32_t image_index)
+{
+    delta_ctx_t ctx;
+    stream_verify_t sv;
+    bool erase_image = true;
+    int result = DELTA_UPGRADE_ERROR;
+
+    (void)memset(&ctx, 0, sizeof(ctx));
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &ctx.sec))
+    {
+        return DELTA_UPGRADE_ERROR;
+    }
+
+    if ((0 != flash_area_read(ctx.sec, 0U, &ctx.hdr, sizeof(ctx.hdr))) ||
+        (DELTA_UPGRADE_MAGIC != ctx.hdr.magic))
+    {
+        flash_area_close(ctx.sec);
+        return DELTA_UPGRADE_NONE;
+    }
+
+    BOOT_LOG_INF("Delta image found: %u byte patch, %u -> %u bytes",
+                 (unsigned int)ctx.hdr.ops_size, (unsigned int)ctx.hdr.old_size,
+                 (unsigned int)ctx.hdr.new_size);
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &ctx.pri))
+    {
+        flash_area_close(ctx.sec);
+        return DELTA_UPGRADE_ERROR;
+    }
+
+    ctx.pages = (ctx.hdr.new_size + DELTA_PAGE_SIZE - 1U) / DELTA_PAGE_SIZE;
+    ctx.ops_off = (uint32_t)ctx.hdr.hdr_size + (ctx.pages * sizeof(uint32_t));
+
+    if ((DELTA_UPGRADE_VERSION != ctx.hdr.version) ||
+        (ctx.hdr.hdr_size < sizeof(ctx.hdr)) ||
+        (DELTA_PAGE_SIZE != ctx.hdr.page_size) ||
+        (0U != (ctx.hdr.flags & ~DELTA_FLAG_REVERSE)) ||
+        (0U == ctx.hdr.new_size) ||
+        (ctx.hdr.new_size > ctx.pri->fa_size) ||
+        (ctx.hdr.old_size > ctx.pri->fa_size) ||
+        ((ctx.pages * DELTA_PAGE_SIZE) > ctx.pri->fa_size) ||
+        (ctx.sec->fa_size < (DELTA_JOURNAL_PAGES * DELTA_PAGE_SIZE)) ||
+        (ctx.ops_off > (ctx.sec->fa_size - (DELTA_JOURNAL_PAGES * DELTA_PAGE_SIZE))) ||
+        (ctx.hdr.ops_size > (ctx.sec->fa_size - (DELTA_JOURNAL_PAGES * DELTA_PAGE_SIZE) - ctx.ops_off)))
+    {
+        BOOT_LOG_ERR("Delta image: unsupported header");
+    }
+    else if (0 != delta_journal_load(&ctx))
+    {
+        BOOT_LOG_ERR("Delta image: reading the journal failed");
+        erase_image = false;
+    }
+    else if ((!ctx.jrn_valid) && (!delta_check_old(&ctx)))
+    {
+        BOOT_LOG_ERR("Delta image: made for another image");
+    }
+    else if (delta_validate(&ctx, &sv))
+    {
+#if defined(MCUBOOT_DOWNGRADE_PREVENTION)
+        if ((!ctx.jrn_valid) && stream_verify_is_downgrade(ctx.pri, &sv.hdr))
+        {
+            BOOT_LOG_ERR("Delta image: downgrade rejected");
+        }
+        else
+#endif /* MCUBOOT_DOWNGRADE_PREVENTION */
+        {
+            if (ctx.jrn_valid)
+            {
+                BOOT_LOG_INF("Resuming delta image at step %u", (unsigned int)ctx.resume_step);
+            }
+            else
+            {
+                BOOT_LOG_INF("Applying delta image to the primary slot");
+            }
+
+            if (0 == delta_write(&ctx))
+            {
+                result = DELTA_UPGRADE_DONE;
+            }
+            else
+            {
+                /* Keep the patch and the journal, the patch is resumed on next boot */
+                BOOT_LOG_ERR("Delta image: writing the primary slot failed");
+                erase_image = false;
+            }
+        }
+    }
+
+    /* Applied or invalid, do not process the patch again */
+    if (erase_image)
+    {
+        (void)flash_area_erase(ctx.sec, 0U, ctx.sec->fa_size);
+    }
+
+    flash_area_close(ctx.pri);
+    flash_area_close(ctx.sec);
+
+    return result;
+}
+
+#endif /* CY_BOOT_DELTA_UPGRADE */
+
+/* [] END OF FILE */
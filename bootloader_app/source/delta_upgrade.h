@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name:   delta_upgrade.h
+*
+* Description: Delta upgrade images. The secondary slot holds a patch against
+*              the image in the primary slot, which the Bootloader app
+*              validates and then applies to the primary slot in place before
+*              boot_go().
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef DELTA_UPGRADE_H
+#define DELTA_UPGRADE_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Patch magic, "CMDP" in flash byte order */
+#define DELTA_UPGRADE_MAGIC         (0x50444D43UL)
+#define DELTA_UPGRADE_VERSION       (1U)
+
+/* The pages are rewritten from the last to the first one */
+#define DELTA_FLAG_REVERSE          (1UL)
+
+/* Page index entry of a page that is the same in both images */
+#define DELTA_PAGE_UNCHANGED        (0xFFFFFFFFUL)
+
+/* Page operations, must match scripts/delta_image.py. An operation byte is
+ * followed by (op & DELTA_OP_LEN_MASK) + 1 literal bytes, or for a copy by
+ * the zigzag LEB128 distance from the page offset to the old image offset.
+ */
+#define DELTA_OP_COPY               (0x80U)
+#define DELTA_OP_LEN_MASK           (0x7FU)
+
+/* Pages at the end of the secondary slot that hold the progress journal */
+#define DELTA_JOURNAL_PAGES         (4U)
+#define DELTA_JOURNAL_MAGIC         (0x4C4A4443UL)
+#define DELTA_JOURNAL_HAS_DATA      (1UL)
+
+/* Return values of delta_upgrade_apply() */
+#define DELTA_UPGRADE_NONE          (0)
+#define DELTA_UPGRADE_DONE          (1)
+#define DELTA_UPGRADE_ERROR         (-1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Header at the start of the secondary slot. It is followed by the page
+ * index, one 32-bit offset into the page operations for every page of the
+ * new image, and the page operations. All fields are little-endian.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t hdr_size;                  /* Offset of the page index */
+    uint32_t flags;
+    uint32_t page_size;
+    uint32_t old_size;                  /* Size of the image the patch applies to */
+    uint32_t new_size;                  /* Size of the new signed image */
+    uint32_t ops_size;                  /* Size of the page operations */
+    uint32_t patch_id;                  /* Identifies the journal of this patch */
+    uint8_t  old_hash[32];              /* SHA-256 of the old image */
+} delta_upgrade_header_t;
+
+/* Journal record, written before a page of the primary slot is rewritten.
+ * Two records alternate, so one of them is valid after a power failure.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t patch_id;
+    uint32_t seq;                       /* Increments with every record */
+    uint32_t step;                      /* Step that is about to be written */
+    uint32_t flags;
+    uint8_t  check[8];                  /* SHA-256 of the record and saved page */
+} delta_journal_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int delta_upgrade_apply(uint32_t image_index);
+
+#endif /* DELTA_UPGRADE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,552 @@
+/******************************************************************************
+* File Name:   enc_upgrade.c
+*
+* Description: Verify-then-program install of encrypted overwrite upgrades, see
+*              enc_upgrade.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "enc_upgrade.h"
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+
+#include <stdbool.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/fault_injection_hardening.h"
+#include "bootutil/enc_key.h"
+#include "bootutil/crypto/aes_ctr.h"
+#include "bootutil/crypto/sha256.h"
+#include "bootutil_priv.h"
+
+#include "stream_verify.h"
+
+#if !defined(MCUBOOT_OVERWRITE_ONLY)
+#error "The encrypted upgrade install requires the overwrite upgrade mode"
+#endif
+
+#if !defined(MCUBOOT_ENCRYPT_EC256)
+#error "The encrypted upgrade install supports only ECIES-P256 key exchange"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Unit that is read, decrypted, hashed and programmed */
+#define ENC_UPGRADE_CHUNK_SIZE      (MCUBOOT_PLATFORM_CHUNK_SIZE)
+
+#define ENC_UPGRADE_BLOCK_SIZE      (16U)
+#define ENC_UPGRADE_DIGEST_SIZE     (32U)
+
+#if (ENC_UPGRADE_CHUNK_SIZE % ENC_UPGRADE_BLOCK_SIZE) != 0
+#error "PLATFORM_CHUNK_SIZE must be a multiple of the AES block size"
+#endif
+
+#if (ENC_UPGRADE_KEY_SIZE != BOOT_ENC_KEY_SIZE)
+#error "ENC_UPGRADE_KEY_SIZE does not match the key size of MCUboot"
+#endif
+
+/* Size of the secondary slot header and trailer erased after the install */
+#if defined(CY_BOOT_USE_EXTERNAL_FLASH)
+#define ENC_UPGRADE_SEC_ERASE_SIZE(fa) \
+    ((FLASH_DEVICE_INTERNAL_FLASH == (fa)->fa_device_id) ? ENC_UPGRADE_CHUNK_SIZE : CY_MAX_EXT_FLASH_ERASE_SIZE)
+#else
+#define ENC_UPGRADE_SEC_ERASE_SIZE(fa)  (ENC_UPGRADE_CHUNK_SIZE)
+#endif /* CY_BOOT_USE_EXTERNAL_FLASH */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Image installed by this boot, whose validation boot_go() can skip. The
+ * record only counts when verified holds FIH_SUCCESS.
+ */
+typedef struct
+{
+    fih_int verified;
+    fih_uint image_index;
+    struct image_header hdr;
+} enc_upgrade_installed_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t eu_buf[ENC_UPGRADE_CHUNK_SIZE];
+static uint8_t eu_head_buf[ENC_UPGRADE_CHUNK_SIZE];
+static bootutil_aes_ctr_context eu_aes;
+static enc_upgrade_installed_t eu_installed;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+fih_int __real_bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
+                                     struct image_header *hdr,
+                                     const struct flash_area *fap,
+                                     uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                                     uint8_t *seed, int seed_len, uint8_t *out_hash);
+
+/******************************************************************************
+ * Function Name: enc_upgrade_decrypt
+ ******************************************************************************
+ * Summary:
+ *  Decrypts the payload part of a chunk in place. The counter is the block
+ *  index within the payload, as in boot_encrypt() of MCUboot, so every chunk
+ *  is decrypted on its own.
+ *
+ * Parameters:
+ *  hdr - image header
+ *  off - offset of the chunk in the image
+ *  buf - chunk data
+ *  len - chunk size
+ *  decrypted - receives the number of decrypted bytes
+ *
+ * Return:
+ *  0 on success, -1 on a decryption error
+ *
+ ******************************************************************************/
+static int enc_upgrade_decrypt(const struct image_header *hdr, uint32_t off, uint8_t *buf,
+                               uint32_t len, uint32_t *decrypted)
+{
+    uint8_t counter[ENC_UPGRADE_BLOCK_SIZE];
+    uint32_t start = hdr->ih_hdr_size;
+    uint32_t end = start + hdr->ih_img_size;
+    uint32_t payload_off;
+
+    *decrypted = 0U;
+
+    start = (off > start) ? off : start;
+    end = ((off + len) < end) ? (off + len) : end;
+    if (start >= end)
+    {
+        return 0;
+    }
+
+    payload_off = start - hdr->ih_hdr_size;
+    (void)memset(counter, 0, sizeof(counter));
+    counter[12] = (uint8_t)(payload_off >> 28);
+    counter[13] = (uint8_t)(payload_off >> 20);
+    counter[14] = (uint8_t)(payload_off >> 12);
+    counter[15] = (uint8_t)(payload_off >> 4);
+
+    if (0 != bootutil_aes_ctr_decrypt(&eu_aes, counter, &buf[start - off], end - start, 0U,
+                                      &buf[start - off]))
+    {
+        return -1;
+    }
+
+    *decrypted = end - start;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: enc_upgrade_load_key
+ ******************************************************************************
+ * Summary:
+ *  Unwraps the AES key of an encrypted image from its ECIES-P256 TLV with
+ *  the private key of the Bootloader app. The HMAC of the TLV is checked
+ *  here, before anything is programmed.
+ *
+ * Parameters:
+ *  sec - slot of the image
+ *  hdr - image header
+ *  key - receives the AES key, ENC_UPGRADE_KEY_SIZE bytes
+ *
+ * Return:
+ *  0 on success, -1 if the TLV is missing or does not decrypt
+ *
+ ******************************************************************************/
+int enc_upgrade_load_key(const struct flash_area *sec, const struct image_header *hdr,
+                         uint8_t *key)
+{
+    uint8_t tlv[BOOT_ENC_TLV_SIZE];
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint16_t len;
+    int rc = -1;
+
+    if ((0 == bootutil_tlv_iter_begin(&it, hdr, sec, IMAGE_TLV_ENC_EC256, false)) &&
+        (0 == bootutil_tlv_iter_next(&it, &off, &len, NULL)) &&
+        (BOOT_ENC_TLV_SIZE == len) &&
+        (0 == flash_area_read(sec, off, tlv, len)) &&
+        (0 == boot_enc_decrypt(tlv, key)))
+    {
+        rc = 0;
+    }
+
+    (void)memset(tlv, 0, sizeof(tlv));
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: enc_upgrade_pass
+ ******************************************************************************
+ * Summary:
+ *  Reads every chunk of the image in the secondary slot, decrypts its
+ *  payload part in place if a key is given and adds it to the digest of the
+ *  plain image. With sv, the chunk is also passed to the validation. With
+ *  pri, it is programmed into the primary slot, except the first chunk,
+ *  which is kept in eu_head_buf.
+ *
+ * Parameters:
+ *  sec - secondary slot
+ *  hdr - image header, checked against the first chunk
+ *  size - image size including the TLVs
+ *  key - AES key of the payload, NULL for an image that is not encrypted
+ *  sv - validation state, or NULL
+ *  pri - primary slot, or NULL
+ *  digest - receives the SHA-256 of the plain image
+ *  stats - byte and chunk counts, added to those of the previous pass
+ *
+ * Return:
+ *  0 on success, -1 on a flash or decryption error, or if the header changed
+ *
+ ******************************************************************************/
+static int enc_upgrade_pass(const struct flash_area *sec, const struct image_header *hdr,
+                            uint32_t size, const uint8_t *key, stream_verify_t *sv,
+                            const struct flash_area *pri, uint8_t *digest,
+                            enc_upgrade_stats_t *stats)
+{
+    bootutil_sha256_context sha;
+    uint8_t erased_val = (NULL != pri) ? flash_area_erased_val(pri) : 0U;
+    uint32_t decrypted = 0U;
+    int rc = 0;
+
+    bootutil_sha256_init(&sha);
+
+    for (uint32_t off = 0U; (0 == rc) && (off < size); off += ENC_UPGRADE_CHUNK_SIZE)
+    {
+        uint32_t len = ((size - off) < ENC_UPGRADE_CHUNK_SIZE) ? (size - off) : ENC_UPGRADE_CHUNK_SIZE;
+
+        rc = flash_area_read(sec, off, eu_buf, len);
+
+        /* The header must not change after it has been checked */
+        if ((0 == rc) && (0U == off) &&
+            ((len < sizeof(*hdr)) || (0 != memcmp(eu_buf, hdr, sizeof(*hdr)))))
+        {
+            rc = -1;
+        }
+
+        if ((0 == rc) && (NULL != key))
+        {
+            rc = enc_upgrade_decrypt(hdr, off, eu_buf, len, &decrypted);
+        }
+
+        if (0 == rc)
+        {
+            (void)bootutil_sha256_update(&sha, eu_buf, len);
+            stats->bytes += len;
+            stats->decrypted += decrypted;
+            if (NULL != sv)
+            {
+                rc = stream_verify_update(sv, off, eu_buf, len);
+            }
+        }
+
+        if ((0 == rc) && (NULL != pri))
+        {
+            (void)memset(&eu_buf[len], erased_val, ENC_UPGRADE_CHUNK_SIZE - len);
+
+            if (0U == off)
+            {
+                (void)memcpy(eu_head_buf, eu_buf, ENC_UPGRADE_CHUNK_SIZE);
+            }
+            else
+            {
+                rc = flash_area_erase(pri, off, ENC_UPGRADE_CHUNK_SIZE);
+                if (0 == rc)
+                {
+                    rc = flash_area_write(pri, off, eu_buf, ENC_UPGRADE_CHUNK_SIZE);
+                    stats->chunks++;
+                }
+            }
+        }
+    }
+
+    (void)bootutil_sha256_finish(&sha, digest);
+    bootutil_sha256_drop(&sha);
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: enc_upgrade_copy
+ ******************************************************************************
+ * Summary:
+ *  Installs the image in the secondary slot into the primary slot. The
+ *  first pass decrypts and hashes the image without writing anything, and
+ *  checks the hash and the signature. Only a valid image is programmed by
+ *  the second pass, which decrypts it again and checks that it still has
+ *  the same digest before it programs the first chunk with the image
+ *  header. The primary slot is therefore never touched for an image that
+ *  does not authenticate, and holds no image header while it is programmed.
+ *  A valid image is read and decrypted twice.
+ *
+ * Parameters:
+ *  pri - primary slot
+ *  sec - secondary slot
+ *  key - AES key of the payload, NULL for an image that is not encrypted
+ *  stats - receives the byte and chunk counts of both passes
+ *
+ * Return:
+ *  ENC_UPGRADE_NONE if the image is rejected before the primary slot is
+ *  touched, ENC_UPGRADE_DONE when it has been installed, ENC_UPGRADE_ERROR
+ *  otherwise
+ *
+ ******************************************************************************/
+int enc_upgrade_copy(const struct flash_area *pri, const struct flash_area *sec,
+                     const uint8_t *key, enc_upgrade_stats_t *stats)
+{
+    struct image_header hdr;
+    stream_verify_t sv;
+    uint8_t digest[ENC_UPGRADE_DIGEST_SIZE];
+    uint8_t check[ENC_UPGRADE_DIGEST_SIZE];
+    uint32_t size = 0U;
+    int result = ENC_UPGRADE_NONE;
+    int rc;
+
+    (void)memset(stats, 0, sizeof(*stats));
+    eu_installed.verified = FIH_FAILURE;
+
+    if ((0 != stream_verify_image_size(sec, &size)) ||
+        (0 != flash_area_read(sec, 0U, &hdr, sizeof(hdr))) ||
+        (0U != (hdr.ih_hdr_size % ENC_UPGRADE_BLOCK_SIZE)) ||
+        ((0U != IS_ENCRYPTED(&hdr)) != (NULL != key)) ||
+        ((size + ENC_UPGRADE_CHUNK_SIZE - 1U) / ENC_UPGRADE_CHUNK_SIZE >
+         pri->fa_size / ENC_UPGRADE_CHUNK_SIZE))
+    {
+        return ENC_UPGRADE_NONE;
+    }
+
+    if (NULL != key)
+    {
+        bootutil_aes_ctr_init(&eu_aes);
+        if (0 != bootutil_aes_ctr_set_key(&eu_aes, key))
+        {
+            bootutil_aes_ctr_drop(&eu_aes);
+            return ENC_UPGRADE_NONE;
+        }
+    }
+
+    /* First pass: decrypt, hash and check the signature, nothing is written */
+    stream_verify_init(&sv, size);
+    rc = enc_upgrade_pass(sec, &hdr, size, key, &sv, NULL, digest, stats);
+    if (0 != rc)
+    {
+        bootutil_sha256_drop(&sv.sha);
+    }
+    else if (stream_verify_finish(&sv))
+    {
+        /* Second pass: invalidates the image in the primary slot, then
+         * programs everything but the header chunk
+         */
+        result = ENC_UPGRADE_ERROR;
+        rc = flash_area_erase(pri, 0U, ENC_UPGRADE_CHUNK_SIZE);
+        if (0 == rc)
+        {
+            rc = enc_upgrade_pass(sec, &hdr, size, key, NULL, pri, check, stats);
+        }
+
+        /* Resets the trailer of the primary slot unless the image reached it */
+        if ((0 == rc) && ((pri->fa_size - ENC_UPGRADE_CHUNK_SIZE) >= size))
+        {
+            rc = flash_area_erase(pri, pri->fa_size - ENC_UPGRADE_CHUNK_SIZE, ENC_UPGRADE_CHUNK_SIZE);
+        }
+        /* The secondary slot must not have changed since the first pass */
+        if ((0 == rc) && (0 == memcmp(digest, check, sizeof(digest))))
+        {
+            rc = flash_area_write(pri, 0U, eu_head_buf, ENC_UPGRADE_CHUNK_SIZE);
+            stats->chunks++;
+            if (0 == rc)
+            {
+                eu_installed.hdr = hdr;
+                eu_installed.verified = FIH_SUCCESS;
+                result = ENC_UPGRADE_DONE;
+            }
+        }
+    }
+    else
+    {
+        /* The image does not authenticate, boot_go() rejects it */
+    }
+
+    if (NULL != key)
+    {
+        bootutil_aes_ctr_drop(&eu_aes);
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: enc_upgrade_apply
+ ******************************************************************************
+ * Summary:
+ *  Installs a pending encrypted overwrite upgrade with enc_upgrade_copy().
+ *  Call it before boot_go(), which then finds no pending upgrade and boots
+ *  the primary slot without validating it a second time, see
+ *  __wrap_bootutil_img_validate().
+ *
+ *  An image that is not encrypted, whose key does not unwrap, whose
+ *  signature does not match, or a downgrade is left to boot_go(), which
+ *  rejects it or installs it as usual. The primary slot keeps its image in
+ *  all these cases. The header and trailer of the secondary slot are erased
+ *  last, so an interrupted install is repeated on the next boot.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *  stats - receives the byte and chunk counts
+ *
+ * Return:
+ *  ENC_UPGRADE_NONE if there is no valid encrypted pending upgrade,
+ *  ENC_UPGRADE_DONE when it has been installed, ENC_UPGRADE_ERROR otherwise
+ *
+ ******************************************************************************/
+int enc_upgrade_apply(uint32_t image_index, enc_upgrade_stats_t *stats)
+{
+    const struct flash_area *pri = NULL;
+    const struct flash_area *sec = NULL;
+    struct boot_swap_state state;
+    struct image_header hdr;
+    uint8_t key[ENC_UPGRADE_KEY_SIZE];
+    uint32_t erase_size;
+    int result = ENC_UPGRADE_NONE;
+
+    (void)memset(stats, 0, sizeof(*stats));
+    eu_installed.verified = FIH_FAILURE;
+
+    if ((0 != boot_read_swap_state_by_id(FLASH_AREA_IMAGE_SECONDARY(image_index), &state)) ||
+        (BOOT_MAGIC_GOOD != state.magic))
+    {
+        return ENC_UPGRADE_NONE;
+    }
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &sec))
+    {
+        return ENC_UPGRADE_ERROR;
+    }
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &pri))
+    {
+        flash_area_close(sec);
+        return ENC_UPGRADE_ERROR;
+    }
+
+    if ((0 == flash_area_read(sec, 0U, &hdr, sizeof(hdr))) &&
+        (IMAGE_MAGIC == hdr.ih_magic) && (0U != IS_ENCRYPTED(&hdr)) &&
+#if defined(MCUBOOT_DOWNGRADE_PREVENTION)
+        !stream_verify_is_downgrade(pri, &hdr) &&
+#endif /* MCUBOOT_DOWNGRADE_PREVENTION */
+        (0 == enc_upgrade_load_key(sec, &hdr, key)))
+    {
+        BOOT_LOG_INF("Image upgrade secondary slot -> primary slot, decrypt and hash first");
+
+        eu_installed.image_index = fih_uint_encode(image_index);
+        result = enc_upgrade_copy(pri, sec, key, stats);
+        if (ENC_UPGRADE_DONE == result)
+        {
+            erase_size = ENC_UPGRADE_SEC_ERASE_SIZE(sec);
+            if ((0 != flash_area_erase(sec, 0U, erase_size)) ||
+                (0 != flash_area_erase(sec, sec->fa_size - erase_size, erase_size)))
+            {
+                result = ENC_UPGRADE_ERROR;
+            }
+        }
+
+        BOOT_LOG_INF("Bytes read %u, decrypted %u, chunks programmed %u",
+                     (unsigned int)stats->bytes, (unsigned int)stats->decrypted,
+                     (unsigned int)stats->chunks);
+    }
+
+    (void)memset(key, 0, sizeof(key));
+
+    flash_area_close(pri);
+    flash_area_close(sec);
+
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: __wrap_bootutil_img_validate
+ ******************************************************************************
+ * Summary:
+ *  Replaces bootutil_img_validate() of MCUboot. The image that
+ *  enc_upgrade_apply() installed by this boot has been hashed and its
+ *  signature checked before it was programmed, so its first validation in
+ *  the primary slot is skipped. Every other validation goes to MCUboot.
+ *
+ *  The result is the FIH value recorded after the signature check, not a
+ *  constant, and the record is checked twice, so a single skipped
+ *  instruction does not turn a failed install into FIH_SUCCESS.
+ *
+ ******************************************************************************/
+fih_int __wrap_bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
+                                     struct image_header *hdr,
+                                     const struct flash_area *fap,
+                                     uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                                     uint8_t *seed, int seed_len, uint8_t *out_hash)
+{
+    fih_int fih_rc = FIH_FAILURE;
+
+    if ((FIH_TRUE == fih_eq(eu_installed.verified, FIH_SUCCESS)) && (image_index >= 0) &&
+        (FIH_TRUE == fih_uint_eq(eu_installed.image_index, fih_uint_encode((uint32_t)image_index))) &&
+        (FLASH_AREA_IMAGE_PRIMARY(image_index) == fap->fa_id) && (NULL == out_hash) &&
+        (IMAGE_MAGIC == hdr->ih_magic) &&
+        (0 == memcmp(hdr, &eu_installed.hdr, sizeof(*hdr))))
+    {
+        fih_rc = eu_installed.verified;
+        eu_installed.verified = FIH_FAILURE;
+
+        if (FIH_TRUE == fih_eq(fih_rc, FIH_SUCCESS))
+        {
+            FIH_RET(fih_rc);
+        }
+        fih_rc = FIH_FAILURE;
+    }
+
+    FIH_CALL(__real_bootutil_img_validate, fih_rc, enc_state, image_index, hdr, fap,
+             tmp_buf, tmp_buf_sz, seed, seed_len, out_hash);
+
+    FIH_RET(fih_rc);
+}
+
+#endif /* CY_BOOT_ENC_UPGRADE */
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   enc_upgrade.h
+*
+* Description: Install of encrypted overwrite upgrades. The Bootloader app
+*              first decrypts every chunk of the secondary slot with AES-CTR
+*              in place and hashes it, without writing anything. Only when
+*              the hash and the signature match, it decrypts the image again
+*              and programs it into the primary slot, the image header last.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENC_UPGRADE_H
+#define ENC_UPGRADE_H
+
+#include <stdint.h>
+
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Return values of enc_upgrade_apply() and enc_upgrade_copy() */
+#define ENC_UPGRADE_NONE            (0)
+#define ENC_UPGRADE_DONE            (1)
+#define ENC_UPGRADE_ERROR           (-1)
+
+/* AES-128 key of the image payload */
+#define ENC_UPGRADE_KEY_SIZE        (16U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Counts of the last install */
+typedef struct
+{
+    uint32_t bytes;                     /* Read from the secondary slot, both passes */
+    uint32_t decrypted;                 /* Of which decrypted */
+    uint32_t chunks;                    /* Programmed into the primary slot */
+} enc_upgrade_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int enc_upgrade_apply(uint32_t image_index, enc_upgrade_stats_t *stats);
+int enc_upgrade_copy(const struct flash_area *pri, const struct flash_area *sec,
+                     const uint8_t *key, enc_upgrade_stats_t *stats);
+int enc_upgrade_load_key(const struct flash_area *sec, const struct image_header *hdr,
+                         uint8_t *key);
+
+#endif /* ENC_UPGRADE_H */
+
+/* [] END OF FILE */
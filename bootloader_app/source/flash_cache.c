@@ -0,0 +1,300 @@
+/******************************************************************************
+* File Name:   flash_cache.c
+*
+* Description: Read-through cache of the flash areas, see flash_cache.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "flash_cache.h"
+
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t addr;                  /* Device address of the block */
+    uint32_t len;                   /* Valid bytes, 0 if the block is free */
+    uint32_t used;                  /* Last use, for the replacement */
+    uint8_t  device_id;
+} flash_cache_tag_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Flash map backend functions, renamed by the linker */
+int __real_flash_area_read(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len);
+int __real_flash_area_write(const struct flash_area *fa, uint32_t off, const void *src, uint32_t len);
+int __real_flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len);
+
+int __wrap_flash_area_read(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len);
+int __wrap_flash_area_write(const struct flash_area *fa, uint32_t off, const void *src, uint32_t len);
+int __wrap_flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len);
+int __wrap_flash_area_read_is_empty(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len);
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static flash_cache_tag_t flash_cache_tags[FLASH_CACHE_BLOCKS];
+static uint8_t flash_cache_data[FLASH_CACHE_BLOCKS][FLASH_CACHE_BLOCK_SIZE];
+static uint32_t flash_cache_clock;
+static flash_cache_stats_t flash_cache_stats;
+
+/******************************************************************************
+ * Function Name: flash_cache_is_cached
+ ******************************************************************************
+ * Summary:
+ *  Internal flash is memory mapped and read as fast as the cache, only the
+ *  other devices are cached.
+ *
+ ******************************************************************************/
+static bool flash_cache_is_cached(const struct flash_area *fa)
+{
+    return (FLASH_DEVICE_INTERNAL_FLASH != fa->fa_device_id);
+}
+
+/******************************************************************************
+ * Function Name: flash_cache_invalidate
+ ******************************************************************************
+ * Summary:
+ *  Drops the blocks that overlap a device range.
+ *
+ ******************************************************************************/
+static void flash_cache_invalidate(const struct flash_area *fa, uint32_t off, uint32_t len)
+{
+    uint32_t start = fa->fa_off + off;
+
+    for (uint32_t i = 0U; i < FLASH_CACHE_BLOCKS; i++)
+    {
+        flash_cache_tag_t *tag = &flash_cache_tags[i];
+
+        if ((0U != tag->len) && (fa->fa_device_id == tag->device_id) &&
+            (tag->addr < (start + len)) && (start < (tag->addr + tag->len)))
+        {
+            tag->len = 0U;
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_cache_block
+ ******************************************************************************
+ * Summary:
+ *  Returns the cache block holding the area offset, fetching it into the
+ *  least recently used block on a miss. A block is aligned to
+ *  FLASH_CACHE_BLOCK_SIZE within the area and ends with the area.
+ *
+ * Return:
+ *  Block index, or -1 on a read error
+ *
+ ******************************************************************************/
+static int flash_cache_block(const struct flash_area *fa, uint32_t off)
+{
+    uint32_t block_off = off - (off % FLASH_CACHE_BLOCK_SIZE);
+    uint32_t addr = fa->fa_off + block_off;
+    uint32_t victim = 0U;
+
+    flash_cache_clock++;
+
+    for (uint32_t i = 0U; i < FLASH_CACHE_BLOCKS; i++)
+    {
+        flash_cache_tag_t *tag = &flash_cache_tags[i];
+
+        if ((0U != tag->len) && (fa->fa_device_id == tag->device_id) && (addr == tag->addr) &&
+            ((off - block_off) < tag->len))
+        {
+            tag->used = flash_cache_clock;
+            flash_cache_stats.hits++;
+            return (int)i;
+        }
+
+        if ((0U == tag->len) ||
+            ((0U != flash_cache_tags[victim].len) && (tag->used < flash_cache_tags[victim].used)))
+        {
+            victim = i;
+        }
+    }
+
+    flash_cache_tags[victim].len = ((fa->fa_size - block_off) < FLASH_CACHE_BLOCK_SIZE) ?
+                                   (fa->fa_size - block_off) : FLASH_CACHE_BLOCK_SIZE;
+    if (0 != __real_flash_area_read(fa, block_off, flash_cache_data[victim],
+                                    flash_cache_tags[victim].len))
+    {
+        flash_cache_tags[victim].len = 0U;
+        return -1;
+    }
+
+    flash_cache_tags[victim].addr = addr;
+    flash_cache_tags[victim].device_id = fa->fa_device_id;
+    flash_cache_tags[victim].used = flash_cache_clock;
+    flash_cache_stats.misses++;
+    flash_cache_stats.bytes_fetched += flash_cache_tags[victim].len;
+
+    return (int)victim;
+}
+
+/******************************************************************************
+ * Function Name: __wrap_flash_area_read
+ ******************************************************************************
+ * Summary:
+ *  Serves reads smaller than a block from the cache. Larger reads, e.g. of
+ *  the image hash, go to flash directly and do not evict the cached
+ *  headers and trailers.
+ *
+ ******************************************************************************/
+int __wrap_flash_area_read(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len)
+{
+    uint8_t *out = (uint8_t *)dst;
+
+    if (!flash_cache_is_cached(fa) || (off > fa->fa_size) || (len > (fa->fa_size - off)))
+    {
+        return __real_flash_area_read(fa, off, dst, len);
+    }
+
+    if (len >= FLASH_CACHE_BLOCK_SIZE)
+    {
+        flash_cache_stats.bypassed++;
+        return __real_flash_area_read(fa, off, dst, len);
+    }
+
+    while (len > 0U)
+    {
+        int idx = flash_cache_block(fa, off);
+        uint32_t pos = off % FLASH_CACHE_BLOCK_SIZE;
+        uint32_t n;
+
+        if (idx < 0)
+        {
+            return -1;
+        }
+
+        n = flash_cache_tags[idx].len - pos;
+        n = (n < len) ? n : len;
+        (void)memcpy(out, &flash_cache_data[idx][pos], n);
+
+        out += n;
+        off += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: __wrap_flash_area_read_is_empty
+ ******************************************************************************
+ * Summary:
+ *  Reads through the cache and checks for the erased value.
+ *
+ * Return:
+ *  1 if the range is erased, 0 if not, -1 on a read error
+ *
+ ******************************************************************************/
+int __wrap_flash_area_read_is_empty(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len)
+{
+    const uint8_t *data = (const uint8_t *)dst;
+    uint8_t erased_val = flash_area_erased_val(fa);
+
+    if (0 != __wrap_flash_area_read(fa, off, dst, len))
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        if (erased_val != data[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ * Function Name: __wrap_flash_area_write
+ ******************************************************************************/
+int __wrap_flash_area_write(const struct flash_area *fa, uint32_t off, const void *src, uint32_t len)
+{
+    flash_cache_invalidate(fa, off, len);
+
+    return __real_flash_area_write(fa, off, src, len);
+}
+
+/******************************************************************************
+ * Function Name: __wrap_flash_area_erase
+ ******************************************************************************/
+int __wrap_flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len)
+{
+    flash_cache_invalidate(fa, off, len);
+
+    return __real_flash_area_erase(fa, off, len);
+}
+
+/******************************************************************************
+ * Function Name: flash_cache_reset
+ ******************************************************************************
+ * Summary:
+ *  Drops all blocks and clears the counters.
+ *
+ ******************************************************************************/
+void flash_cache_reset(void)
+{
+    (void)memset(flash_cache_tags, 0, sizeof(flash_cache_tags));
+    (void)memset(&flash_cache_stats, 0, sizeof(flash_cache_stats));
+    flash_cache_clock = 0U;
+}
+
+/******************************************************************************
+ * Function Name: flash_cache_get_stats
+ ******************************************************************************/
+void flash_cache_get_stats(flash_cache_stats_t *stats)
+{
+    *stats = flash_cache_stats;
+}
+
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   flash_cache.h
+*
+* Description: Read-through cache of the flash areas in external flash. Sits
+*              between MCUboot and the flash map backend through the --wrap
+*              option of the linker and serves the small header, TLV and
+*              trailer reads of the image validation from RAM blocks. Writes
+*              and erases invalidate the blocks they touch.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FLASH_CACHE_H
+#define FLASH_CACHE_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number and size of the cache blocks, bounding the RAM used by the cache */
+#ifndef FLASH_CACHE_BLOCKS
+#define FLASH_CACHE_BLOCKS          (8U)
+#endif /* FLASH_CACHE_BLOCKS */
+
+#ifndef FLASH_CACHE_BLOCK_SIZE
+#define FLASH_CACHE_BLOCK_SIZE      (MCUBOOT_PLATFORM_CHUNK_SIZE)
+#endif /* FLASH_CACHE_BLOCK_SIZE */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Counters since the last flash_cache_reset() */
+typedef struct
+{
+    uint32_t hits;                  /* Blocks served from the cache */
+    uint32_t misses;                /* Blocks fetched from flash */
+    uint32_t bypassed;              /* Reads of a block or more, not cached */
+    uint32_t bytes_fetched;         /* Bytes read from flash to fill blocks */
+} flash_cache_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void flash_cache_reset(void);
+void flash_cache_get_stats(flash_cache_stats_t *stats);
+
+#endif /* FLASH_CACHE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,615 @@
+/******************************************************************************
+* File Name:   image_cache.c
+*
+* Description: Validated-image cache. Records the image in the primary slot
+*              after boot_go() has validated it, and lets later warm boots skip
+*              boot_go() when the image still matches the record. The record
+*              is authenticated with HMAC-SHA256 under a key that the user app
+*              cannot read.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "image_cache.h"
+
+#if defined(CY_BOOT_IMAGE_CACHE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#if defined(CY_HOST_SIM)
+#include <stdlib.h>
+#else
+#include "cy_pdl.h"
+#endif /* defined(CY_HOST_SIM) */
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/crypto/sha256.h"
+#if defined(MCUBOOT_MEASURED_BOOT) || defined(MCUBOOT_DATA_SHARING)
+#include "bootutil/boot_record.h"
+#endif /* defined(MCUBOOT_MEASURED_BOOT) || defined(MCUBOOT_DATA_SHARING) */
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define IMAGE_CACHE_MAGIC           (0x56494D47U)   /* "VIMG" */
+#define IMAGE_CACHE_KEY_MAGIC       (0x564B4559U)   /* "VKEY" */
+#define IMAGE_CACHE_HASH_SIZE       (32U)
+#define IMAGE_CACHE_KEY_SIZE        (32U)
+#define IMAGE_CACHE_HMAC_BLOCK_SIZE (64U)
+#define IMAGE_CACHE_READ_SIZE       (256U)
+#define IMAGE_CACHE_MAC_OFFSET      (offsetof(image_cache_record_t, mac))
+
+/* The key region is protected by one SMPU region of this size */
+#define IMAGE_CACHE_KEY_REGION_SIZE (256U)
+
+/* Protection context of the user app. The Bootloader app runs in PC0, which
+ * the SMPU does not restrict, and moves CM4 to this context before the
+ * launch. Only a reset brings it back to PC0.
+ */
+#ifndef IMAGE_CACHE_APP_PC
+#define IMAGE_CACHE_APP_PC          (6U)
+#endif /* IMAGE_CACHE_APP_PC */
+
+/* TRNG polynomials, from the PDL documentation */
+#define IMAGE_CACHE_TRNG_GARO       (0x04C11DB7U)
+#define IMAGE_CACHE_TRNG_FIRO       (0x04C11DB7U)
+#define IMAGE_CACHE_TRNG_BITS       (32U)
+
+/* The record and the key must survive a reset, so they are kept out of .bss
+ * on the device. The RAM of the Bootloader app is not used by the user app,
+ * but it can write it. The record is therefore authenticated, and the key is
+ * kept in its own region that image_cache_lock() protects.
+ */
+#if defined(CY_HOST_SIM)
+#define IMAGE_CACHE_RETAINED
+#define IMAGE_CACHE_KEY_RETAINED
+#else
+#define IMAGE_CACHE_RETAINED        __attribute__((section(".noinit")))
+#define IMAGE_CACHE_KEY_RETAINED    \
+    __attribute__((section(".image_cache_key"), aligned(IMAGE_CACHE_KEY_REGION_SIZE)))
+#endif /* defined(CY_HOST_SIM) */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t image_off;                 /* Offset of the primary slot */
+    struct image_header hdr;
+    uint8_t hash[IMAGE_CACHE_HASH_SIZE];/* SHA256 TLV of the validated image */
+    uint32_t image_size;                /* Header, payload and TLVs */
+    uint32_t block_size;
+    uint32_t block_crc[IMAGE_CACHE_BLOCKS];
+    uint32_t warm_boots;                /* Since the last full validation */
+    uint32_t next_block;                /* First block checked on the next boot */
+    uint32_t seq;                       /* Must match the key, see below */
+    uint8_t mac[IMAGE_CACHE_HASH_SIZE]; /* HMAC-SHA256 of all the fields above */
+} image_cache_record_t;
+
+/* Secret of the Bootloader app, drawn from the TRNG after every power-on. seq
+ * is incremented whenever a record is written, so an older copy of a record
+ * that the user app has saved no longer matches.
+ */
+typedef union
+{
+    struct
+    {
+        uint32_t magic;
+        uint32_t seq;
+        uint8_t key[IMAGE_CACHE_KEY_SIZE];
+    } s;
+    uint8_t region[IMAGE_CACHE_KEY_REGION_SIZE];
+} image_cache_key_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static image_cache_record_t image_cache_records[MCUBOOT_IMAGE_NUMBER] IMAGE_CACHE_RETAINED;
+static image_cache_key_t image_cache_key IMAGE_CACHE_KEY_RETAINED;
+
+/* CRC-32 (IEEE 802.3), 4 bits at a time */
+static const uint32_t image_cache_crc_table[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/******************************************************************************
+ * Function Name: image_cache_crc
+ ******************************************************************************
+ * Summary:
+ *  CRC-32 (IEEE 802.3) of a buffer, continued from crc.
+ *
+ ******************************************************************************/
+static uint32_t image_cache_crc(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        crc ^= buf[i];
+        crc = (crc >> 4U) ^ image_cache_crc_table[crc & 0x0FU];
+        crc = (crc >> 4U) ^ image_cache_crc_table[crc & 0x0FU];
+    }
+
+    return ~crc;
+}
+
+/******************************************************************************
+ * Function Name: image_cache_key_valid
+ ******************************************************************************
+ * Summary:
+ *  Checks that the key survived the reset, or draws a new one. A new key
+ *  invalidates every record.
+ *
+ * Return:
+ *  true if the key survived the reset
+ *
+ ******************************************************************************/
+static bool image_cache_key_valid(void)
+{
+    uint32_t *words = (uint32_t *)image_cache_key.s.key;
+    bool valid = (IMAGE_CACHE_KEY_MAGIC == image_cache_key.s.magic);
+
+    if (!valid)
+    {
+        (void)memset(&image_cache_key, 0, sizeof(image_cache_key));
+
+#if defined(CY_HOST_SIM)
+        for (uint32_t i = 0U; i < (IMAGE_CACHE_KEY_SIZE / sizeof(uint32_t)); i++)
+        {
+            words[i] = (uint32_t)rand();
+        }
+        image_cache_key.s.magic = IMAGE_CACHE_KEY_MAGIC;
+#else
+        cy_en_crypto_status_t status = Cy_Crypto_Core_Enable(CRYPTO);
+
+        for (uint32_t i = 0U; (CY_CRYPTO_SUCCESS == status) &&
+                              (i < (IMAGE_CACHE_KEY_SIZE / sizeof(uint32_t))); i++)
+        {
+            status = Cy_Crypto_Core_Trng(CRYPTO, IMAGE_CACHE_TRNG_GARO, IMAGE_CACHE_TRNG_FIRO,
+                                         IMAGE_CACHE_TRNG_BITS, &words[i]);
+        }
+        (void)Cy_Crypto_Core_Disable(CRYPTO);
+
+        /* Without a key, every boot is a cold boot */
+        if (CY_CRYPTO_SUCCESS == status)
+        {
+            image_cache_key.s.magic = IMAGE_CACHE_KEY_MAGIC;
+        }
+#endif /* defined(CY_HOST_SIM) */
+    }
+
+    return valid;
+}
+
+/******************************************************************************
+ * Function Name: image_cache_record_mac
+ ******************************************************************************
+ * Summary:
+ *  HMAC-SHA256 of the record up to its MAC, under the key of the Bootloader
+ *  app.
+ *
+ ******************************************************************************/
+static void image_cache_record_mac(const image_cache_record_t *rec, uint8_t *mac)
+{
+    bootutil_sha256_context sha;
+    uint8_t pad[IMAGE_CACHE_HMAC_BLOCK_SIZE];
+    uint8_t inner[IMAGE_CACHE_HASH_SIZE];
+
+    (void)memset(pad, 0x36, sizeof(pad));
+    for (uint32_t i = 0U; i < IMAGE_CACHE_KEY_SIZE; i++)
+    {
+        pad[i] ^= image_cache_key.s.key[i];
+    }
+    bootutil_sha256_init(&sha);
+    (void)bootutil_sha256_update(&sha, pad, sizeof(pad));
+    (void)bootutil_sha256_update(&sha, rec, IMAGE_CACHE_MAC_OFFSET);
+    (void)bootutil_sha256_finish(&sha, inner);
+    bootutil_sha256_drop(&sha);
+
+    (void)memset(pad, 0x5C, sizeof(pad));
+    for (uint32_t i = 0U; i < IMAGE_CACHE_KEY_SIZE; i++)
+    {
+        pad[i] ^= image_cache_key.s.key[i];
+    }
+    bootutil_sha256_init(&sha);
+    (void)bootutil_sha256_update(&sha, pad, sizeof(pad));
+    (void)bootutil_sha256_update(&sha, inner, sizeof(inner));
+    (void)bootutil_sha256_finish(&sha, mac);
+    bootutil_sha256_drop(&sha);
+
+    (void)memset(pad, 0, sizeof(pad));
+}
+
+/******************************************************************************
+ * Function Name: image_cache_record_seal
+ ******************************************************************************
+ * Summary:
+ *  Binds the record to the next key sequence number and computes its MAC.
+ *
+ ******************************************************************************/
+static void image_cache_record_seal(image_cache_record_t *rec)
+{
+    image_cache_key.s.seq++;
+    rec->seq = image_cache_key.s.seq;
+    image_cache_record_mac(rec, rec->mac);
+}
+
+/******************************************************************************
+ * Function Name: image_cache_record_valid
+ ******************************************************************************
+ * Summary:
+ *  Checks the magic, the sequence number and the MAC of the record. The MAC
+ *  is compared in constant time.
+ *
+ ******************************************************************************/
+static bool image_cache_record_valid(const image_cache_record_t *rec)
+{
+    uint8_t mac[IMAGE_CACHE_HASH_SIZE];
+    uint8_t diff = 0U;
+
+    if ((IMAGE_CACHE_MAGIC != rec->magic) || (image_cache_key.s.seq != rec->seq))
+    {
+        return false;
+    }
+
+    image_cache_record_mac(rec, mac);
+    for (uint32_t i = 0U; i < IMAGE_CACHE_HASH_SIZE; i++)
+    {
+        diff |= (uint8_t)(mac[i] ^ rec->mac[i]);
+    }
+
+    return (0U == diff);
+}
+
+/******************************************************************************
+ * Function Name: image_cache_block_crc
+ ******************************************************************************
+ * Summary:
+ *  CRC of one block of the image in the primary slot.
+ *
+ * Return:
+ *  0 on success, -1 if the flash cannot be read
+ *
+ ******************************************************************************/
+static int image_cache_block_crc(const struct flash_area *fap, const image_cache_record_t *rec,
+                                 uint32_t block, uint32_t *crc)
+{
+    uint8_t buf[IMAGE_CACHE_READ_SIZE];
+    uint32_t off = block * rec->block_size;
+    uint32_t end = off + rec->block_size;
+
+    if (end > rec->image_size)
+    {
+        end = rec->image_size;
+    }
+
+    *crc = 0U;
+    while (off < end)
+    {
+        uint32_t len = ((end - off) < sizeof(buf)) ? (end - off) : sizeof(buf);
+
+        if (0 != flash_area_read(fap, off, buf, len))
+        {
+            return -1;
+        }
+        *crc = image_cache_crc(*crc, buf, len);
+        off += len;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: image_cache_read_image
+ ******************************************************************************
+ * Summary:
+ *  Reads the header, the size including the TLVs and the SHA256 TLV of the
+ *  image in the primary slot.
+ *
+ * Return:
+ *  0 on success, -1 if there is no complete image
+ *
+ ******************************************************************************/
+static int image_cache_read_image(const struct flash_area *fap, struct image_header *hdr,
+                                  uint32_t *size, uint8_t *hash)
+{
+    struct image_tlv_info info;
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint16_t len;
+    uint16_t type;
+
+    if ((0 != flash_area_read(fap, 0U, hdr, sizeof(*hdr))) || (IMAGE_MAGIC != hdr->ih_magic))
+    {
+        return -1;
+    }
+
+    off = (uint32_t)hdr->ih_hdr_size + hdr->ih_img_size + hdr->ih_protect_tlv_size;
+    if (((off + sizeof(info)) > fap->fa_size) ||
+        (0 != flash_area_read(fap, off, &info, sizeof(info))) ||
+        (IMAGE_TLV_INFO_MAGIC != info.it_magic))
+    {
+        return -1;
+    }
+
+    *size = off + info.it_tlv_tot;
+    if ((*size > fap->fa_size) ||
+        (0 != bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_SHA256, false)) ||
+        (0 != bootutil_tlv_iter_next(&it, &off, &len, &type)) ||
+        (IMAGE_CACHE_HASH_SIZE != len))
+    {
+        return -1;
+    }
+
+    return flash_area_read(fap, off, hash, IMAGE_CACHE_HASH_SIZE);
+}
+
+/******************************************************************************
+ * Function Name: image_cache_check
+ ******************************************************************************
+ * Summary:
+ *  Decides whether boot_go() can be skipped. Call it before boot_go(), after
+ *  any upgrade has been installed.
+ *
+ *  The image in the primary slot must have the header and the SHA256 TLV of
+ *  the image that was fully validated last, and IMAGE_CACHE_SAMPLES blocks
+ *  of it must have the recorded CRC. There must be no pending upgrade, and
+ *  fewer than IMAGE_CACHE_FULL_PERIOD warm boots since the full validation.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *  rsp - receives the image to boot on IMAGE_CACHE_HIT
+ *  warm_boots - receives the number of warm boots including this one
+ *
+ * Return:
+ *  IMAGE_CACHE_HIT, or the reason why boot_go() must validate the image
+ *
+ ******************************************************************************/
+int image_cache_check(uint32_t image_index, struct boot_rsp *rsp, uint32_t *warm_boots)
+{
+    image_cache_record_t *rec = &image_cache_records[image_index];
+    const struct flash_area *fap = NULL;
+    struct boot_swap_state state;
+    struct image_header hdr;
+    uint8_t hash[IMAGE_CACHE_HASH_SIZE];
+    uint32_t size = 0U;
+    uint32_t crc;
+    int result = IMAGE_CACHE_HIT;
+
+    *warm_boots = 0U;
+
+    if (!image_cache_key_valid() || !image_cache_record_valid(rec))
+    {
+        image_cache_invalidate();
+        return IMAGE_CACHE_COLD;
+    }
+
+    if (rec->warm_boots >= IMAGE_CACHE_FULL_PERIOD)
+    {
+        return IMAGE_CACHE_PERIODIC;
+    }
+
+    /* A pending or interrupted overwrite keeps the secondary trailer */
+    if ((0 != boot_read_swap_state_by_id(FLASH_AREA_IMAGE_SECONDARY(image_index), &state)) ||
+        (BOOT_MAGIC_GOOD == state.magic))
+    {
+        return IMAGE_CACHE_UPGRADE;
+    }
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &fap))
+    {
+        return IMAGE_CACHE_CHANGED;
+    }
+
+    if ((fap->fa_off != rec->image_off) ||
+        (0 != image_cache_read_image(fap, &hdr, &size, hash)) ||
+        (0 != memcmp(&hdr, &rec->hdr, sizeof(hdr))) ||
+        (size != rec->image_size) ||
+        (0 != memcmp(hash, rec->hash, IMAGE_CACHE_HASH_SIZE)))
+    {
+        result = IMAGE_CACHE_CHANGED;
+    }
+
+    for (uint32_t i = 0U; (IMAGE_CACHE_HIT == result) && (i < IMAGE_CACHE_SAMPLES); i++)
+    {
+        uint32_t block = (rec->next_block + i) % IMAGE_CACHE_BLOCKS;
+
+        if ((0 != image_cache_block_crc(fap, rec, block, &crc)) || (crc != rec->block_crc[block]))
+        {
+            result = IMAGE_CACHE_CHANGED;
+        }
+    }
+
+    if (IMAGE_CACHE_HIT == result)
+    {
+#if defined(MCUBOOT_MEASURED_BOOT)
+        /* Same shared data as boot_go() adds for the primary slot */
+        (void)boot_save_boot_status(image_index, &rec->hdr, fap);
+#endif /* MCUBOOT_MEASURED_BOOT */
+#if defined(MCUBOOT_DATA_SHARING)
+        (void)boot_save_shared_data(&rec->hdr, fap);
+#endif /* MCUBOOT_DATA_SHARING */
+
+        rsp->br_hdr = &rec->hdr;
+        rsp->br_flash_dev_id = fap->fa_device_id;
+        rsp->br_image_off = fap->fa_off;
+
+        rec->warm_boots++;
+        rec->next_block = (rec->next_block + IMAGE_CACHE_SAMPLES) % IMAGE_CACHE_BLOCKS;
+        image_cache_record_seal(rec);
+        *warm_boots = rec->warm_boots;
+    }
+    else
+    {
+        image_cache_invalidate();
+    }
+
+    flash_area_close(fap);
+
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: image_cache_update
+ ******************************************************************************
+ * Summary:
+ *  Records the image that boot_go() has just validated. Reads the whole
+ *  image once to compute the CRC of its blocks.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *  rsp - image returned by boot_go()
+ *
+ ******************************************************************************/
+void image_cache_update(uint32_t image_index, const struct boot_rsp *rsp)
+{
+    image_cache_record_t *rec = &image_cache_records[image_index];
+    const struct flash_area *fap = NULL;
+    int rc;
+
+    (void)memset(rec, 0, sizeof(*rec));
+
+    if ((IMAGE_CACHE_KEY_MAGIC != image_cache_key.s.magic) ||
+        (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &fap)))
+    {
+        return;
+    }
+
+    /* Only the primary slot is recorded, and its image must be the one that
+     * boot_go() has validated
+     */
+    rc = ((rsp->br_image_off == fap->fa_off) &&
+          (0 == image_cache_read_image(fap, &rec->hdr, &rec->image_size, rec->hash)) &&
+          (0 == memcmp(&rec->hdr, rsp->br_hdr, sizeof(rec->hdr)))) ? 0 : -1;
+
+    if (0 == rc)
+    {
+        rec->image_off = fap->fa_off;
+        rec->block_size = (rec->image_size + IMAGE_CACHE_BLOCKS - 1U) / IMAGE_CACHE_BLOCKS;
+        for (uint32_t block = 0U; (0 == rc) && (block < IMAGE_CACHE_BLOCKS); block++)
+        {
+            rc = image_cache_block_crc(fap, rec, block, &rec->block_crc[block]);
+        }
+    }
+
+    if (0 == rc)
+    {
+        rec->magic = IMAGE_CACHE_MAGIC;
+        image_cache_record_seal(rec);
+    }
+    else
+    {
+        (void)memset(rec, 0, sizeof(*rec));
+    }
+
+    flash_area_close(fap);
+}
+
+/******************************************************************************
+ * Function Name: image_cache_invalidate
+ ******************************************************************************
+ * Summary:
+ *  Drops the records, the next boot validates every image with boot_go().
+ *
+ ******************************************************************************/
+void image_cache_invalidate(void)
+{
+    (void)memset(image_cache_records, 0, sizeof(image_cache_records));
+}
+
+#if !defined(CY_HOST_SIM)
+/******************************************************************************
+ * Function Name: image_cache_lock
+ ******************************************************************************
+ * Summary:
+ *  Hides the key from the user app. Call it last before the user app is
+ *  launched. An SMPU region denies every access to the key region from a
+ *  protection context other than PC0, only PC0 can change this region, and
+ *  CM4 is moved to IMAGE_CACHE_APP_PC. The protection units are reset with
+ *  the device, so the next boot reads the key again.
+ *
+ *  If the region cannot be protected, the key is dropped, and the next boot
+ *  is a cold boot.
+ *
+ ******************************************************************************/
+void image_cache_lock(void)
+{
+    const cy_stc_smpu_cfg_t slave_cfg =
+    {
+        .address = (uint32_t *)&image_cache_key,
+        .regionSize = CY_PROT_SIZE_256B,
+        .subregions = 0U,
+        .userPermission = CY_PROT_PERM_DISABLED,
+        .privPermission = CY_PROT_PERM_DISABLED,
+        .secure = false,
+        .pcMatch = false,
+        .pcMask = 0U,
+    };
+    const cy_stc_smpu_cfg_t master_cfg =
+    {
+        .userPermission = CY_PROT_PERM_R,
+        .privPermission = CY_PROT_PERM_R,
+        .secure = false,
+        .pcMatch = false,
+        .pcMask = 0U,
+    };
+
+    if ((CY_PROT_SUCCESS != Cy_Prot_ConfigSmpuSlaveStruct(PROT_SMPU_SMPU_STRUCT15, &slave_cfg)) ||
+        (CY_PROT_SUCCESS != Cy_Prot_EnableSmpuSlaveStruct(PROT_SMPU_SMPU_STRUCT15)) ||
+        (CY_PROT_SUCCESS != Cy_Prot_ConfigSmpuMasterStruct(PROT_SMPU_SMPU_STRUCT15, &master_cfg)) ||
+        (CY_PROT_SUCCESS != Cy_Prot_EnableSmpuMasterStruct(PROT_SMPU_SMPU_STRUCT15)) ||
+        (CY_PROT_SUCCESS != Cy_Prot_ConfigBusMaster(CPUSS_MS_ID_CM4, true, false,
+                                                    (1UL << IMAGE_CACHE_APP_PC))) ||
+        (CY_PROT_SUCCESS != Cy_Prot_SetActivePC(CPUSS_MS_ID_CM4, IMAGE_CACHE_APP_PC)))
+    {
+        (void)memset(&image_cache_key, 0, sizeof(image_cache_key));
+        image_cache_invalidate();
+    }
+}
+#endif /* !defined(CY_HOST_SIM) */
+
+#endif /* CY_BOOT_IMAGE_CACHE */
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name:   image_cache.h
+*
+* Description: Validated-image cache. Binds the primary slot image that
+*              boot_go() has fully validated to a record in retained RAM, so
+*              that warm boots only check the header, the hash TLV and a
+*              rotating sample of CRC-checked blocks instead of hashing the
+*              whole image and verifying its signature.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <stdint.h>
+
+/* MCUboot header files */
+#include "bootutil/bootutil.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* The image is split into IMAGE_CACHE_BLOCKS blocks, each with its own CRC.
+ * A warm boot checks IMAGE_CACHE_SAMPLES of them, the next ones on the next
+ * boot, so every block is checked once in IMAGE_CACHE_BLOCKS /
+ * IMAGE_CACHE_SAMPLES warm boots.
+ */
+#ifndef IMAGE_CACHE_BLOCKS
+#define IMAGE_CACHE_BLOCKS          (32U)
+#endif /* IMAGE_CACHE_BLOCKS */
+
+#ifndef IMAGE_CACHE_SAMPLES
+#define IMAGE_CACHE_SAMPLES         (4U)
+#endif /* IMAGE_CACHE_SAMPLES */
+
+/* Number of warm boots after which boot_go() validates the image again */
+#ifndef IMAGE_CACHE_FULL_PERIOD
+#define IMAGE_CACHE_FULL_PERIOD     (16U)
+#endif /* IMAGE_CACHE_FULL_PERIOD */
+
+/* Return values of image_cache_check() */
+#define IMAGE_CACHE_HIT             (0)     /* Warm boot, rsp is filled */
+#define IMAGE_CACHE_COLD            (1)     /* No record, e.g. after power-on */
+#define IMAGE_CACHE_PERIODIC        (2)     /* IMAGE_CACHE_FULL_PERIOD reached */
+#define IMAGE_CACHE_UPGRADE         (3)     /* Upgrade pending or just installed */
+#define IMAGE_CACHE_CHANGED         (4)     /* Image differs from the record */
+
+#if (IMAGE_CACHE_SAMPLES > IMAGE_CACHE_BLOCKS)
+#error "IMAGE_CACHE_SAMPLES must not exceed IMAGE_CACHE_BLOCKS"
+#endif
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  image_cache_check(uint32_t image_index, struct boot_rsp *rsp, uint32_t *warm_boots);
+void image_cache_update(uint32_t image_index, const struct boot_rsp *rsp);
+void image_cache_invalidate(void);
+#if !defined(CY_HOST_SIM)
+void image_cache_lock(void);
+#endif /* !defined(CY_HOST_SIM) */
+
+#endif /* IMAGE_CACHE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,341 @@
+/******************************************************************************
+* File Name:   image_verify.c
+*
+* Description: Multi-image validation of the Bootloader app, see
+*              image_verify.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "image_verify.h"
+
+#if defined(CY_BOOT_MULTI_IMAGE)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#if defined(CY_HOST_SIM)
+#include <time.h>
+#else
+#include "cy_pdl.h"
+#endif /* defined(CY_HOST_SIM) */
+
+/* MCUboot header files */
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/sign_key.h"
+#include "bootutil/fault_injection_hardening.h"
+#include "bootutil_priv.h"
+
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecp.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* SubjectPublicKeyInfo of a P-256 key as written by imgtool: this prefix,
+ * then the uncompressed point
+ */
+#define IMAGE_VERIFY_SPKI_PREFIX_SIZE   (26U)
+#define IMAGE_VERIFY_POINT_SIZE         (65U)
+
+/* The signature TLV can be longer than the DER SEQUENCE inside it */
+#define IMAGE_VERIFY_DER_SEQUENCE       (0x30U)
+#define IMAGE_VERIFY_DER_SHORT_MAX      (0x80U)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    bool loaded;
+    mbedtls_ecdsa_context ctx;
+} image_verify_key_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t image_verify_spki_prefix[IMAGE_VERIFY_SPKI_PREFIX_SIZE] =
+{
+    0x30U, 0x59U, 0x30U, 0x13U, 0x06U, 0x07U, 0x2AU, 0x86U, 0x48U, 0xCEU,
+    0x3DU, 0x02U, 0x01U, 0x06U, 0x08U, 0x2AU, 0x86U, 0x48U, 0xCEU, 0x3DU,
+    0x03U, 0x01U, 0x07U, 0x03U, 0x42U, 0x00U
+};
+
+static image_verify_key_t image_verify_keys[IMAGE_VERIFY_KEYS];
+static image_verify_stats_t image_verify_stats[MCUBOOT_IMAGE_NUMBER];
+static image_verify_key_stats_t image_verify_key_stats;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+fih_int __real_bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
+                                     struct image_header *hdr,
+                                     const struct flash_area *fap,
+                                     uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                                     uint8_t *seed, int seed_len, uint8_t *out_hash);
+fih_int __real_bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig,
+                                   size_t slen, uint8_t key_id);
+
+/******************************************************************************
+ * Function Name: image_verify_now_us
+ ******************************************************************************
+ * Summary:
+ *  Returns a free-running microsecond count. On the device it is derived from
+ *  the DWT cycle counter, which wraps every few tens of seconds, so only the
+ *  differences of two close values are meaningful.
+ *
+ ******************************************************************************/
+static uint32_t image_verify_now_us(void)
+{
+#if defined(CY_HOST_SIM)
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U));
+#else
+    return DWT->CYCCNT / (SystemCoreClock / 1000000U);
+#endif /* defined(CY_HOST_SIM) */
+}
+
+/******************************************************************************
+ * Function Name: image_verify_load_key
+ ******************************************************************************
+ * Summary:
+ *  Parses a P-256 public key of bootutil_keys[] into an ECDSA context, once.
+ *
+ * Parameters:
+ *  key_id - index into bootutil_keys[]
+ *
+ * Return:
+ *  The parsed key, NULL if it is not a P-256 key that can be cached
+ *
+ ******************************************************************************/
+static image_verify_key_t *image_verify_load_key(uint8_t key_id)
+{
+    image_verify_key_t *key = NULL;
+
+    if ((key_id < IMAGE_VERIFY_KEYS) && ((int)key_id < bootutil_key_cnt))
+    {
+        key = &image_verify_keys[key_id];
+
+        if (!key->loaded)
+        {
+            const uint8_t *der = bootutil_keys[key_id].key;
+            unsigned int len = *bootutil_keys[key_id].len;
+
+            if ((IMAGE_VERIFY_SPKI_PREFIX_SIZE + IMAGE_VERIFY_POINT_SIZE != len) ||
+                (0 != memcmp(der, image_verify_spki_prefix, IMAGE_VERIFY_SPKI_PREFIX_SIZE)))
+            {
+                return NULL;
+            }
+
+            mbedtls_ecdsa_init(&key->ctx);
+
+            if ((0 != mbedtls_ecp_group_load(&key->ctx.grp, MBEDTLS_ECP_DP_SECP256R1)) ||
+                (0 != mbedtls_ecp_point_read_binary(&key->ctx.grp, &key->ctx.Q,
+                                                    &der[IMAGE_VERIFY_SPKI_PREFIX_SIZE],
+                                                    IMAGE_VERIFY_POINT_SIZE)) ||
+                (0 != mbedtls_ecp_check_pubkey(&key->ctx.grp, &key->ctx.Q)))
+            {
+                mbedtls_ecdsa_free(&key->ctx);
+                return NULL;
+            }
+
+            key->loaded = true;
+            image_verify_key_stats.key_loads++;
+        }
+    }
+
+    return key;
+}
+
+/******************************************************************************
+ * Function Name: __wrap_bootutil_verify_sig
+ ******************************************************************************
+ * Summary:
+ *  Replaces bootutil_verify_sig() of MCUboot. MCUboot parses the public key
+ *  and loads the curve for every signature, that is for every image and
+ *  slot. Here the parsed key is kept, so every image after the first one
+ *  only pays for the signature check. Keys of another type go to MCUboot.
+ *
+ * Parameters:
+ *  hash - SHA256 of the image
+ *  hlen - size of the hash
+ *  sig - signature TLV
+ *  slen - size of the signature TLV
+ *  key_id - index into bootutil_keys[]
+ *
+ * Return:
+ *  FIH_SUCCESS if the signature matches
+ *
+ ******************************************************************************/
+fih_int __wrap_bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig,
+                                   size_t slen, uint8_t key_id)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    image_verify_key_t *key = image_verify_load_key(key_id);
+
+    if (NULL == key)
+    {
+        FIH_CALL(__real_bootutil_verify_sig, fih_rc, hash, hlen, sig, slen, key_id);
+        FIH_RET(fih_rc);
+    }
+
+    image_verify_key_stats.key_hits++;
+
+    /* The TLV may be padded after the DER encoded signature */
+    if ((slen >= 2U) && (IMAGE_VERIFY_DER_SEQUENCE == sig[0]) &&
+        (sig[1] < IMAGE_VERIFY_DER_SHORT_MAX) && ((size_t)sig[1] + 2U <= slen))
+    {
+        slen = (size_t)sig[1] + 2U;
+    }
+
+    if (0 == mbedtls_ecdsa_read_signature(&key->ctx, hash, hlen, sig, slen))
+    {
+        fih_rc = FIH_SUCCESS;
+    }
+    else
+    {
+        image_verify_key_stats.verify_failures++;
+    }
+
+    FIH_RET(fih_rc);
+}
+
+/******************************************************************************
+ * Function Name: __wrap_bootutil_img_validate
+ ******************************************************************************
+ * Summary:
+ *  Replaces bootutil_img_validate() of MCUboot to time the validation of
+ *  every image. boot_go() validates the images in dependency order, the
+ *  time is summed per image over both slots.
+ *
+ ******************************************************************************/
+fih_int __wrap_bootutil_img_validate(struct enc_key_data *enc_state, int image_index,
+                                     struct image_header *hdr,
+                                     const struct flash_area *fap,
+                                     uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                                     uint8_t *seed, int seed_len, uint8_t *out_hash)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    uint32_t start = image_verify_now_us();
+
+    FIH_CALL(__real_bootutil_img_validate, fih_rc, enc_state, image_index, hdr, fap,
+             tmp_buf, tmp_buf_sz, seed, seed_len, out_hash);
+
+    if ((image_index >= 0) && (image_index < MCUBOOT_IMAGE_NUMBER))
+    {
+        image_verify_stats_t *stats = &image_verify_stats[image_index];
+
+        stats->time_us += image_verify_now_us() - start;
+        stats->validations++;
+        if (FIH_TRUE != fih_eq(fih_rc, FIH_SUCCESS))
+        {
+            stats->failures++;
+        }
+    }
+
+    FIH_RET(fih_rc);
+}
+
+/******************************************************************************
+ * Function Name: image_verify_init
+ ******************************************************************************
+ * Summary:
+ *  Clears the statistics and starts the time base. Call it before boot_go().
+ *  The parsed keys are kept.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+void image_verify_init(void)
+{
+#if !defined(CY_HOST_SIM)
+    if (0U == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0U;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif /* !defined(CY_HOST_SIM) */
+
+    (void)memset(image_verify_stats, 0, sizeof(image_verify_stats));
+    (void)memset(&image_verify_key_stats, 0, sizeof(image_verify_key_stats));
+}
+
+/******************************************************************************
+ * Function Name: image_verify_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the validation statistics of an image since image_verify_init().
+ *
+ * Parameters:
+ *  image_index - image number, 0-based
+ *  stats - filled with the statistics, zeroed for an unknown image
+ *
+ ******************************************************************************/
+void image_verify_get_stats(uint32_t image_index, image_verify_stats_t *stats)
+{
+    if (image_index < (uint32_t)MCUBOOT_IMAGE_NUMBER)
+    {
+        *stats = image_verify_stats[image_index];
+    }
+    else
+    {
+        (void)memset(stats, 0, sizeof(*stats));
+    }
+}
+
+/******************************************************************************
+ * Function Name: image_verify_get_key_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns how often the parsed public keys were reused.
+ *
+ * Parameters:
+ *  stats - filled with the statistics
+ *
+ ******************************************************************************/
+void image_verify_get_key_stats(image_verify_key_stats_t *stats)
+{
+    *stats = image_verify_key_stats;
+}
+
+#endif /* CY_BOOT_MULTI_IMAGE */
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   image_verify.h
+*
+* Description: Multi-image validation of the Bootloader app. The linker
+*              redirects bootutil_img_validate() and bootutil_verify_sig() of
+*              MCUboot here, so the validation time of every image is
+*              recorded and the public key is parsed once for all images.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IMAGE_VERIFY_H
+#define IMAGE_VERIFY_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of public keys whose parsed form is kept, see bootutil_keys[] */
+#ifndef IMAGE_VERIFY_KEYS
+#define IMAGE_VERIFY_KEYS           (2U)
+#endif /* IMAGE_VERIFY_KEYS */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t validations;       /* bootutil_img_validate() calls */
+    uint32_t failures;          /* Of which failed */
+    uint32_t time_us;           /* Spent in bootutil_img_validate() */
+} image_verify_stats_t;
+
+typedef struct
+{
+    uint32_t key_loads;         /* Public keys parsed */
+    uint32_t key_hits;          /* Signatures checked with a parsed key */
+    uint32_t verify_failures;   /* Signatures that did not match */
+} image_verify_key_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void image_verify_init(void);
+void image_verify_get_stats(uint32_t image_index, image_verify_stats_t *stats);
+void image_verify_get_key_stats(image_verify_key_stats_t *stats);
+
+#endif /* IMAGE_VERIFY_H */
+
+/* [] END OF FILE */
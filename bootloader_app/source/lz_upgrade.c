@@ -0,0 +1,391 @@
+/******************************************************************************
+* File Name:   lz_upgrade.c
+*
+* Description: Compressed upgrade images, see lz_upgrade.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "lz_upgrade.h"
+
+#if defined(CY_BOOT_COMPRESSED_UPGRADE)
+
+#include <stdbool.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/bootutil_log.h"
+
+#include "stream_verify.h"
+
+#if !defined(MCUBOOT_OVERWRITE_ONLY)
+#error "Compressed upgrade images require the overwrite upgrade mode"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the blocks read from the secondary slot and written to the
+ * primary slot
+ */
+#define LZ_UPGRADE_CHUNK_SIZE       (MCUBOOT_PLATFORM_CHUNK_SIZE)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Receives the decompressed image in blocks of up to LZ_UPGRADE_CHUNK_SIZE
+ * bytes, off is the offset of the block in the image
+ */
+typedef int (*lz_sink_t)(void *ctx, uint32_t off, uint8_t *data, uint32_t len);
+
+/* Buffered reader of the compressed stream */
+typedef struct
+{
+    const struct flash_area *fap;
+    uint32_t off;                       /* Next offset to read */
+    uint32_t end;                       /* End of the compressed stream */
+    uint32_t pos;                       /* Read position in lz_in_buf */
+    uint32_t len;                       /* Valid bytes in lz_in_buf */
+} lz_input_t;
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Static working memory, about 5 KB with the default chunk size and the TLV
+ * buffer of stream_verify.c
+ */
+static uint8_t lz_window[LZ_WINDOW_SIZE];
+static uint8_t lz_in_buf[LZ_UPGRADE_CHUNK_SIZE];
+static uint8_t lz_out_buf[LZ_UPGRADE_CHUNK_SIZE];
+
+/******************************************************************************
+ * Function Name: lz_read_byte
+ ******************************************************************************
+ * Summary:
+ *  Returns the next byte of the compressed stream, reading the secondary
+ *  slot one chunk at a time.
+ *
+ * Parameters:
+ *  in - stream reader
+ *  byte - receives the byte
+ *
+ * Return:
+ *  0 on success, -1 at the end of the stream or on a read error
+ *
+ ******************************************************************************/
+static int lz_read_byte(lz_input_t *in, uint8_t *byte)
+{
+    if (in->pos == in->len)
+    {
+        uint32_t len = in->end - in->off;
+
+        if (0U == len)
+        {
+            return -1;
+        }
+        if (len > sizeof(lz_in_buf))
+        {
+            len = sizeof(lz_in_buf);
+        }
+        if (0 != flash_area_read(in->fap, in->off, lz_in_buf, len))
+        {
+            return -1;
+        }
+
+        in->off += len;
+        in->pos = 0U;
+        in->len = len;
+    }
+
+    *byte = lz_in_buf[in->pos];
+    in->pos++;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: lz_decompress
+ ******************************************************************************
+ * Summary:
+ *  Decompresses the LZSS stream and passes the image to the sink in blocks
+ *  of LZ_UPGRADE_CHUNK_SIZE bytes. The stream is a sequence of groups: a
+ *  flag byte, LSB first, then 8 items. A set bit is a literal byte, a clear
+ *  bit a 16-bit little-endian match token.
+ *
+ * Parameters:
+ *  in - stream reader, positioned at the start of the stream
+ *  raw_size - size of the decompressed image
+ *  sink - receives the decompressed blocks
+ *  ctx - sink context
+ *
+ * Return:
+ *  0 on success, otherwise the sink error or -1 for a malformed stream
+ *
+ ******************************************************************************/
+static int lz_decompress(lz_input_t *in, uint32_t raw_size, lz_sink_t sink, void *ctx)
+{
+    uint32_t out = 0U;
+    uint32_t fill = 0U;
+    uint32_t wpos = 0U;
+    uint32_t flags = 0U;
+    int rc = 0;
+
+    while ((0 == rc) && (out < raw_size))
+    {
+        uint8_t b0 = 0U;
+        uint8_t b1 = 0U;
+        uint32_t dist = 0U;
+        uint32_t len = 1U;
+
+        /* The marker bit above the flags tells when a new flag byte is due */
+        if (flags <= 1U)
+        {
+            rc = lz_read_byte(in, &b0);
+            flags = 0x100U | b0;
+        }
+
+        if (0 == rc)
+        {
+            rc = lz_read_byte(in, &b0);
+        }
+
+        if ((0 == rc) && (0U == (flags & 1U)))
+        {
+            rc = lz_read_byte(in, &b1);
+            dist = ((((uint32_t)b1 << 8U) | b0) & 0xFFFU) + 1U;
+            len = ((uint32_t)b1 >> 4U) + LZ_MIN_MATCH;
+
+            if ((dist > out) || (len > (raw_size - out)))
+            {
+                rc = -1;
+            }
+        }
+        flags >>= 1U;
+
+        for (uint32_t i = 0U; (0 == rc) && (i < len); i++)
+        {
+            uint8_t byte = (0U == dist) ? b0 : lz_window[(wpos - dist) & (LZ_WINDOW_SIZE - 1U)];
+
+            lz_window[wpos] = byte;
+            wpos = (wpos + 1U) & (LZ_WINDOW_SIZE - 1U);
+            lz_out_buf[fill] = byte;
+            fill++;
+            out++;
+
+            if (sizeof(lz_out_buf) == fill)
+            {
+                rc = sink(ctx, out - fill, lz_out_buf, fill);
+                fill = 0U;
+            }
+        }
+    }
+
+    if ((0 == rc) && (0U != fill))
+    {
+        rc = sink(ctx, out - fill, lz_out_buf, fill);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: lz_validate_sink
+ ******************************************************************************
+ * Summary:
+ *  Passes the decompressed image to the validation.
+ *
+ ******************************************************************************/
+static int lz_validate_sink(void *ctx, uint32_t off, uint8_t *data, uint32_t len)
+{
+    return stream_verify_update((stream_verify_t *)ctx, off, data, len);
+}
+
+/******************************************************************************
+ * Function Name: lz_write_sink
+ ******************************************************************************
+ * Summary:
+ *  Programs a decompressed block into the erased primary slot. The last
+ *  block is padded to the chunk size with the erased value.
+ *
+ ******************************************************************************/
+static int lz_write_sink(void *ctx, uint32_t off, uint8_t *data, uint32_t len)
+{
+    const struct flash_area *fap = (const struct flash_area *)ctx;
+
+    if (len < LZ_UPGRADE_CHUNK_SIZE)
+    {
+        (void)memset(&data[len], flash_area_erased_val(fap), LZ_UPGRADE_CHUNK_SIZE - len);
+    }
+
+    return flash_area_write(fap, off, data, LZ_UPGRADE_CHUNK_SIZE);
+}
+
+/******************************************************************************
+ * Function Name: lz_validate
+ ******************************************************************************
+ * Summary:
+ *  First pass: decompresses the image without writing it and checks its
+ *  header, SHA-256 hash and signature.
+ *
+ * Parameters:
+ *  sec - secondary slot
+ *  lz_hdr - container header
+ *  sv - receives the image header
+ *
+ * Return:
+ *  true if the decompressed image is valid
+ *
+ ******************************************************************************/
+static bool lz_validate(const struct flash_area *sec, const lz_upgrade_header_t *lz_hdr,
+                        stream_verify_t *sv)
+{
+    lz_input_t in = { sec, lz_hdr->hdr_size, (uint32_t)lz_hdr->hdr_size + lz_hdr->comp_size, 0U, 0U };
+    int rc;
+
+    stream_verify_init(sv, lz_hdr->raw_size);
+    rc = lz_decompress(&in, lz_hdr->raw_size, lz_validate_sink, sv);
+
+    if (0 != rc)
+    {
+        bootutil_sha256_drop(&sv->sha);
+        BOOT_LOG_ERR("Compressed image: malformed stream");
+        return false;
+    }
+
+    return stream_verify_finish(sv);
+}
+
+/******************************************************************************
+ * Function Name: lz_upgrade_apply
+ ******************************************************************************
+ * Summary:
+ *  Installs a compressed image found in the secondary slot. Call it before
+ *  boot_go(), which then validates and boots the primary slot as usual.
+ *
+ *  The image is decompressed twice with the same static buffers: first to
+ *  validate the signature over the decompressed image, then to program it
+ *  into the erased primary slot. The secondary slot is erased last, so an
+ *  interrupted installation is repeated on the next boot. An invalid image
+ *  is erased, the primary slot stays untouched.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *
+ * Return:
+ *  LZ_UPGRADE_NONE if there is no compressed image, LZ_UPGRADE_DONE when it
+ *  has been installed, LZ_UPGRADE_ERROR otherwise
+ *
+ ******************************************************************************/
+int lz_upgrade_apply(uint32_t image_index)
+{
+    const struct flash_area *pri = NULL;
+    const struct flash_area *sec = NULL;
+    lz_upgrade_header_t lz_hdr;
+    stream_verify_t sv;
+    bool erase_image = true;
+    int result = LZ_UPGRADE_ERROR;
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &sec))
+    {
+        return LZ_UPGRADE_ERROR;
+    }
+
+    if ((0 != flash_area_read(sec, 0U, &lz_hdr, sizeof(lz_hdr))) ||
+        (LZ_UPGRADE_MAGIC != lz_hdr.magic))
+    {
+        flash_area_close(sec);
+        return LZ_UPGRADE_NONE;
+    }
+
+    BOOT_LOG_INF("Compressed image found: %u -> %u bytes",
+                 (unsigned int)lz_hdr.comp_size, (unsigned int)lz_hdr.raw_size);
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &pri))
+    {
+        flash_area_close(sec);
+        return LZ_UPGRADE_ERROR;
+    }
+
+    if ((LZ_UPGRADE_VERSION != lz_hdr.version) ||
+        (lz_hdr.hdr_size < sizeof(lz_hdr)) ||
+        (lz_hdr.comp_size > (sec->fa_size - lz_hdr.hdr_size)) ||
+        (lz_hdr.raw_size > pri->fa_size))
+    {
+        BOOT_LOG_ERR("Compressed image: unsupported header");
+    }
+    else if (lz_validate(sec, &lz_hdr, &sv))
+    {
+#if defined(MCUBOOT_DOWNGRADE_PREVENTION)
+        if (stream_verify_is_downgrade(pri, &sv.hdr))
+        {
+            BOOT_LOG_ERR("Compressed image: downgrade rejected");
+        }
+        else
+#endif /* MCUBOOT_DOWNGRADE_PREVENTION */
+        {
+            lz_input_t in = { sec, lz_hdr.hdr_size, (uint32_t)lz_hdr.hdr_size + lz_hdr.comp_size, 0U, 0U };
+
+            BOOT_LOG_INF("Decompressing image to the primary slot");
+
+            if ((0 == flash_area_erase(pri, 0U, pri->fa_size)) &&
+                (0 == lz_decompress(&in, lz_hdr.raw_size, lz_write_sink, (void *)pri)))
+            {
+                result = LZ_UPGRADE_DONE;
+            }
+            else
+            {
+                /* Keep the image, the installation is retried on next boot */
+                BOOT_LOG_ERR("Compressed image: writing the primary slot failed");
+                erase_image = false;
+            }
+        }
+    }
+
+    /* Installed or invalid, do not process the image again */
+    if (erase_image)
+    {
+        (void)flash_area_erase(sec, 0U, sec->fa_size);
+    }
+
+    flash_area_close(pri);
+    flash_area_close(sec);
+
+    return result;
+}
+
+#endif /* CY_BOOT_COMPRESSED_UPGRADE */
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/******************************************************************************
+* File Name:   lz_upgrade.h
+*
+* Description: Compressed upgrade images. The secondary slot holds an LZSS-
+*              compressed signed image, which the Bootloader app validates and
+*              then decompresses into the primary slot before boot_go().
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LZ_UPGRADE_H
+#define LZ_UPGRADE_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Container magic, "CMLZ" in flash byte order */
+#define LZ_UPGRADE_MAGIC            (0x5A4C4D43UL)
+#define LZ_UPGRADE_VERSION          (1U)
+
+/* LZSS parameters, must match scripts/lz_compress_image.py. A match token
+ * is 16 bits: distance - 1 in bits 0..11, length - LZ_MIN_MATCH in bits
+ * 12..15.
+ */
+#define LZ_WINDOW_SIZE              (4096U)
+#define LZ_MIN_MATCH                (3U)
+#define LZ_MAX_MATCH                (18U)
+
+/* Return values of lz_upgrade_apply() */
+#define LZ_UPGRADE_NONE             (0)
+#define LZ_UPGRADE_DONE             (1)
+#define LZ_UPGRADE_ERROR            (-1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Header at the start of the secondary slot, followed by the LZSS stream of
+ * the signed image. All fields are little-endian.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t hdr_size;                  /* Offset of the compressed stream */
+    uint32_t raw_size;                  /* Size of the signed image */
+    uint32_t comp_size;                 /* Size of the compressed stream */
+} lz_upgrade_header_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int lz_upgrade_apply(uint32_t image_index);
+
+#endif /* LZ_UPGRADE_H */
+
+/* [] END OF FILE */
@@ -62,6 +62,45 @@
 #if defined(CY_BOOT_USE_EXTERNAL_FLASH)
 #include "flash_qspi.h"
 #endif /* defined(CY_BOOT_USE_EXTERNAL_FLASH) */
+#if defined(CY_BOOT_SFDP_CACHE)
+#include "sfdp_cache_qspi.h"
+#endif /* defined(CY_BOOT_SFDP_CACHE) */
+/* Boot phase timing, compiled out unless CY_BOOT_TIMING is defined */
+#include "boot_timing.h"
+#if defined(CY_BOOT_LOG_TOKENIZED)
+#include "boot_log.h"
+#endif /* defined(CY_BOOT_LOG_TOKENIZED) */
+#if defined(CY_BOOT_COMPRESSED_UPGRADE)
+#include "lz_upgrade.h"
+#endif /* defined(CY_BOOT_COMPRESSED_UPGRADE) */
+
+#if defined(CY_BOOT_DELTA_UPGRADE)
+#include "delta_upgrade.h"
+#endif /* defined(CY_BOOT_DELTA_UPGRADE) */
+
+#if defined(CY_BOOT_SECTOR_SKIP_COPY)
+#include "sector_copy.h"
+#endif /* defined(CY_BOOT_SECTOR_SKIP_COPY) */
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+#include "enc_upgrade.h"
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+#include "flash_cache.h"
+#endif /* defined(CY_BOOT_FLASH_READ_CACHE) */
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+#include "boot_mem.h"
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
+#if defined(CY_BOOT_IMAGE_CACHE)
+#include "image_cache.h"
+#endif /* defined(CY_BOOT_IMAGE_CACHE) */
+
+#if defined(CY_BOOT_MULTI_IMAGE)
+#include "image_verify.h"
+#endif /* defined(CY_BOOT_MULTI_IMAGE) */
 
 /******************************************************************************
 * Macros
@@ -106,8 +145,10 @@ static void hw_deinit(void)
 #endif /* defined(CY_BOOT_USE_EXTERNAL_FLASH) && !defined(MCUBOOT_ENC_IMAGES_XIP) 
         * && !defined(USE_XIP) */
 
+#if !defined(CY_BOOT_LOG_TOKENIZED)
     /* Flush the TX buffer, need to be fixed in retarget_io */
     while(cy_retarget_io_is_tx_active()){}
+#endif /* !defined(CY_BOOT_LOG_TOKENIZED) */
     /* Deinitializing the retarget-io */
     cy_retarget_io_deinit();
 }
@@ -116,7 +157,9 @@ static void hw_deinit(void)
  * Function Name: calc_app_addr
  ******************************************************************************
  * Summary:
- *  This function extracts the calculate the application address
+ *  This function extracts the calculate the application address. With
+ *  direct-XIP, br_image_off is the offset of the slot that won the version
+ *  comparison, so the image is started in place from either slot.
  *
  * Parameters:
  *  flash_base - internal flash base address
@@ -131,6 +174,30 @@ fih_uint calc_app_addr(uintptr_t flash_base, const struct boot_rsp *rsp)
                            rsp->br_hdr->ih_hdr_size);
 }
 
+#if defined(MCUBOOT_DIRECT_XIP)
+/******************************************************************************
+ * Function Name: log_active_slot
+ ******************************************************************************
+ * Summary:
+ *  This function reports which slot the direct-XIP image is started from.
+ *
+ * Parameters:
+ *  rsp - Pointer to a structure holding the address to boot from.
+ *
+ ******************************************************************************/
+static void log_active_slot(const struct boot_rsp *rsp)
+{
+    const struct flash_area *fap = NULL;
+
+    if (0 == flash_area_open(FLASH_AREA_IMAGE_SECONDARY(0U), &fap))
+    {
+        BOOT_LOG_INF("Direct-XIP: running the %s slot in place",
+                     (fap->fa_off == rsp->br_image_off) ? "secondary" : "primary");
+        flash_area_close(fap);
+    }
+}
+#endif /* MCUBOOT_DIRECT_XIP */
+
 /******************************************************************************
  * Function Name: do_boot
  ******************************************************************************
@@ -162,6 +229,9 @@ static bool do_boot(struct boot_rsp *rsp)
             }
 
             BOOT_LOG_INF("Start slot Address: 0x%08" PRIx32, (uint32_t)fih_uint_decode(app_addr));
+#if defined(MCUBOOT_DIRECT_XIP)
+            log_active_slot(rsp);
+#endif /* MCUBOOT_DIRECT_XIP */
 
             result = flash_device_base(rsp->br_flash_dev_id, &flash_base);
 
@@ -180,6 +250,16 @@ static bool do_boot(struct boot_rsp *rsp)
             BOOT_LOG_INF("Launching app on CM4 core");
             BOOT_LOG_INF(BOOT_MSG_FINISH);
             hw_deinit();
+            BOOT_TIMING_MARK(BOOT_TIMING_PHASE_HANDOFF);
+            BOOT_TIMING_PUBLISH();
+#if defined(CY_BOOT_LOG_TOKENIZED)
+            /* The user app prints the log records */
+            (void)boot_log_publish();
+#endif /* defined(CY_BOOT_LOG_TOKENIZED) */
+#if defined(CY_BOOT_IMAGE_CACHE)
+            /* Hides the key of the validated-image cache from the user app */
+            image_cache_lock();
+#endif /* defined(CY_BOOT_IMAGE_CACHE) */
             psoc6_launch_cm4_app(app_addr);
             return true;
 #endif /* BOOT_CM4 */
@@ -246,6 +326,15 @@ int main(void)
     cy_rslt_t result = MCUBOOTAPP_RSLT_ERR;
     cyhal_wdt_t *wdt = NULL;
 
+    BOOT_TIMING_START();
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+    /* mbedTLS allocates from a static arena, the unused stack is painted
+     * for the high-water mark
+     */
+    boot_mem_init();
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
     result = cybsp_init();
     if (CY_RSLT_SUCCESS != result)
     {
@@ -256,6 +345,7 @@ int main(void)
             __WFI();
         }
     }
+    BOOT_TIMING_MARK(BOOT_TIMING_PHASE_BSP_INIT);
 
     /* enable interrupts */
     __enable_irq();
@@ -276,14 +366,33 @@ int main(void)
     
     BOOT_LOG_INF("\x1b[2J\x1b[;H");
     BOOT_LOG_INF("MCUBoot Bootloader Started");
+    BOOT_TIMING_MARK(BOOT_TIMING_PHASE_RETARGET_IO);
 
 #ifdef CY_BOOT_USE_EXTERNAL_FLASH
+#if defined(CY_BOOT_SFDP_CACHE)
+    /* Reuses the SFDP configuration of the previous boot if the memory
+     * reports the same JEDEC ID
+     */
+    bool sfdp_cached = false;
+    cy_en_smif_status_t qspi_status = sfdp_cache_qspi_init(QSPI_SLAVE_SELECT_LINE, &sfdp_cached);
+#else
     cy_en_smif_status_t qspi_status = qspi_init_sfdp(QSPI_SLAVE_SELECT_LINE);
+#endif /* defined(CY_BOOT_SFDP_CACHE) */
+    BOOT_TIMING_MARK(BOOT_TIMING_PHASE_QSPI_INIT);
 
     if (CY_SMIF_SUCCESS == qspi_status)
     {
         result = CY_RSLT_SUCCESS;
-        BOOT_LOG_INF("External Memory initialized w/ SFDP.");
+#if defined(CY_BOOT_SFDP_CACHE)
+        if (sfdp_cached)
+        {
+            BOOT_LOG_INF("External Memory initialized w/ cached SFDP.");
+        }
+        else
+#endif /* defined(CY_BOOT_SFDP_CACHE) */
+        {
+            BOOT_LOG_INF("External Memory initialized w/ SFDP.");
+        }
     }
     else
     {
@@ -294,7 +403,129 @@ int main(void)
     if (CY_RSLT_SUCCESS == result)
 #endif /* CY_BOOT_USE_EXTERNAL_FLASH */
     {
+#if defined(CY_BOOT_COMPRESSED_UPGRADE)
+        /* Installs a compressed image from the secondary slot, boot_go()
+         * then validates the primary slot as usual
+         */
+        if (LZ_UPGRADE_DONE == lz_upgrade_apply(0U))
+        {
+            BOOT_LOG_INF("Compressed image installed");
+        }
+#endif /* defined(CY_BOOT_COMPRESSED_UPGRADE) */
+
+#if defined(CY_BOOT_DELTA_UPGRADE)
+        /* Applies a delta image from the secondary slot to the primary slot,
+         * boot_go() then validates the primary slot as usual
+         */
+        if (DELTA_UPGRADE_DONE == delta_upgrade_apply(0U))
+        {
+            BOOT_LOG_INF("Delta image applied");
+        }
+#endif /* defined(CY_BOOT_DELTA_UPGRADE) */
+
+#if defined(CY_BOOT_SECTOR_SKIP_COPY)
+        /* Installs a pending overwrite upgrade without rewriting the sectors
+         * that already match. Otherwise boot_go() handles the upgrade.
+         */
+        sector_copy_stats_t copy_stats;
+
+        if (SECTOR_COPY_DONE == sector_copy_apply(0U, &copy_stats))
+        {
+            BOOT_LOG_INF("Upgrade image installed");
+        }
+#endif /* defined(CY_BOOT_SECTOR_SKIP_COPY) */
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+        /* Decrypts and verifies a pending encrypted upgrade, then decrypts
+         * and installs it in a second pass. boot_go() then skips the
+         * validation of the installed image.
+         */
+        enc_upgrade_stats_t enc_stats;
+
+        if (ENC_UPGRADE_DONE == enc_upgrade_apply(0U, &enc_stats))
+        {
+            BOOT_LOG_INF("Encrypted image installed: %u bytes read, %u decrypted",
+                         (unsigned int)enc_stats.bytes, (unsigned int)enc_stats.decrypted);
+        }
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+#if defined(CY_BOOT_MULTI_IMAGE)
+        image_verify_init();
+#endif /* defined(CY_BOOT_MULTI_IMAGE) */
+
+#if defined(CY_BOOT_IMAGE_CACHE)
+        /* Skips boot_go() if the primary slot still holds the image that it
+         * validated on an earlier boot. An installed upgrade changes the
+         * header and the hash TLV, so boot_go() validates it.
+         */
+        uint32_t warm_boots = 0U;
+        int cache_result = image_cache_check(0U, &rsp, &warm_boots);
+
+        if (IMAGE_CACHE_HIT == cache_result)
+        {
+            fih_status = FIH_SUCCESS;
+            BOOT_LOG_INF("Validated image cache: warm boot %u of %u",
+                         (unsigned int)warm_boots, (unsigned int)IMAGE_CACHE_FULL_PERIOD);
+        }
+        else
+        {
+            BOOT_LOG_INF("Validated image cache: full validation (reason %d)", cache_result);
+            FIH_CALL(boot_go, fih_status, &rsp);
+
+            if (FIH_TRUE == fih_eq(fih_status, FIH_SUCCESS))
+            {
+                image_cache_update(0U, &rsp);
+            }
+            else
+            {
+                image_cache_invalidate();
+            }
+        }
+#else
         FIH_CALL(boot_go, fih_status, &rsp);
+#endif /* defined(CY_BOOT_IMAGE_CACHE) */
+        BOOT_TIMING_MARK(BOOT_TIMING_PHASE_BOOT_GO);
+
+#if defined(CY_BOOT_MULTI_IMAGE)
+        image_verify_key_stats_t key_stats;
+
+        for (uint32_t image = 0U; image < (uint32_t)MCUBOOT_IMAGE_NUMBER; image++)
+        {
+            image_verify_stats_t verify_stats;
+
+            image_verify_get_stats(image, &verify_stats);
+            BOOT_LOG_INF("Image %u: %u validations, %u failed, %u us",
+                         (unsigned int)(image + 1U), (unsigned int)verify_stats.validations,
+                         (unsigned int)verify_stats.failures, (unsigned int)verify_stats.time_us);
+        }
+
+        image_verify_get_key_stats(&key_stats);
+        BOOT_LOG_INF("Public keys: %u parsed, %u signatures checked, %u mismatched",
+                     (unsigned int)key_stats.key_loads, (unsigned int)key_stats.key_hits,
+                     (unsigned int)key_stats.verify_failures);
+#endif /* defined(CY_BOOT_MULTI_IMAGE) */
+
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+        flash_cache_stats_t cache_stats;
+
+        flash_cache_get_stats(&cache_stats);
+        BOOT_LOG_INF("Flash read cache: %u hits, %u misses, %u bytes fetched, %u bypassed",
+                     (unsigned int)cache_stats.hits, (unsigned int)cache_stats.misses,
+                     (unsigned int)cache_stats.bytes_fetched, (unsigned int)cache_stats.bypassed);
+#endif /* defined(CY_BOOT_FLASH_READ_CACHE) */
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+        boot_mem_stats_t mem_stats;
+
+        boot_mem_arena_reset();
+        boot_mem_get_stats(&mem_stats);
+        BOOT_LOG_INF("Crypto arena: peak %u of %u bytes, %u allocations, %u failed, %u bytes not freed",
+                     (unsigned int)mem_stats.arena_peak, (unsigned int)mem_stats.arena_size,
+                     (unsigned int)mem_stats.arena_allocs, (unsigned int)mem_stats.arena_failed,
+                     (unsigned int)mem_stats.arena_in_use);
+        BOOT_LOG_INF("Stack high-water: %u of %u bytes",
+                     (unsigned int)mem_stats.stack_peak, (unsigned int)mem_stats.stack_size);
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
 
         if (FIH_TRUE == fih_eq(fih_status, FIH_SUCCESS))
         {
@@ -306,6 +537,7 @@ int main(void)
             * to roll back to operable image.
             */
             result = cyhal_wdt_init(wdt, WDT_TIME_OUT_MS);
+            BOOT_TIMING_MARK(BOOT_TIMING_PHASE_WDT_INIT);
 
             if (CY_RSLT_SUCCESS == result)
             {
@@ -327,6 +559,14 @@ int main(void)
         }
     }
 
+#if defined(CY_BOOT_LOG_TOKENIZED)
+    /* No user app takes over the log, print it here */
+    if (!boot_succeeded)
+    {
+        boot_log_dump();
+    }
+#endif /* defined(CY_BOOT_LOG_TOKENIZED) */
+
     deep_sleep_Prepare();
 
     while (true)
@@ -0,0 +1,490 @@
+/******************************************************************************
+* File Name:   sector_copy.c
+*
+* Description: Sector-skip copy engine, see sector_copy.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "sector_copy.h"
+
+#if defined(CY_BOOT_SECTOR_SKIP_COPY)
+
+#include <stdbool.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/bootutil_public.h"
+#include "bootutil/bootutil_log.h"
+
+#if defined(CY_BOOT_PIPELINED_COPY)
+#include "cy_pdl.h"
+#endif /* CY_BOOT_PIPELINED_COPY */
+
+#include "copy_pipe.h"
+#include "stream_verify.h"
+
+#if !defined(MCUBOOT_OVERWRITE_ONLY)
+#error "The sector-skip copy requires the overwrite upgrade mode"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Unit that is compared, erased and programmed, one flash row by default */
+#define SECTOR_COPY_SIZE            (COPY_PIPE_CHUNK_SIZE)
+
+/* The non-blocking flash driver calls write exactly one row */
+#if defined(CY_BOOT_PIPELINED_COPY) && (SECTOR_COPY_SIZE != CY_FLASH_SIZEOF_ROW)
+#error "The pipelined copy requires PLATFORM_CHUNK_SIZE to be the flash row size"
+#endif
+
+/* Size rounded up to whole sectors */
+#define SECTOR_COPY_ALIGN_UP(size) \
+    ((((size) + SECTOR_COPY_SIZE - 1U) / SECTOR_COPY_SIZE) * SECTOR_COPY_SIZE)
+
+/* Size of the secondary slot header and trailer erased after the copy */
+#if defined(CY_BOOT_USE_EXTERNAL_FLASH)
+#define SECTOR_COPY_SEC_ERASE_SIZE(fa) \
+    ((FLASH_DEVICE_INTERNAL_FLASH == (fa)->fa_device_id) ? SECTOR_COPY_SIZE : CY_MAX_EXT_FLASH_ERASE_SIZE)
+#else
+#define SECTOR_COPY_SEC_ERASE_SIZE(fa)  (SECTOR_COPY_SIZE)
+#endif /* CY_BOOT_USE_EXTERNAL_FLASH */
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* State of one copy, shared by the copy port and the chunk callback */
+typedef struct
+{
+    const struct flash_area *pri;
+    const struct flash_area *sec;
+    sector_copy_stats_t *stats;
+    uint8_t erased_val;
+    bool pipelined;
+} sector_copy_ctx_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint8_t sc_sec_buf[SECTOR_COPY_SIZE];
+static uint8_t sc_pri_buf[SECTOR_COPY_SIZE];
+
+/******************************************************************************
+ * Function Name: sector_copy_is_blank
+ ******************************************************************************
+ * Summary:
+ *  Checks if a sector buffer holds only the erased value.
+ *
+ ******************************************************************************/
+static bool sector_copy_is_blank(const uint8_t *buf, uint8_t erased_val)
+{
+    for (uint32_t i = 0U; i < SECTOR_COPY_SIZE; i++)
+    {
+        if (erased_val != buf[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_validate
+ ******************************************************************************
+ * Summary:
+ *  Checks the hash and the signature of the image in the secondary slot.
+ *
+ ******************************************************************************/
+static bool sector_copy_validate(const struct flash_area *sec, stream_verify_t *sv)
+{
+    uint32_t size = 0U;
+    int rc;
+
+    rc = stream_verify_image_size(sec, &size);
+    if (0 != rc)
+    {
+        return false;
+    }
+
+    stream_verify_init(sv, size);
+    for (uint32_t off = 0U; (0 == rc) && (off < size); off += SECTOR_COPY_SIZE)
+    {
+        uint32_t len = ((size - off) < SECTOR_COPY_SIZE) ? (size - off) : SECTOR_COPY_SIZE;
+
+        rc = flash_area_read(sec, off, sc_sec_buf, len);
+        if (0 == rc)
+        {
+            rc = stream_verify_update(sv, off, sc_sec_buf, len);
+        }
+    }
+
+    if (0 != rc)
+    {
+        bootutil_sha256_drop(&sv->sha);
+        return false;
+    }
+
+    return stream_verify_finish(sv);
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_read
+ ******************************************************************************
+ * Summary:
+ *  Reads a sector of the secondary slot for the copy.
+ *
+ ******************************************************************************/
+static int sector_copy_read(void *ctx, uint32_t off, uint8_t *buf, uint32_t len)
+{
+    sector_copy_ctx_t *sc = (sector_copy_ctx_t *)ctx;
+
+    return flash_area_read(sc->sec, off, buf, len);
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_start
+ ******************************************************************************
+ * Summary:
+ *  Erases and/or programs a sector of the primary slot. With the pipelined
+ *  copy, the non-blocking row operations of the flash driver are used and
+ *  sector_copy_wait() completes them. Otherwise the sector is done on return.
+ *
+ ******************************************************************************/
+static int sector_copy_start(void *ctx, uint32_t off, const uint8_t *buf, uint32_t len,
+                             uint32_t ops)
+{
+    sector_copy_ctx_t *sc = (sector_copy_ctx_t *)ctx;
+    int rc = 0;
+
+#if defined(CY_BOOT_PIPELINED_COPY)
+    if (sc->pipelined)
+    {
+        uint32_t addr = CY_FLASH_BASE + sc->pri->fa_off + off;
+        cy_en_flashdrv_status_t status;
+
+        if (0U == (ops & COPY_PIPE_PROGRAM))
+        {
+            status = Cy_Flash_StartEraseRow(addr);
+        }
+        else if (0U != (ops & COPY_PIPE_ERASE))
+        {
+            status = Cy_Flash_StartWrite(addr, (const uint32_t *)buf);
+        }
+        else
+        {
+            status = Cy_Flash_StartProgram(addr, (const uint32_t *)buf);
+        }
+
+        return ((CY_FLASH_DRV_OPERATION_STARTED == status) || (CY_FLASH_DRV_SUCCESS == status)) ? 0 : -1;
+    }
+#endif /* CY_BOOT_PIPELINED_COPY */
+
+    if (0U != (ops & COPY_PIPE_ERASE))
+    {
+        rc = flash_area_erase(sc->pri, off, len);
+    }
+    if ((0 == rc) && (0U != (ops & COPY_PIPE_PROGRAM)))
+    {
+        rc = flash_area_write(sc->pri, off, buf, len);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_wait
+ ******************************************************************************
+ * Summary:
+ *  Waits for the row operation started by sector_copy_start().
+ *
+ ******************************************************************************/
+static int sector_copy_wait(void *ctx)
+{
+    sector_copy_ctx_t *sc = (sector_copy_ctx_t *)ctx;
+    int rc = 0;
+
+#if defined(CY_BOOT_PIPELINED_COPY)
+    if (sc->pipelined)
+    {
+        cy_en_flashdrv_status_t status;
+
+        do
+        {
+            status = Cy_Flash_IsOperationComplete();
+        } while (CY_FLASH_DRV_OPCODE_BUSY == status);
+
+        Cy_SysLib_ClearFlashCacheAndBuffer();
+        rc = (CY_FLASH_DRV_SUCCESS == status) ? 0 : -1;
+    }
+#else
+    (void)sc;
+#endif /* CY_BOOT_PIPELINED_COPY */
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_chunk
+ ******************************************************************************
+ * Summary:
+ *  Compares a sector of the secondary slot with the primary slot and picks
+ *  the operations. Identical sectors are skipped, and a blank sector is only
+ *  erased if the primary slot is not blank there.
+ *
+ *  Only sectors of the image are passed, so a sector of the secondary slot
+ *  is blank only if erasing the primary slot gives the same content. A
+ *  sector that holds the erased value of an external secondary slot (0xFF)
+ *  is data of the image and is programmed into the internal primary slot,
+ *  which is erased to 0x00.
+ *
+ ******************************************************************************/
+static int sector_copy_chunk(void *arg, uint32_t off, const uint8_t *buf, uint32_t len)
+{
+    sector_copy_ctx_t *sc = (sector_copy_ctx_t *)arg;
+    uint32_t ops = COPY_PIPE_SKIP;
+    bool sec_blank = sector_copy_is_blank(buf, sc->erased_val);
+    bool pri_blank;
+
+    if (0 != flash_area_read(sc->pri, off, sc_pri_buf, len))
+    {
+        return -1;
+    }
+    pri_blank = sector_copy_is_blank(sc_pri_buf, sc->erased_val);
+
+    if ((0 == memcmp(buf, sc_pri_buf, len)) || (sec_blank && pri_blank))
+    {
+        if (sec_blank)
+        {
+            sc->stats->skipped_blank++;
+        }
+        else
+        {
+            sc->stats->skipped_same++;
+        }
+        return (int)ops;
+    }
+
+    if (!pri_blank)
+    {
+        ops |= COPY_PIPE_ERASE;
+    }
+
+    if (sec_blank)
+    {
+        sc->stats->erased++;
+    }
+    else
+    {
+        ops |= COPY_PIPE_PROGRAM;
+        sc->stats->programmed++;
+    }
+
+    return (int)ops;
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_run
+ ******************************************************************************
+ * Summary:
+ *  Copies the image in the secondary slot to the primary slot like the
+ *  overwrite upgrade of MCUboot, but compares every sector first, see
+ *  sector_copy_chunk(). Only the sectors of the image are copied. The
+ *  trailer sector of the primary slot is erased unless it is blank, and the
+ *  trailer of the secondary slot is never copied.
+ *
+ *  With CY_BOOT_PIPELINED_COPY and the primary slot in internal flash, the
+ *  next sector is read and compared while the previous one is programmed.
+ *  The overlap only pays off for accesses outside the flash sector being
+ *  programmed, e.g. a secondary slot in external flash; accesses within it
+ *  stall until the row operation completes.
+ *
+ * Parameters:
+ *  pri - primary slot
+ *  sec - secondary slot
+ *  image_size - size of the validated image including the TLVs, which
+ *  sector_copy_fits() has checked
+ *  stats - receives the sector counts
+ *
+ ******************************************************************************/
+static int sector_copy_run(const struct flash_area *pri, const struct flash_area *sec,
+                           uint32_t image_size, sector_copy_stats_t *stats)
+{
+    sector_copy_ctx_t sc =
+    {
+        .pri = pri,
+        .sec = sec,
+        .stats = stats,
+        .erased_val = flash_area_erased_val(pri),
+#if defined(CY_BOOT_PIPELINED_COPY)
+        .pipelined = (FLASH_DEVICE_INTERNAL_FLASH == pri->fa_device_id)
+#else
+        .pipelined = false
+#endif /* CY_BOOT_PIPELINED_COPY */
+    };
+    copy_pipe_port_t port =
+    {
+        .read = sector_copy_read,
+        .start = sector_copy_start,
+        .wait = sector_copy_wait,
+        .ctx = &sc
+    };
+    uint32_t trailer_off = pri->fa_size - SECTOR_COPY_SIZE;
+    int rc;
+
+    rc = copy_pipe_run(&port, SECTOR_COPY_ALIGN_UP(image_size), sector_copy_chunk, &sc,
+                       sc.pipelined);
+
+    /* Resets the trailer of the primary slot */
+    if (0 == rc)
+    {
+        rc = flash_area_read(pri, trailer_off, sc_pri_buf, SECTOR_COPY_SIZE);
+    }
+    if (0 == rc)
+    {
+        if (sector_copy_is_blank(sc_pri_buf, sc.erased_val))
+        {
+            stats->skipped_blank++;
+        }
+        else
+        {
+            rc = flash_area_erase(pri, trailer_off, SECTOR_COPY_SIZE);
+            stats->erased++;
+        }
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_fits
+ ******************************************************************************
+ * Summary:
+ *  Checks that the image, rounded up to a sector, fits in both slots before
+ *  the trailer sector of the primary slot.
+ *
+ ******************************************************************************/
+static bool sector_copy_fits(const struct flash_area *pri, const struct flash_area *sec,
+                             uint32_t image_size)
+{
+    uint32_t end = SECTOR_COPY_ALIGN_UP(image_size);
+
+    return (end >= image_size) && (end <= sec->fa_size) &&
+           (pri->fa_size >= SECTOR_COPY_SIZE) && (end <= (pri->fa_size - SECTOR_COPY_SIZE));
+}
+
+/******************************************************************************
+ * Function Name: sector_copy_apply
+ ******************************************************************************
+ * Summary:
+ *  Installs a pending overwrite upgrade with the sector-skip copy. Call it
+ *  before boot_go(), which then finds no pending upgrade and validates and
+ *  boots the primary slot as usual.
+ *
+ *  The image in the secondary slot is validated first. Its header and
+ *  trailer sectors are erased last, like MCUboot does, so an interrupted
+ *  copy is repeated on the next boot and skips the sectors already copied.
+ *  An invalid image or a downgrade is left to boot_go(), which rejects it.
+ *
+ * Parameters:
+ *  image_index - index of the image
+ *  stats - receives the sector counts
+ *
+ * Return:
+ *  SECTOR_COPY_NONE if there is no valid pending upgrade, SECTOR_COPY_DONE
+ *  when it has been installed, SECTOR_COPY_ERROR otherwise
+ *
+ ******************************************************************************/
+int sector_copy_apply(uint32_t image_index, sector_copy_stats_t *stats)
+{
+    const struct flash_area *pri = NULL;
+    const struct flash_area *sec = NULL;
+    struct boot_swap_state state;
+    uint32_t erase_size;
+    stream_verify_t sv;
+    int result = SECTOR_COPY_NONE;
+
+    (void)memset(stats, 0, sizeof(*stats));
+
+    if ((0 != boot_read_swap_state_by_id(FLASH_AREA_IMAGE_SECONDARY(image_index), &state)) ||
+        (BOOT_MAGIC_GOOD != state.magic))
+    {
+        return SECTOR_COPY_NONE;
+    }
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index), &sec))
+    {
+        return SECTOR_COPY_ERROR;
+    }
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index), &pri))
+    {
+        flash_area_close(sec);
+        return SECTOR_COPY_ERROR;
+    }
+
+    if (sector_copy_validate(sec, &sv) && sector_copy_fits(pri, sec, sv.size)
+#if defined(MCUBOOT_DOWNGRADE_PREVENTION)
+        && !stream_verify_is_downgrade(pri, &sv.hdr)
+#endif /* MCUBOOT_DOWNGRADE_PREVENTION */
+       )
+    {
+        BOOT_LOG_INF("Image upgrade secondary slot -> primary slot, sector-skip copy");
+
+        result = SECTOR_COPY_ERROR;
+        erase_size = SECTOR_COPY_SEC_ERASE_SIZE(sec);
+        if ((0 == sector_copy_run(pri, sec, sv.size, stats)) &&
+            (0 == flash_area_erase(sec, 0U, erase_size)) &&
+            (0 == flash_area_erase(sec, sec->fa_size - erase_size, erase_size)))
+        {
+            result = SECTOR_COPY_DONE;
+        }
+
+        BOOT_LOG_INF("Sectors programmed %u, erased %u, skipped %u identical, %u blank",
+                     (unsigned int)stats->programmed, (unsigned int)stats->erased,
+                     (unsigned int)stats->skipped_same, (unsigned int)stats->skipped_blank);
+    }
+
+    flash_area_close(pri);
+    flash_area_close(sec);
+
+    return result;
+}
+
+#endif /* CY_BOOT_SECTOR_SKIP_COPY */
+
+/* [] END OF FILE */
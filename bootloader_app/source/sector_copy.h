@@ -0,0 +1,76 @@
+/******************************************************************************
+* File Name:   sector_copy.h
+*
+* Description: Sector-skip copy engine for the overwrite upgrade. The
+*              Bootloader app installs a pending upgrade before boot_go() and
+*              compares every sector first, so sectors that are already
+*              identical or blank are neither erased nor programmed.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SECTOR_COPY_H
+#define SECTOR_COPY_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Return values of sector_copy_apply() */
+#define SECTOR_COPY_NONE            (0)
+#define SECTOR_COPY_DONE            (1)
+#define SECTOR_COPY_ERROR           (-1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Sector counts of the last copy */
+typedef struct
+{
+    uint32_t programmed;                /* Erased if needed and programmed */
+    uint32_t erased;                    /* Erased only, the new sector is blank */
+    uint32_t skipped_same;              /* Already identical */
+    uint32_t skipped_blank;             /* Blank in both slots */
+} sector_copy_stats_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int sector_copy_apply(uint32_t image_index, sector_copy_stats_t *stats);
+
+#endif /* SECTOR_COPY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,230 @@
+/******************************************************************************
+* File Name:   sfdp_cache.c
+*
+* Description: Cache of the SFDP-derived memory configuration, see
+*              sfdp_cache.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "sfdp_cache.h"
+
+#if defined(CY_BOOT_SFDP_CACHE) || defined(CY_HOST_SIM)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define SFDP_CACHE_CRC_POLY         (0xEDB88320U)
+#define SFDP_CACHE_CRC_OFFSET       (offsetof(sfdp_cache_header_t, crc))
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Record as found in flash, and the record of the current memory */
+static uint32_t sfdp_cache_old[SFDP_CACHE_RECORD_SIZE / sizeof(uint32_t)];
+static uint32_t sfdp_cache_new[SFDP_CACHE_RECORD_SIZE / sizeof(uint32_t)];
+
+/******************************************************************************
+ * Function Name: sfdp_cache_crc
+ ******************************************************************************
+ * Summary:
+ *  CRC-32 (IEEE 802.3) of a buffer, continued from crc.
+ *
+ ******************************************************************************/
+static uint32_t sfdp_cache_crc(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        crc ^= data[i];
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc >> 1U) ^ (SFDP_CACHE_CRC_POLY & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_record_crc
+ ******************************************************************************
+ * Summary:
+ *  CRC of a record, over the header fields before the CRC field and the
+ *  configuration.
+ *
+ ******************************************************************************/
+static uint32_t sfdp_cache_record_crc(const uint8_t *rec)
+{
+    const sfdp_cache_header_t *hdr = (const sfdp_cache_header_t *)rec;
+    uint32_t crc;
+
+    crc = sfdp_cache_crc(0U, rec, SFDP_CACHE_CRC_OFFSET);
+
+    return sfdp_cache_crc(crc, &rec[sizeof(*hdr)], hdr->cfg_size);
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_is_valid
+ ******************************************************************************
+ * Summary:
+ *  Checks the header and the CRC of a record.
+ *
+ ******************************************************************************/
+static bool sfdp_cache_is_valid(const uint8_t *rec)
+{
+    const sfdp_cache_header_t *hdr = (const sfdp_cache_header_t *)rec;
+
+    return (SFDP_CACHE_MAGIC == hdr->magic) && (SFDP_CACHE_VERSION == hdr->version) &&
+           (0U != hdr->cfg_size) && (hdr->cfg_size <= SFDP_CACHE_CFG_MAX) &&
+           (sfdp_cache_record_crc(rec) == hdr->crc);
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_try
+ ******************************************************************************
+ * Summary:
+ *  Initializes the memory from a valid record and checks that it is the
+ *  memory the record was made for.
+ *
+ ******************************************************************************/
+static bool sfdp_cache_try(const sfdp_cache_port_t *port, const uint8_t *rec)
+{
+    const sfdp_cache_header_t *hdr = (const sfdp_cache_header_t *)rec;
+    uint8_t id[SFDP_CACHE_ID_SIZE];
+
+    if (0 != port->restore(port->ctx, &rec[sizeof(*hdr)], hdr->cfg_size))
+    {
+        return false;
+    }
+
+    if ((0 == port->read_id(port->ctx, id)) &&
+        (0 == memcmp(id, hdr->jedec_id, SFDP_CACHE_ID_SIZE)))
+    {
+        return true;
+    }
+
+    port->release(port->ctx);
+
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_update
+ ******************************************************************************
+ * Summary:
+ *  Builds the record of the discovered memory and stores it if it differs
+ *  from the one in flash. A failure only costs the discovery on the next
+ *  boot, so it is not reported.
+ *
+ ******************************************************************************/
+static void sfdp_cache_update(const sfdp_cache_port_t *port, const uint8_t *old_rec)
+{
+    uint8_t *rec = (uint8_t *)sfdp_cache_new;
+    sfdp_cache_header_t *hdr = (sfdp_cache_header_t *)rec;
+    uint32_t cfg_size = 0U;
+
+    (void)memset(rec, 0, SFDP_CACHE_RECORD_SIZE);
+
+    if ((0 != port->read_id(port->ctx, hdr->jedec_id)) ||
+        (0 != port->save(port->ctx, &rec[sizeof(*hdr)], SFDP_CACHE_CFG_MAX, &cfg_size)) ||
+        (0U == cfg_size) || (cfg_size > SFDP_CACHE_CFG_MAX))
+    {
+        return;
+    }
+
+    hdr->magic = SFDP_CACHE_MAGIC;
+    hdr->version = SFDP_CACHE_VERSION;
+    hdr->cfg_size = (uint16_t)cfg_size;
+    hdr->crc = sfdp_cache_record_crc(rec);
+
+    /* Spares the flash if the record is unchanged */
+    if (0 != memcmp(rec, old_rec, SFDP_CACHE_RECORD_SIZE))
+    {
+        (void)port->store(port->ctx, rec);
+    }
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes the external memory. If the record in flash is valid and
+ *  the JEDEC ID of the memory matches it, the memory is initialized with
+ *  the cached configuration. Otherwise, the full SFDP discovery runs and
+ *  its result is stored for the next boot.
+ *
+ *  The ID check detects a replaced memory part, but not a changed SFDP
+ *  table of the same part.
+ *
+ * Parameters:
+ *  port - memory driver and record storage
+ *
+ * Return:
+ *  SFDP_CACHE_HIT or SFDP_CACHE_MISS when the memory is ready,
+ *  SFDP_CACHE_ERROR if the discovery failed
+ *
+ ******************************************************************************/
+int sfdp_cache_init(const sfdp_cache_port_t *port)
+{
+    uint8_t *old_rec = (uint8_t *)sfdp_cache_old;
+
+    if (0 != port->load(port->ctx, old_rec))
+    {
+        (void)memset(old_rec, 0, SFDP_CACHE_RECORD_SIZE);
+    }
+
+    if (sfdp_cache_is_valid(old_rec) && sfdp_cache_try(port, old_rec))
+    {
+        return SFDP_CACHE_HIT;
+    }
+
+    if (0 != port->discover(port->ctx))
+    {
+        return SFDP_CACHE_ERROR;
+    }
+
+    sfdp_cache_update(port, old_rec);
+
+    return SFDP_CACHE_MISS;
+}
+
+#endif /* CY_BOOT_SFDP_CACHE || CY_HOST_SIM */
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   sfdp_cache.h
+*
+* Description: Cache of the SFDP-derived memory configuration of the external
+*              flash. The configuration is kept in an internal flash record,
+*              protected by a CRC and tagged with the JEDEC ID of the memory,
+*              so later boots skip the SFDP discovery after an ID check.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SFDP_CACHE_H
+#define SFDP_CACHE_H
+
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the record in internal flash, a multiple of the flash row size */
+#ifndef SFDP_CACHE_RECORD_SIZE
+#define SFDP_CACHE_RECORD_SIZE      (0x400U)
+#endif /* SFDP_CACHE_RECORD_SIZE */
+
+#define SFDP_CACHE_MAGIC            (0x43504653U)   /* "SFPC" */
+#define SFDP_CACHE_VERSION          (1U)
+
+/* JEDEC manufacturer and device ID, as returned by the 0x9F command */
+#define SFDP_CACHE_ID_SIZE          (3U)
+
+/* Return values of sfdp_cache_init() */
+#define SFDP_CACHE_HIT              (0)
+#define SFDP_CACHE_MISS             (1)
+#define SFDP_CACHE_ERROR            (-1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Record header, followed by the memory configuration. The CRC covers the
+ * header up to the CRC field and the configuration.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t cfg_size;              /* Size of the configuration that follows */
+    uint8_t  jedec_id[4];           /* SFDP_CACHE_ID_SIZE bytes, rest 0 */
+    uint32_t crc;
+} sfdp_cache_header_t;
+
+#define SFDP_CACHE_CFG_MAX          (SFDP_CACHE_RECORD_SIZE - sizeof(sfdp_cache_header_t))
+
+/* Memory driver and record storage used by the cache */
+typedef struct
+{
+    /* Full SFDP discovery, leaves the memory ready for use */
+    int (*discover)(void *ctx);
+    /* Initializes the memory with a configuration from the record */
+    int (*restore)(void *ctx, const uint8_t *cfg, uint32_t size);
+    /* Serializes the configuration of an initialized memory */
+    int (*save)(void *ctx, uint8_t *cfg, uint32_t max_size, uint32_t *size);
+    /* Reads the JEDEC ID of an initialized memory */
+    int (*read_id)(void *ctx, uint8_t id[SFDP_CACHE_ID_SIZE]);
+    /* Releases the memory after a failed restore */
+    void (*release)(void *ctx);
+    /* Reads and writes the record, SFDP_CACHE_RECORD_SIZE bytes */
+    int (*load)(void *ctx, uint8_t *rec);
+    int (*store)(void *ctx, const uint8_t *rec);
+    void *ctx;
+} sfdp_cache_port_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int sfdp_cache_init(const sfdp_cache_port_t *port);
+
+#endif /* SFDP_CACHE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,338 @@
+/******************************************************************************
+* File Name:   sfdp_cache_qspi.c
+*
+* Description: SFDP cache for the QSPI memory, see sfdp_cache_qspi.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "sfdp_cache_qspi.h"
+
+#if defined(CY_BOOT_SFDP_CACHE)
+
+#include <stddef.h>
+#include <string.h>
+
+#include "flash_qspi.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Read JEDEC ID command, supported by every SFDP memory */
+#define SFDP_QSPI_CMD_READ_ID       (0x9FU)
+
+/* Commands of the device configuration that are cached */
+#define SFDP_QSPI_CMD_COUNT         (10U)
+
+/* Changes with the SMIF driver, whose structures are stored as they are */
+#define SFDP_QSPI_LAYOUT            (((uint32_t)CY_SMIF_DRV_VERSION_MAJOR << 24U) | \
+                                     ((uint32_t)CY_SMIF_DRV_VERSION_MINOR << 16U) | \
+                                     (uint32_t)sizeof(sfdp_qspi_cfg_t))
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Cached configuration. The pointers of the memory and device configuration
+ * are rebuilt on restore.
+ */
+typedef struct
+{
+    uint32_t layout;
+    uint32_t smif_id;
+    uint32_t cmd_mask;                  /* Commands present in the device configuration */
+    cy_stc_smif_mem_config_t mem;
+    cy_stc_smif_mem_device_cfg_t dev;
+    cy_stc_smif_mem_cmd_t cmds[SFDP_QSPI_CMD_COUNT];
+} sfdp_qspi_cfg_t;
+
+typedef struct
+{
+    uint32_t smif_id;
+    cy_en_smif_status_t status;         /* Last status of the SMIF driver */
+} sfdp_qspi_ctx_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const size_t sfdp_qspi_cmd_offs[SFDP_QSPI_CMD_COUNT] =
+{
+    offsetof(cy_stc_smif_mem_device_cfg_t, readSfdpCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, readCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, writeEnCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, writeDisCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, eraseCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, chipEraseCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, programCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, readStsRegWipCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, readStsRegQeCmd),
+    offsetof(cy_stc_smif_mem_device_cfg_t, writeStsRegQeCmd)
+};
+
+/* Memory configuration restored from the record */
+static cy_stc_smif_mem_cmd_t sfdp_qspi_cmds[SFDP_QSPI_CMD_COUNT];
+static cy_stc_smif_mem_device_cfg_t sfdp_qspi_dev;
+static cy_stc_smif_mem_config_t sfdp_qspi_mem;
+static cy_stc_smif_mem_config_t *sfdp_qspi_mems[1] = { &sfdp_qspi_mem };
+static cy_stc_smif_block_config_t sfdp_qspi_blk =
+{
+    .memCount = 1U,
+    .memConfig = sfdp_qspi_mems
+};
+
+static sfdp_qspi_cfg_t sfdp_qspi_cfg;
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_cmd_ptr
+ ******************************************************************************
+ * Summary:
+ *  Returns the location of a command pointer in a device configuration.
+ *
+ ******************************************************************************/
+static cy_stc_smif_mem_cmd_t **sfdp_qspi_cmd_ptr(cy_stc_smif_mem_device_cfg_t *dev, uint32_t idx)
+{
+    return (cy_stc_smif_mem_cmd_t **)(void *)((uint8_t *)dev + sfdp_qspi_cmd_offs[idx]);
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_discover
+ ******************************************************************************/
+static int sfdp_qspi_discover(void *ctx)
+{
+    sfdp_qspi_ctx_t *qc = (sfdp_qspi_ctx_t *)ctx;
+
+    qc->status = qspi_init_sfdp(qc->smif_id);
+
+    return (CY_SMIF_SUCCESS == qc->status) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_restore
+ ******************************************************************************
+ * Summary:
+ *  Initializes the memory with a cached configuration, with the SFDP
+ *  discovery of Cy_SMIF_MemInit() turned off.
+ *
+ ******************************************************************************/
+static int sfdp_qspi_restore(void *ctx, const uint8_t *cfg, uint32_t size)
+{
+    sfdp_qspi_ctx_t *qc = (sfdp_qspi_ctx_t *)ctx;
+
+    if (sizeof(sfdp_qspi_cfg) != size)
+    {
+        return -1;
+    }
+
+    (void)memcpy(&sfdp_qspi_cfg, cfg, size);
+    if ((SFDP_QSPI_LAYOUT != sfdp_qspi_cfg.layout) || (qc->smif_id != sfdp_qspi_cfg.smif_id))
+    {
+        return -1;
+    }
+
+    sfdp_qspi_dev = sfdp_qspi_cfg.dev;
+    for (uint32_t i = 0U; i < SFDP_QSPI_CMD_COUNT; i++)
+    {
+        cy_stc_smif_mem_cmd_t *cmd = NULL;
+
+        if (0U != (sfdp_qspi_cfg.cmd_mask & (1UL << i)))
+        {
+            sfdp_qspi_cmds[i] = sfdp_qspi_cfg.cmds[i];
+            cmd = &sfdp_qspi_cmds[i];
+        }
+        *sfdp_qspi_cmd_ptr(&sfdp_qspi_dev, i) = cmd;
+    }
+
+    sfdp_qspi_mem = sfdp_qspi_cfg.mem;
+    sfdp_qspi_mem.flags &= ~CY_SMIF_FLAG_DETECT_SFDP;
+    sfdp_qspi_mem.deviceCfg = &sfdp_qspi_dev;
+
+    qc->status = qspi_init(&sfdp_qspi_blk);
+
+    return (CY_SMIF_SUCCESS == qc->status) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_save
+ ******************************************************************************
+ * Summary:
+ *  Serializes the discovered configuration. Memories with hybrid sectors
+ *  are not cached, their regions have erase commands of their own.
+ *
+ ******************************************************************************/
+static int sfdp_qspi_save(void *ctx, uint8_t *cfg, uint32_t max_size, uint32_t *size)
+{
+    sfdp_qspi_ctx_t *qc = (sfdp_qspi_ctx_t *)ctx;
+    cy_stc_smif_mem_config_t *mem = qspi_get_memory_config(0);
+
+    if ((sizeof(sfdp_qspi_cfg) > max_size) || (NULL == mem) || (NULL == mem->deviceCfg) ||
+        (0U != mem->deviceCfg->hybridRegionCount))
+    {
+        return -1;
+    }
+
+    (void)memset(&sfdp_qspi_cfg, 0, sizeof(sfdp_qspi_cfg));
+    sfdp_qspi_cfg.layout = SFDP_QSPI_LAYOUT;
+    sfdp_qspi_cfg.smif_id = qc->smif_id;
+    sfdp_qspi_cfg.mem = *mem;
+    sfdp_qspi_cfg.mem.deviceCfg = NULL;
+    sfdp_qspi_cfg.dev = *mem->deviceCfg;
+
+    for (uint32_t i = 0U; i < SFDP_QSPI_CMD_COUNT; i++)
+    {
+        cy_stc_smif_mem_cmd_t **cmd = sfdp_qspi_cmd_ptr(&sfdp_qspi_cfg.dev, i);
+
+        if (NULL != *cmd)
+        {
+            sfdp_qspi_cfg.cmds[i] = **cmd;
+            sfdp_qspi_cfg.cmd_mask |= (1UL << i);
+            *cmd = NULL;
+        }
+    }
+
+    (void)memcpy(cfg, &sfdp_qspi_cfg, sizeof(sfdp_qspi_cfg));
+    *size = sizeof(sfdp_qspi_cfg);
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_read_id
+ ******************************************************************************/
+static int sfdp_qspi_read_id(void *ctx, uint8_t id[SFDP_CACHE_ID_SIZE])
+{
+    sfdp_qspi_ctx_t *qc = (sfdp_qspi_ctx_t *)ctx;
+    cy_stc_smif_mem_config_t *mem = qspi_get_memory_config(0);
+
+    if (NULL == mem)
+    {
+        return -1;
+    }
+
+    qc->status = Cy_SMIF_TransmitCommand(qspi_get_device(), SFDP_QSPI_CMD_READ_ID,
+                                         CY_SMIF_WIDTH_SINGLE, NULL, 0U, CY_SMIF_WIDTH_SINGLE,
+                                         mem->slaveSelect, CY_SMIF_TX_NOT_LAST_BYTE,
+                                         qspi_get_context());
+    if (CY_SMIF_SUCCESS == qc->status)
+    {
+        qc->status = Cy_SMIF_ReceiveDataBlocking(qspi_get_device(), id, SFDP_CACHE_ID_SIZE,
+                                                 CY_SMIF_WIDTH_SINGLE, qspi_get_context());
+    }
+
+    return (CY_SMIF_SUCCESS == qc->status) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_release
+ ******************************************************************************/
+static void sfdp_qspi_release(void *ctx)
+{
+    sfdp_qspi_ctx_t *qc = (sfdp_qspi_ctx_t *)ctx;
+
+    qspi_deinit(qc->smif_id);
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_load
+ ******************************************************************************/
+static int sfdp_qspi_load(void *ctx, uint8_t *rec)
+{
+    (void)ctx;
+    (void)memcpy(rec, (const void *)SFDP_CACHE_ADDRESS, SFDP_CACHE_RECORD_SIZE);
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_qspi_store
+ ******************************************************************************/
+static int sfdp_qspi_store(void *ctx, const uint8_t *rec)
+{
+    cy_en_flashdrv_status_t status = CY_FLASH_DRV_SUCCESS;
+
+    (void)ctx;
+    for (uint32_t off = 0U; (CY_FLASH_DRV_SUCCESS == status) && (off < SFDP_CACHE_RECORD_SIZE);
+         off += CY_FLASH_SIZEOF_ROW)
+    {
+        status = Cy_Flash_WriteRow(SFDP_CACHE_ADDRESS + off, (const uint32_t *)(const void *)&rec[off]);
+    }
+    Cy_SysLib_ClearFlashCacheAndBuffer();
+
+    return (CY_FLASH_DRV_SUCCESS == status) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sfdp_cache_qspi_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes the QSPI memory like qspi_init_sfdp(), but reuses the
+ *  configuration discovered on a previous boot if the JEDEC ID of the
+ *  memory has not changed.
+ *
+ * Parameters:
+ *  smif_id - slave select line of the memory, as for qspi_init_sfdp()
+ *  cached - set to true if the cached configuration was used
+ *
+ * Return:
+ *  CY_SMIF_SUCCESS when the memory is ready, otherwise the status of the
+ *  SFDP discovery
+ *
+ ******************************************************************************/
+cy_en_smif_status_t sfdp_cache_qspi_init(uint32_t smif_id, bool *cached)
+{
+    sfdp_qspi_ctx_t qc =
+    {
+        .smif_id = smif_id,
+        .status = CY_SMIF_SUCCESS
+    };
+    const sfdp_cache_port_t port =
+    {
+        .discover = sfdp_qspi_discover,
+        .restore = sfdp_qspi_restore,
+        .save = sfdp_qspi_save,
+        .read_id = sfdp_qspi_read_id,
+        .release = sfdp_qspi_release,
+        .load = sfdp_qspi_load,
+        .store = sfdp_qspi_store,
+        .ctx = &qc
+    };
+    int rc = sfdp_cache_init(&port);
+
+    *cached = (SFDP_CACHE_HIT == rc);
+
+    return (SFDP_CACHE_ERROR == rc) ? qc.status : CY_SMIF_SUCCESS;
+}
+
+#endif /* CY_BOOT_SFDP_CACHE */
+
+/* [] END OF FILE */
@@ -0,0 +1,69 @@
+/******************************************************************************
+* File Name:   sfdp_cache_qspi.h
+*
+* Description: SFDP cache for the QSPI memory of the external flash. Replaces
+*              qspi_init_sfdp() with a version that reuses the configuration
+*              discovered on a previous boot.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SFDP_CACHE_QSPI_H
+#define SFDP_CACHE_QSPI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cy_pdl.h"
+#include "sfdp_cache.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Address of the record in internal flash, the end of the working flash by
+ * default. The Bootloader app Makefile sets it from SFDP_CACHE_ADDRESS.
+ */
+#ifndef SFDP_CACHE_ADDRESS
+#define SFDP_CACHE_ADDRESS          (CY_EM_EEPROM_BASE + CY_EM_EEPROM_SIZE - SFDP_CACHE_RECORD_SIZE)
+#endif /* SFDP_CACHE_ADDRESS */
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_smif_status_t sfdp_cache_qspi_init(uint32_t smif_id, bool *cached);
+
+#endif /* SFDP_CACHE_QSPI_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,410 @@
+/******************************************************************************
+* File Name:   stream_verify.c
+*
+* Description: Validation of upgrade images, see stream_verify.h.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "stream_verify.h"
+
+#if defined(CY_BOOT_COMPRESSED_UPGRADE) || defined(CY_BOOT_DELTA_UPGRADE) || \
+    defined(CY_BOOT_SECTOR_SKIP_COPY) || defined(CY_BOOT_ENC_UPGRADE)
+
+#include <string.h>
+
+/* MCUboot header files */
+#include "bootutil/sign_key.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/fault_injection_hardening.h"
+#include "bootutil_priv.h"
+
+#if !defined(MCUBOOT_SIGN_EC256)
+#error "Upgrade images installed by the Bootloader app support only ECDSA P-256 signatures"
+#endif
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum size of the TLV area of the signed image */
+#ifndef STREAM_VERIFY_TLV_MAX
+#define STREAM_VERIFY_TLV_MAX       (0x200U)
+#endif /* STREAM_VERIFY_TLV_MAX */
+
+#define STREAM_VERIFY_SHA256_SIZE   (32U)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* TLV area of the image, kept for the signature check */
+static uint8_t sv_tlv_buf[STREAM_VERIFY_TLV_MAX];
+
+/******************************************************************************
+ * Function Name: stream_verify_init
+ ******************************************************************************
+ * Summary:
+ *  Starts the validation of an image.
+ *
+ * Parameters:
+ *  sv - validation state
+ *  size - size of the image including the TLVs
+ *
+ ******************************************************************************/
+void stream_verify_init(stream_verify_t *sv, uint32_t size)
+{
+    (void)memset(sv, 0, sizeof(*sv));
+    sv->size = size;
+    bootutil_sha256_init(&sv->sha);
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_update
+ ******************************************************************************
+ * Summary:
+ *  Hashes the next block of the image like bootutil_img_hash() and keeps its
+ *  TLV area. The first block must contain the whole image header.
+ *
+ * Parameters:
+ *  sv - validation state
+ *  off - offset of the block in the image
+ *  data - block data
+ *  len - block size
+ *
+ * Return:
+ *  0 on success, -1 if the image header is invalid
+ *
+ ******************************************************************************/
+int stream_verify_update(stream_verify_t *sv, uint32_t off, const uint8_t *data, uint32_t len)
+{
+    if (0U == off)
+    {
+        if (len < sizeof(sv->hdr))
+        {
+            return -1;
+        }
+        (void)memcpy(&sv->hdr, data, sizeof(sv->hdr));
+
+        sv->tlv_off = (uint32_t)sv->hdr.ih_hdr_size + sv->hdr.ih_img_size;
+        sv->hash_len = sv->tlv_off + sv->hdr.ih_protect_tlv_size;
+
+        if ((IMAGE_MAGIC != sv->hdr.ih_magic) ||
+            (sv->tlv_off < sv->hdr.ih_hdr_size) ||
+            (sv->tlv_off >= sv->size) ||
+            ((sv->size - sv->tlv_off) > sizeof(sv_tlv_buf)))
+        {
+            return -1;
+        }
+    }
+    else if (0U == sv->tlv_off)
+    {
+        /* The header block is missing */
+        return -1;
+    }
+
+    if (off < sv->hash_len)
+    {
+        uint32_t hash_part = sv->hash_len - off;
+
+        (void)bootutil_sha256_update(&sv->sha, data, (hash_part < len) ? hash_part : len);
+    }
+
+    if ((off + len) > sv->tlv_off)
+    {
+        uint32_t start = (off > sv->tlv_off) ? off : sv->tlv_off;
+
+        (void)memcpy(&sv_tlv_buf[start - sv->tlv_off], &data[start - off], off + len - start);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_find_tlv
+ ******************************************************************************
+ * Summary:
+ *  Looks up a TLV in the protected and unprotected TLV areas of the image.
+ *
+ * Parameters:
+ *  sv - validation state
+ *  type - TLV type
+ *  len - receives the length of the value
+ *
+ * Return:
+ *  Pointer to the value, NULL if the TLV is missing or the area is malformed
+ *
+ ******************************************************************************/
+static uint8_t *stream_verify_find_tlv(const stream_verify_t *sv, uint16_t type, uint16_t *len)
+{
+    uint32_t tlv_len = sv->size - sv->tlv_off;
+    uint32_t prot_size = sv->hdr.ih_protect_tlv_size;
+    struct image_tlv_info info;
+    struct image_tlv tlv;
+    uint32_t end;
+    uint32_t off;
+
+    if ((prot_size + sizeof(info)) > tlv_len)
+    {
+        return NULL;
+    }
+
+    /* The unprotected area follows the protected one, it must end the image */
+    (void)memcpy(&info, &sv_tlv_buf[prot_size], sizeof(info));
+    end = prot_size + info.it_tlv_tot;
+    if ((IMAGE_TLV_INFO_MAGIC != info.it_magic) || (end != tlv_len))
+    {
+        return NULL;
+    }
+
+    if (0U != prot_size)
+    {
+        (void)memcpy(&info, sv_tlv_buf, sizeof(info));
+        if ((IMAGE_TLV_PROT_INFO_MAGIC != info.it_magic) || (prot_size != info.it_tlv_tot))
+        {
+            return NULL;
+        }
+    }
+
+    off = sizeof(info);
+    while ((off + sizeof(tlv)) <= end)
+    {
+        /* Skip the header of the unprotected area */
+        if (off == prot_size)
+        {
+            off += sizeof(info);
+            continue;
+        }
+
+        (void)memcpy(&tlv, &sv_tlv_buf[off], sizeof(tlv));
+        off += sizeof(tlv);
+        if ((off + tlv.it_len) > end)
+        {
+            return NULL;
+        }
+        if (type == tlv.it_type)
+        {
+            *len = tlv.it_len;
+            return &sv_tlv_buf[off];
+        }
+        off += tlv.it_len;
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_find_key
+ ******************************************************************************
+ * Summary:
+ *  Returns the index of the built-in public key whose hash is given in the
+ *  KEYHASH TLV, like bootutil_find_key().
+ *
+ ******************************************************************************/
+static int stream_verify_find_key(const uint8_t *keyhash, uint16_t keyhash_len)
+{
+    bootutil_sha256_context sha;
+    uint8_t hash[STREAM_VERIFY_SHA256_SIZE];
+
+    if (STREAM_VERIFY_SHA256_SIZE != keyhash_len)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < bootutil_key_cnt; i++)
+    {
+        bootutil_sha256_init(&sha);
+        (void)bootutil_sha256_update(&sha, bootutil_keys[i].key, *bootutil_keys[i].len);
+        (void)bootutil_sha256_finish(&sha, hash);
+        bootutil_sha256_drop(&sha);
+
+        if (0 == memcmp(hash, keyhash, STREAM_VERIFY_SHA256_SIZE))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_finish
+ ******************************************************************************
+ * Summary:
+ *  Completes the hash of the image and checks it and the signature against
+ *  the TLVs of the image.
+ *
+ * Parameters:
+ *  sv - validation state, after all blocks of the image have been passed
+ *
+ * Return:
+ *  true if the image is valid
+ *
+ ******************************************************************************/
+bool stream_verify_finish(stream_verify_t *sv)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    uint8_t hash[STREAM_VERIFY_SHA256_SIZE];
+    uint8_t *tlv;
+    uint16_t len = 0U;
+    int key_id;
+
+    (void)bootutil_sha256_finish(&sv->sha, hash);
+    bootutil_sha256_drop(&sv->sha);
+
+    if (0U == sv->tlv_off)
+    {
+        BOOT_LOG_ERR("Upgrade image: invalid header");
+        return false;
+    }
+
+    tlv = stream_verify_find_tlv(sv, IMAGE_TLV_SHA256, &len);
+    if ((NULL == tlv) || (STREAM_VERIFY_SHA256_SIZE != len) ||
+        (0 != memcmp(tlv, hash, STREAM_VERIFY_SHA256_SIZE)))
+    {
+        BOOT_LOG_ERR("Upgrade image: hash mismatch");
+        return false;
+    }
+
+    tlv = stream_verify_find_tlv(sv, IMAGE_TLV_KEYHASH, &len);
+    key_id = (NULL != tlv) ? stream_verify_find_key(tlv, len) : -1;
+    tlv = stream_verify_find_tlv(sv, IMAGE_TLV_ECDSA256, &len);
+    if ((key_id < 0) || (NULL == tlv))
+    {
+        BOOT_LOG_ERR("Upgrade image: no known key or signature");
+        return false;
+    }
+
+    FIH_CALL(bootutil_verify_sig, fih_rc, hash, STREAM_VERIFY_SHA256_SIZE, tlv, len, (uint8_t)key_id);
+
+    if (FIH_TRUE != fih_eq(fih_rc, FIH_SUCCESS))
+    {
+        BOOT_LOG_ERR("Upgrade image: invalid signature");
+        return false;
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_image_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of the image in a slot including its TLVs, from the
+ *  image header and the TLV area headers.
+ *
+ * Parameters:
+ *  sec - slot of the image
+ *  size - receives the image size
+ *
+ * Return:
+ *  0 on success, -1 if the image header or the TLV area headers are invalid
+ *
+ ******************************************************************************/
+int stream_verify_image_size(const struct flash_area *sec, uint32_t *size)
+{
+    struct image_header hdr;
+    struct image_tlv_info info;
+    uint32_t off;
+
+    if ((0 != flash_area_read(sec, 0U, &hdr, sizeof(hdr))) || (IMAGE_MAGIC != hdr.ih_magic))
+    {
+        return -1;
+    }
+
+    off = (uint32_t)hdr.ih_hdr_size + hdr.ih_img_size;
+    if ((off + sizeof(info)) > sec->fa_size)
+    {
+        return -1;
+    }
+
+    if (0U != hdr.ih_protect_tlv_size)
+    {
+        off += hdr.ih_protect_tlv_size;
+        if ((off + sizeof(info)) > sec->fa_size)
+        {
+            return -1;
+        }
+    }
+
+    if ((0 != flash_area_read(sec, off, &info, sizeof(info))) || (IMAGE_TLV_INFO_MAGIC != info.it_magic))
+    {
+        return -1;
+    }
+
+    *size = off + info.it_tlv_tot;
+
+    return (*size <= sec->fa_size) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: stream_verify_is_downgrade
+ ******************************************************************************
+ * Summary:
+ *  Compares the version of the new image with the image in the primary slot,
+ *  like the overwrite upgrade of MCUboot (the build number is ignored).
+ *
+ * Parameters:
+ *  pri - primary slot
+ *  new_hdr - header of the new image
+ *
+ * Return:
+ *  true if the new image is older than a valid image in the primary slot
+ *
+ ******************************************************************************/
+bool stream_verify_is_downgrade(const struct flash_area *pri, const struct image_header *new_hdr)
+{
+    struct image_header hdr;
+    const struct image_version *v1 = &new_hdr->ih_ver;
+    const struct image_version *v2 = &hdr.ih_ver;
+
+    if ((0 != flash_area_read(pri, 0U, &hdr, sizeof(hdr))) || (IMAGE_MAGIC != hdr.ih_magic))
+    {
+        return false;
+    }
+
+    if (v1->iv_major != v2->iv_major)
+    {
+        return v1->iv_major < v2->iv_major;
+    }
+    if (v1->iv_minor != v2->iv_minor)
+    {
+        return v1->iv_minor < v2->iv_minor;
+    }
+    return v1->iv_revision < v2->iv_revision;
+}
+
+#endif /* CY_BOOT_COMPRESSED_UPGRADE || CY_BOOT_DELTA_UPGRADE || CY_BOOT_SECTOR_SKIP_COPY ||
+        * CY_BOOT_ENC_UPGRADE */
+
+/* [] END OF FILE */
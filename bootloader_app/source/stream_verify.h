@@ -0,0 +1,79 @@
+/******************************************************************************
+* File Name:   stream_verify.h
+*
+* Description: Validation of upgrade images that the Bootloader app installs
+*              itself (compressed and delta images, sector-skip copy). The
+*              image is hashed while it is read or generated, then its SHA-256
+*              hash and ECDSA signature are checked with the built-in key like
+*              MCUboot does.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STREAM_VERIFY_H
+#define STREAM_VERIFY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/crypto/sha256.h"
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Hash and TLV state of an image that is passed in blocks, in order */
+typedef struct
+{
+    struct image_header hdr;
+    bootutil_sha256_context sha;
+    uint32_t size;                      /* Image size including the TLVs */
+    uint32_t hash_len;                  /* Header, payload and protected TLVs */
+    uint32_t tlv_off;                   /* Offset of the TLV area */
+} stream_verify_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void stream_verify_init(stream_verify_t *sv, uint32_t size);
+int  stream_verify_update(stream_verify_t *sv, uint32_t off, const uint8_t *data, uint32_t len);
+bool stream_verify_finish(stream_verify_t *sv);
+int  stream_verify_image_size(const struct flash_area *sec, uint32_t *size);
+bool stream_verify_is_downgrade(const struct flash_area *pri, const struct image_header *new_hdr);
+
+#endif /* STREAM_VERIFY_H */
+
+/* [] END OF FILE */
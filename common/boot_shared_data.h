@@ -0,0 +1,193 @@
+/******************************************************************************
+* File Name:   boot_shared_data.h
+*
+* Description: Records that the Bootloader app passes to the user app through
+*              the MCUboot shared data area, in addition to the MCUboot boot
+*              records. Included by both the Bootloader app and the Blinky app
+*              so that the producer and the consumer agree on the layout.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_SHARED_DATA_H
+#define BOOT_SHARED_DATA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Layout of the MCUboot shared data area, see bootutil/boot_status.h:
+ * a 4-byte header (magic, total length including the header) followed by
+ * TLV entries with a 4-byte header (type, length of the data only).
+ */
+#define BOOT_SHARED_DATA_TLV_MAGIC      (0x2016U)
+#define BOOT_SHARED_DATA_HEADER_SIZE    (4U)
+#define BOOT_SHARED_DATA_ENTRY_HDR_SIZE (4U)
+#define BOOT_SHARED_DATA_TLV_TYPE(major, minor) \
+    ((uint16_t)((((uint16_t)(major) & 0xFU) << 12U) | ((uint16_t)(minor) & 0xFFFU)))
+
+/* Major type of the records defined in this file. MCUboot uses the low
+ * major types for its own boot records.
+ */
+#define BOOT_SHARED_DATA_MAJOR_CY       (0xCU)
+
+/* Minor types */
+#define BOOT_SHARED_DATA_MINOR_TIMING   (0x001U)
+#define BOOT_SHARED_DATA_MINOR_LOG      (0x002U)
+
+/* Boot phase timing record */
+#define BOOT_TIMING_RECORD_VERSION      (1U)
+
+/* Tokenized boot log: arguments stored per record. Records of calls with
+ * more arguments keep the first ones, the argument count in the record
+ * tells the host how many were dropped.
+ */
+#define BOOT_LOG_MAX_ARGS               (6U)
+#define BOOT_LOG_INFO_LEVEL(info)       ((uint32_t)(info) >> 4U)
+#define BOOT_LOG_INFO_NARGS(info)       ((uint32_t)(info) & 0xFU)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Boot phases of the Bootloader app. Each stamp is taken at the end of the
+ * phase; BOOT_TIMING_PHASE_START is taken at the beginning of main().
+ * Do not reorder, scripts/boot_timing_decode.py uses the same indices.
+ */
+typedef enum
+{
+    BOOT_TIMING_PHASE_START = 0,    /* Entry of main() */
+    BOOT_TIMING_PHASE_BSP_INIT,     /* cybsp_init() */
+    BOOT_TIMING_PHASE_RETARGET_IO,  /* cy_retarget_io_init() and banner */
+    BOOT_TIMING_PHASE_QSPI_INIT,    /* qspi_init_sfdp(), external flash only */
+    BOOT_TIMING_PHASE_BOOT_GO,      /* boot_go(): validation and upgrade */
+    BOOT_TIMING_PHASE_WDT_INIT,     /* cyhal_wdt_init() */
+    BOOT_TIMING_PHASE_HANDOFF,      /* do_boot() including hw_deinit() */
+    BOOT_TIMING_PHASE_COUNT
+} boot_timing_phase_t;
+
+/* DWT cycle counter values, relative to the entry of main(). A phase that did
+ * not run (e.g. QSPI_INIT without external flash) has its bit in valid_mask
+ * cleared.
+ */
+typedef struct
+{
+    uint8_t  version;
+    uint8_t  phase_count;
+    uint16_t valid_mask;
+    uint32_t core_clock_hz;
+    uint32_t stamps[BOOT_TIMING_PHASE_COUNT];
+} boot_timing_record_t;
+
+/* Tokenized boot log record. The token is the offset of the format string in
+ * the .boot_log_fmt section of the Bootloader app ELF file, which is not
+ * loaded to the device. scripts/boot_log_detokenize.py restores the text.
+ */
+typedef struct
+{
+    uint16_t token;
+    uint8_t  info;                      /* Log level << 4 | argument count */
+    uint8_t  seq;                       /* Low 8 bits of the record number */
+    uint32_t args[BOOT_LOG_MAX_ARGS];
+} boot_log_record_t;
+
+/* Tells the user app where the bootloader left its log records. The records
+ * form a ring: record n is at records[n % capacity], the newest one is
+ * count - 1, and the oldest count - capacity records were overwritten.
+ */
+typedef struct
+{
+    uint32_t records;                   /* Address of boot_log_record_t[] */
+    uint16_t capacity;
+    uint16_t record_size;
+    uint32_t count;
+} boot_log_handoff_t;
+
+/******************************************************************************
+ * Function Name: boot_shared_data_find
+ ******************************************************************************
+ * Summary:
+ *  Looks up a TLV entry in the shared data area.
+ *
+ * Parameters:
+ *  area - start of the shared data area
+ *  area_size - size of the shared data area
+ *  tlv_type - type built with BOOT_SHARED_DATA_TLV_TYPE()
+ *  len - receives the length of the entry data
+ *
+ * Return:
+ *  Pointer to the entry data, or NULL if the area holds no such entry.
+ *
+ ******************************************************************************/
+static inline const uint8_t *boot_shared_data_find(const uint8_t *area,
+                                                   size_t area_size,
+                                                   uint16_t tlv_type,
+                                                   uint16_t *len)
+{
+    uint16_t magic = (uint16_t)(area[0] | ((uint16_t)area[1] << 8U));
+    size_t total = (size_t)(area[2] | ((uint16_t)area[3] << 8U));
+    size_t off = BOOT_SHARED_DATA_HEADER_SIZE;
+
+    if ((BOOT_SHARED_DATA_TLV_MAGIC != magic) || (total > area_size))
+    {
+        return NULL;
+    }
+
+    while ((off + BOOT_SHARED_DATA_ENTRY_HDR_SIZE) <= total)
+    {
+        uint16_t type = (uint16_t)(area[off] | ((uint16_t)area[off + 1U] << 8U));
+        uint16_t size = (uint16_t)(area[off + 2U] | ((uint16_t)area[off + 3U] << 8U));
+
+        off += BOOT_SHARED_DATA_ENTRY_HDR_SIZE;
+        if ((off + size) > total)
+        {
+            break;
+        }
+
+        if (tlv_type == type)
+        {
+            *len = size;
+            return &area[off];
+        }
+        off += size;
+    }
+
+    return NULL;
+}
+
+#endif /* BOOT_SHARED_DATA_H */
+
+/* [] END OF FILE */
@@ -53,6 +53,7 @@ endif
     
 INCLUDES+=\
     ../keys\
+    ../common\
     $(MCUBOOT_PATH)/boot/bootutil/include\
     $(MCUBOOT_PATH)/boot/bootutil/include/bootutil\
     $(MCUBOOT_PATH)/boot/bootutil/src\
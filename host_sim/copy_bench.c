@@ -0,0 +1,448 @@
+/******************************************************************************
+* File Name:   copy_bench.c
+*
+* Description: Host benchmark of the pipelined slot copy. Copies a slot between
+*              simulated devices with and without the overlap of reading,
+*              hashing and programming, and checks the gain.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "flash_sim.h"
+#include "copy_pipe.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same defaults as boot_sim, see sim_main.c */
+#define BENCH_INT_TIMING_DEFAULT    { 0U, 10U, 16000000U, 11000000U }
+#define BENCH_EXT_TIMING_DEFAULT    { 1000U, 40U, 700000U, 520000000U }
+#define BENCH_EXT_ERASE_SIZE        (0x40000U)
+
+/* Software SHA-256 on the CM0+ at 100 MHz, about 70 cycles per byte */
+#define BENCH_HASH_NS_DEFAULT       (700U)
+#define BENCH_SIZE_DEFAULT          (0x40000U)
+
+#define BENCH_DEV_INT               (0U)
+#define BENCH_DEV_EXT               (1U)
+
+/* Exit codes, usable as CI verdicts */
+#define BENCH_EXIT_OK               (0)
+#define BENCH_EXIT_MISMATCH         (1)
+#define BENCH_EXIT_SLOW             (2)
+#define BENCH_EXIT_USAGE            (3)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t size;
+    uint32_t hash_ns;
+    double min_gain;
+    bool src_ext;
+    bool dst_ext;
+    flash_sim_timing_t int_timing;
+    flash_sim_timing_t ext_timing;
+} bench_params_t;
+
+/* Copy port over two simulated devices */
+typedef struct
+{
+    flash_sim_dev_t *src;
+    flash_sim_dev_t *dst;
+    uint32_t src_off;
+    uint32_t dst_off;
+    uint32_t hash_ns;
+    bool pipelined;
+} bench_port_t;
+
+/******************************************************************************
+ * Function Name: usage
+ ******************************************************************************/
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "USAGE: %s [options]\n\n"
+        "Copies a slot chunk by chunk with and without the pipelined copy\n"
+        "and reports the simulated time of both.\n\n"
+        "OPTIONS:\n"
+        "  -z, --size=BYTES        slot size to copy (default 0x%x)\n"
+        "  -s, --src=int|ext       device of the source slot (default int)\n"
+        "  -d, --dst=int|ext       device of the destination slot (default int)\n"
+        "  -H, --hash-ns=NS        CPU time to hash one byte (default %u)\n"
+        "  -t, --timing-int=SPEC   internal flash latencies, ns\n"
+        "  -T, --timing-ext=SPEC   external flash latencies, ns\n"
+        "                          SPEC = read_op,read_byte,program,erase\n"
+        "  -g, --min-gain=PERCENT  fail if the pipelined copy saves less\n"
+        "  -h, --help              display this information\n",
+        prog, BENCH_SIZE_DEFAULT, BENCH_HASH_NS_DEFAULT);
+}
+
+/******************************************************************************
+ * Function Name: parse_device
+ ******************************************************************************/
+static int parse_device(const char *arg, bool *ext)
+{
+    if (0 == strcmp(arg, "int"))
+    {
+        *ext = false;
+    }
+    else if (0 == strcmp(arg, "ext"))
+    {
+        *ext = true;
+    }
+    else
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: parse_args
+ ******************************************************************************/
+static int parse_args(int argc, char *argv[], bench_params_t *p)
+{
+    static const struct option opts[] =
+    {
+        { "size",       required_argument, NULL, 'z' },
+        { "src",        required_argument, NULL, 's' },
+        { "dst",        required_argument, NULL, 'd' },
+        { "hash-ns",    required_argument, NULL, 'H' },
+        { "timing-int", required_argument, NULL, 't' },
+        { "timing-ext", required_argument, NULL, 'T' },
+        { "min-gain",   required_argument, NULL, 'g' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    int opt;
+
+    while (-1 != (opt = getopt_long(argc, argv, "z:s:d:H:t:T:g:h", opts, NULL)))
+    {
+        switch (opt)
+        {
+            case 'z': p->size = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'H': p->hash_ns = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'g': p->min_gain = strtod(optarg, NULL); break;
+            case 's':
+                if (0 != parse_device(optarg, &p->src_ext))
+                {
+                    return -1;
+                }
+                break;
+            case 'd':
+                if (0 != parse_device(optarg, &p->dst_ext))
+                {
+                    return -1;
+                }
+                break;
+            case 't':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->int_timing))
+                {
+                    return -1;
+                }
+                break;
+            case 'T':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->ext_timing))
+                {
+                    return -1;
+                }
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    /* The external slots start on an erase sector */
+    return ((0U != p->size) && (0U == (p->size % BENCH_EXT_ERASE_SIZE))) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: bench_add_device
+ ******************************************************************************
+ * Summary:
+ *  Adds a simulated device backed by an unlinked temporary file.
+ *
+ ******************************************************************************/
+static int bench_add_device(uint8_t id, uint32_t size, uint32_t erase_size,
+                            uint8_t erased_val, bool row_write,
+                            const flash_sim_timing_t *timing)
+{
+    char path[] = "/tmp/copy_bench_XXXXXX";
+    int fd = mkstemp(path);
+    int rc;
+
+    if (fd < 0)
+    {
+        return FLASH_SIM_ERR;
+    }
+    (void)close(fd);
+
+    rc = flash_sim_add_device(id, path, size, erase_size, COPY_PIPE_CHUNK_SIZE,
+                              erased_val, row_write, timing);
+    (void)unlink(path);
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: bench_read
+ ******************************************************************************/
+static int bench_read(void *ctx, uint32_t off, uint8_t *buf, uint32_t len)
+{
+    bench_port_t *port = (bench_port_t *)ctx;
+
+    return flash_sim_read(port->src, port->src_off + off, buf, len, NULL);
+}
+
+/******************************************************************************
+ * Function Name: bench_start
+ ******************************************************************************
+ * Summary:
+ *  Starts the operations on a destination chunk. A row write of the
+ *  internal flash erases and programs in one operation, an external sector
+ *  is erased when the copy reaches its first chunk.
+ *
+ ******************************************************************************/
+static int bench_start(void *ctx, uint32_t off, const uint8_t *buf, uint32_t len,
+                       uint32_t ops)
+{
+    bench_port_t *port = (bench_port_t *)ctx;
+    flash_sim_dev_t *dst = port->dst;
+    uint32_t addr = port->dst_off + off;
+    int rc = FLASH_SIM_OK;
+
+    if ((0U != (ops & COPY_PIPE_ERASE)) && !dst->row_write &&
+        (0U == (addr % dst->erase_size)))
+    {
+        rc = port->pipelined ? flash_sim_start_erase(dst, addr, dst->erase_size, NULL) :
+                               flash_sim_erase(dst, addr, dst->erase_size, NULL);
+    }
+
+    if ((FLASH_SIM_OK == rc) && (0U != (ops & COPY_PIPE_PROGRAM)))
+    {
+        rc = port->pipelined ? flash_sim_start_write(dst, addr, buf, len, NULL) :
+                               flash_sim_write(dst, addr, buf, len, NULL);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: bench_wait
+ ******************************************************************************/
+static int bench_wait(void *ctx)
+{
+    bench_port_t *port = (bench_port_t *)ctx;
+
+    flash_sim_wait(port->dst);
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: bench_chunk
+ ******************************************************************************
+ * Summary:
+ *  Models hashing a chunk, the way the bootloader validates while copying.
+ *
+ ******************************************************************************/
+static int bench_chunk(void *arg, uint32_t off, const uint8_t *buf, uint32_t len)
+{
+    bench_port_t *port = (bench_port_t *)arg;
+
+    (void)off;
+    (void)buf;
+    flash_sim_advance_ns((uint64_t)port->hash_ns * len);
+
+    return (int)(COPY_PIPE_ERASE | COPY_PIPE_PROGRAM);
+}
+
+/******************************************************************************
+ * Function Name: bench_prepare
+ ******************************************************************************
+ * Summary:
+ *  Erases both devices and fills the source slot with a pattern.
+ *
+ ******************************************************************************/
+static void bench_prepare(bench_port_t *port, uint32_t size)
+{
+    uint32_t x = 0x2545F491U;
+
+    flash_sim_fill_erased(flash_sim_get_device(BENCH_DEV_INT));
+    flash_sim_fill_erased(flash_sim_get_device(BENCH_DEV_EXT));
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        port->src->mem[port->src_off + i] = (uint8_t)x;
+    }
+
+    flash_sim_reset_clock();
+}
+
+/******************************************************************************
+ * Function Name: bench_run
+ ******************************************************************************
+ * Summary:
+ *  Copies the source slot and checks the destination.
+ *
+ * Return:
+ *  Simulated time of the copy in nanoseconds, 0 on failure
+ *
+ ******************************************************************************/
+static uint64_t bench_run(bench_port_t *port, uint32_t size, bool pipelined)
+{
+    copy_pipe_port_t pipe =
+    {
+        .read = bench_read,
+        .start = bench_start,
+        .wait = bench_wait,
+        .ctx = port
+    };
+    uint64_t elapsed;
+
+    bench_prepare(port, size);
+    port->pipelined = pipelined;
+
+    if (0 != copy_pipe_run(&pipe, size, bench_chunk, port, pipelined))
+    {
+        return 0U;
+    }
+
+    elapsed = flash_sim_now_ns();
+
+    if (0 != memcmp(&port->src->mem[port->src_off], &port->dst->mem[port->dst_off], size))
+    {
+        return 0U;
+    }
+
+    return elapsed;
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************
+ * Summary:
+ *  Runs the serial and the pipelined copy and compares them.
+ *
+ * Return:
+ *  BENCH_EXIT_OK if both copies are correct and the gain is sufficient
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    bench_params_t params =
+    {
+        .size = BENCH_SIZE_DEFAULT,
+        .hash_ns = BENCH_HASH_NS_DEFAULT,
+        .min_gain = 0.0,
+        .src_ext = false,
+        .dst_ext = false,
+        .int_timing = BENCH_INT_TIMING_DEFAULT,
+        .ext_timing = BENCH_EXT_TIMING_DEFAULT
+    };
+    bench_port_t port;
+    uint64_t serial_ns;
+    uint64_t pipelined_ns;
+    double gain;
+    int exit_code = BENCH_EXIT_OK;
+
+    if (0 != parse_args(argc, argv, &params))
+    {
+        usage(argv[0]);
+        return BENCH_EXIT_USAGE;
+    }
+
+    /* Internal flash: 0x00 erased, row write. External: 0xFF erased NOR */
+    if ((FLASH_SIM_OK != bench_add_device(BENCH_DEV_INT, 2U * params.size,
+                                          COPY_PIPE_CHUNK_SIZE, 0x00U, true,
+                                          &params.int_timing)) ||
+        (FLASH_SIM_OK != bench_add_device(BENCH_DEV_EXT, 2U * params.size,
+                                          BENCH_EXT_ERASE_SIZE, 0xFFU, false,
+                                          &params.ext_timing)))
+    {
+        fprintf(stderr, "copy_bench: cannot create the flash devices\n");
+        flash_sim_close();
+        return BENCH_EXIT_USAGE;
+    }
+
+    port.src = flash_sim_get_device(params.src_ext ? BENCH_DEV_EXT : BENCH_DEV_INT);
+    port.dst = flash_sim_get_device(params.dst_ext ? BENCH_DEV_EXT : BENCH_DEV_INT);
+    port.src_off = 0U;
+    port.dst_off = (port.src == port.dst) ? params.size : 0U;
+    port.hash_ns = params.hash_ns;
+
+    serial_ns = bench_run(&port, params.size, false);
+    pipelined_ns = bench_run(&port, params.size, true);
+    flash_sim_close();
+
+    if ((0U == serial_ns) || (0U == pipelined_ns))
+    {
+        fprintf(stderr, "copy_bench: destination slot does not match the source\n");
+        return BENCH_EXIT_MISMATCH;
+    }
+
+    gain = 100.0 * (double)(serial_ns - pipelined_ns) / (double)serial_ns;
+
+    printf("copy 0x%" PRIx32 " bytes %s -> %s, chunk 0x%x, hash %" PRIu32 " ns/byte\n",
+           params.size, params.src_ext ? "ext" : "int", params.dst_ext ? "ext" : "int",
+           (unsigned int)COPY_PIPE_CHUNK_SIZE, params.hash_ns);
+    printf("  serial:    %10.3f ms\n", (double)serial_ns / 1e6);
+    printf("  pipelined: %10.3f ms\n", (double)pipelined_ns / 1e6);
+    printf("  gain:      %10.2f %%\n", gain);
+
+    if (gain < params.min_gain)
+    {
+        fprintf(stderr, "copy_bench: gain below %.2f %%\n", params.min_gain);
+        exit_code = BENCH_EXIT_SLOW;
+    }
+
+    return exit_code;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,783 @@
+/******************************************************************************
+* File Name:   crypto_bench.c
+*
+* Description: Host micro-benchmark of the image validation of the Bootloader
+*              app. Times SHA-256 over payloads up to the slot size, the TLV
+*              parsing, the ECDSA P-256 verification and the complete
+*              bootutil_img_validate(), built with the same mbedTLS
+*              configuration as the Bootloader app. With ENC_IMG=1, it also
+*              times the verify-then-program install of a plain and an encrypted
+*              upgrade image.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* MCUboot header files */
+#include "memorymap.h"
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/sign_key.h"
+#include "bootutil/crypto/sha256.h"
+#include "bootutil/fault_injection_hardening.h"
+#include "bootutil_priv.h"
+#include "mbedtls/version.h"
+
+#include "flash_sim.h"
+#include "sim_flash_map.h"
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+#include "enc_upgrade.h"
+#include "stream_verify.h"
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+#include "boot_mem.h"
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_DEFAULT_FLASH_FILE    "crypto_bench_flash.bin"
+
+/* Smallest hashed payload, doubled up to the slot size */
+#define BENCH_SHA_MIN_SIZE          (0x1000U)
+
+/* Every measurement is repeated until it runs for at least this long, and
+ * the fastest of BENCH_ROUNDS_DEFAULT rounds is reported */
+#define BENCH_MIN_MS_DEFAULT        (100U)
+#define BENCH_ROUNDS_DEFAULT        (5U)
+
+#define BENCH_SHA256_SIZE           (32U)
+#define BENCH_SIG_MAX_SIZE          (128U)
+
+/* Same size as the buffer of boot_validate_slot() in loader.c */
+#define BENCH_TMPBUF_SIZE           (BOOT_TMPBUF_SZ)
+
+/* Exit codes, usable as CI verdicts */
+#define BENCH_EXIT_OK               (0)
+#define BENCH_EXIT_INVALID          (1)
+#define BENCH_EXIT_USAGE            (3)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    const char *flash_file;
+    const char *image;
+    const char *enc_image;
+    const char *csv_file;
+    uint32_t min_ms;
+    uint32_t rounds;
+} bench_params_t;
+
+typedef struct bench_stage_s bench_stage_t;
+
+/* One measured operation, called iterations times per round */
+typedef bool (*bench_op_t)(const bench_stage_t *stage);
+
+struct bench_stage_s
+{
+    const char *name;
+    uint32_t bytes;
+    bench_op_t op;
+    const uint8_t *buf;
+    const struct flash_area *fap;
+    const struct flash_area *sec;       /* Source of the install stages */
+    struct image_header *hdr;
+};
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* The simulated flash only counts the operations, the bench measures the
+ * host time */
+static const flash_sim_timing_t bench_no_timing = { 0U, 0U, 0U, 0U };
+
+/* Hash and signature of the image, read once by bench_load_image() */
+static uint8_t bench_hash[BENCH_SHA256_SIZE];
+static uint8_t bench_sig[BENCH_SIG_MAX_SIZE];
+static uint16_t bench_sig_len;
+static int bench_key_id = -1;
+
+/* Defeats the removal of operations whose result is not used */
+static volatile uint8_t bench_sink;
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+/* Counts of the last install, both passes over the secondary slot */
+static enc_upgrade_stats_t bench_install_stats;
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+/******************************************************************************
+ * Function Name: usage
+ ******************************************************************************/
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "USAGE: %s [options]\n\n"
+        "Times the stages of the image validation of the Bootloader app:\n"
+        "SHA-256 over 4 KB up to the slot size, TLV parsing, ECDSA P-256\n"
+        "verification and the complete bootutil_img_validate().\n\n"
+        "OPTIONS:\n"
+        "  -i, --image=BIN         signed image for the TLV, verify and\n"
+        "                          validate stages (SHA-256 only without it)\n"
+        "  -e, --enc-image=BIN     the same image encrypted, for the install\n"
+        "                          stages of an ENC_IMG=1 build\n"
+        "  -f, --flash=FILE        backing file of the internal flash (default %s)\n"
+        "  -c, --csv=FILE          write the results to FILE as CSV\n"
+        "  -m, --min-ms=MS         minimum duration of one round (default %u)\n"
+        "  -r, --rounds=N          rounds per stage, the fastest is kept (default %u)\n"
+        "  -h, --help              display this information\n",
+        prog, BENCH_DEFAULT_FLASH_FILE, BENCH_MIN_MS_DEFAULT, BENCH_ROUNDS_DEFAULT);
+}
+
+/******************************************************************************
+ * Function Name: parse_args
+ ******************************************************************************/
+static int parse_args(int argc, char *argv[], bench_params_t *p)
+{
+    static const struct option opts[] =
+    {
+        { "image",      required_argument, NULL, 'i' },
+        { "enc-image",  required_argument, NULL, 'e' },
+        { "flash",      required_argument, NULL, 'f' },
+        { "csv",        required_argument, NULL, 'c' },
+        { "min-ms",     required_argument, NULL, 'm' },
+        { "rounds",     required_argument, NULL, 'r' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    int opt;
+
+    while (-1 != (opt = getopt_long(argc, argv, "i:e:f:c:m:r:h", opts, NULL)))
+    {
+        switch (opt)
+        {
+            case 'i': p->image = optarg; break;
+            case 'e': p->enc_image = optarg; break;
+            case 'f': p->flash_file = optarg; break;
+            case 'c': p->csv_file = optarg; break;
+            case 'm': p->min_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': p->rounds = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                return -1;
+        }
+    }
+
+    if ((optind != argc) || (0U == p->rounds))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: bench_now_ns
+ ******************************************************************************/
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: bench_op_sha256
+ ******************************************************************************
+ * Summary:
+ *  Hashes stage->bytes of the payload buffer, like the image hash of
+ *  bootutil_img_hash().
+ *
+ ******************************************************************************/
+static bool bench_op_sha256(const bench_stage_t *stage)
+{
+    bootutil_sha256_context sha;
+    uint8_t hash[BENCH_SHA256_SIZE];
+
+    bootutil_sha256_init(&sha);
+    (void)bootutil_sha256_update(&sha, stage->buf, stage->bytes);
+    (void)bootutil_sha256_finish(&sha, hash);
+    bootutil_sha256_drop(&sha);
+    bench_sink ^= hash[0];
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: bench_op_tlv
+ ******************************************************************************
+ * Summary:
+ *  Walks the TLV area of the image in the primary slot and reads every
+ *  entry, like bootutil_img_validate() does after the hash.
+ *
+ ******************************************************************************/
+static bool bench_op_tlv(const bench_stage_t *stage)
+{
+    struct image_tlv_iter it;
+    uint8_t buf[BENCH_SIG_MAX_SIZE];
+    uint32_t off;
+    uint16_t len;
+    uint16_t type;
+    uint32_t count = 0U;
+
+    if (0 != bootutil_tlv_iter_begin(&it, stage->hdr, stage->fap, IMAGE_TLV_ANY, false))
+    {
+        return false;
+    }
+
+    while (0 == bootutil_tlv_iter_next(&it, &off, &len, &type))
+    {
+        if ((len > sizeof(buf)) || (0 != flash_area_read(stage->fap, off, buf, len)))
+        {
+            return false;
+        }
+        bench_sink ^= buf[0];
+        count++;
+    }
+
+    return (0U != count);
+}
+
+/******************************************************************************
+ * Function Name: bench_op_verify
+ ******************************************************************************
+ * Summary:
+ *  Verifies the signature TLV of the image against its hash TLV.
+ *
+ ******************************************************************************/
+static bool bench_op_verify(const bench_stage_t *stage)
+{
+    fih_int fih_rc = FIH_FAILURE;
+
+    (void)stage;
+    FIH_CALL(bootutil_verify_sig, fih_rc, bench_hash, BENCH_SHA256_SIZE,
+             bench_sig, bench_sig_len, (uint8_t)bench_key_id);
+
+    return FIH_TRUE == fih_eq(fih_rc, FIH_SUCCESS);
+}
+
+/******************************************************************************
+ * Function Name: bench_op_validate
+ ******************************************************************************
+ * Summary:
+ *  Runs the complete validation of the image in the primary slot, as in
+ *  boot_validate_slot().
+ *
+ ******************************************************************************/
+static bool bench_op_validate(const bench_stage_t *stage)
+{
+    static uint8_t tmpbuf[BENCH_TMPBUF_SIZE];
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(bootutil_img_validate, fih_rc, NULL, 0, stage->hdr,
+             stage->fap, tmpbuf, BENCH_TMPBUF_SIZE, NULL, 0, NULL);
+
+    return FIH_TRUE == fih_eq(fih_rc, FIH_SUCCESS);
+}
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+/******************************************************************************
+ * Function Name: bench_op_install
+ ******************************************************************************
+ * Summary:
+ *  Installs the image in the secondary slot into the primary slot like
+ *  enc_upgrade_apply(): the AES key of an encrypted image is unwrapped, then
+ *  every chunk is decrypted and hashed, and programmed after the signature
+ *  check in a second pass. The counts are kept in bench_install_stats.
+ *
+ ******************************************************************************/
+static bool bench_op_install(const bench_stage_t *stage)
+{
+    uint8_t key[ENC_UPGRADE_KEY_SIZE];
+    const uint8_t *aes_key = NULL;
+
+    if (0U != IS_ENCRYPTED(stage->hdr))
+    {
+        if (0 != enc_upgrade_load_key(stage->sec, stage->hdr, key))
+        {
+            return false;
+        }
+        aes_key = key;
+    }
+
+    return ENC_UPGRADE_DONE == enc_upgrade_copy(stage->fap, stage->sec, aes_key,
+                                                &bench_install_stats);
+}
+
+/******************************************************************************
+ * Function Name: bench_load_upgrade
+ ******************************************************************************
+ * Summary:
+ *  Places an upgrade image into the secondary slot and reads its header and
+ *  size for the install stages.
+ *
+ ******************************************************************************/
+static int bench_load_upgrade(const char *path, const struct flash_area *sec,
+                              struct image_header *hdr, uint32_t *size)
+{
+    if ((0 != sim_flash_map_load(FLASH_AREA_IMAGE_SECONDARY(0U), path)) ||
+        (0 != flash_area_read(sec, 0U, hdr, sizeof(*hdr))) ||
+        (IMAGE_MAGIC != hdr->ih_magic))
+    {
+        return -1;
+    }
+
+    return stream_verify_image_size(sec, size);
+}
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+/******************************************************************************
+ * Function Name: bench_run_stage
+ ******************************************************************************
+ * Summary:
+ *  Calibrates the number of iterations so that one round lasts at least
+ *  min_ms, then returns the fastest of the given number of rounds.
+ *
+ * Parameters:
+ *  stage - operation to measure
+ *  params - duration and number of rounds
+ *  iterations - returns the number of iterations per round
+ *
+ * Return:
+ *  Time of one iteration in ns, 0 if the operation failed
+ *
+ ******************************************************************************/
+static double bench_run_stage(const bench_stage_t *stage, const bench_params_t *params,
+                              uint32_t *iterations)
+{
+    uint64_t min_ns = (uint64_t)params->min_ms * 1000000U;
+    uint64_t best_ns = UINT64_MAX;
+    uint64_t elapsed_ns = 0U;
+    uint32_t n = 1U;
+
+    /* Calibration, the result of the operation is checked once here */
+    while (n < (UINT32_MAX / 2U))
+    {
+        uint64_t start_ns = bench_now_ns();
+
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            if (!stage->op(stage))
+            {
+                return 0.0;
+            }
+        }
+
+        elapsed_ns = bench_now_ns() - start_ns;
+        if (elapsed_ns >= min_ns)
+        {
+            break;
+        }
+        n *= 2U;
+    }
+
+    best_ns = elapsed_ns;
+    for (uint32_t round = 1U; round < params->rounds; round++)
+    {
+        uint64_t start_ns = bench_now_ns();
+
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            (void)stage->op(stage);
+        }
+
+        elapsed_ns = bench_now_ns() - start_ns;
+        if (elapsed_ns < best_ns)
+        {
+            best_ns = elapsed_ns;
+        }
+    }
+
+    *iterations = n;
+
+    return (double)best_ns / (double)n;
+}
+
+/******************************************************************************
+ * Function Name: bench_find_key
+ ******************************************************************************
+ * Summary:
+ *  Returns the index of the built-in public key whose hash is given in the
+ *  KEYHASH TLV, like bootutil_find_key().
+ *
+ ******************************************************************************/
+static int bench_find_key(const uint8_t *keyhash, uint16_t keyhash_len)
+{
+    bootutil_sha256_context sha;
+    uint8_t hash[BENCH_SHA256_SIZE];
+
+    if (BENCH_SHA256_SIZE != keyhash_len)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < bootutil_key_cnt; i++)
+    {
+        bootutil_sha256_init(&sha);
+        (void)bootutil_sha256_update(&sha, bootutil_keys[i].key, *bootutil_keys[i].len);
+        (void)bootutil_sha256_finish(&sha, hash);
+        bootutil_sha256_drop(&sha);
+
+        if (0 == memcmp(hash, keyhash, BENCH_SHA256_SIZE))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * Function Name: bench_load_image
+ ******************************************************************************
+ * Summary:
+ *  Places the signed image into the primary slot, reads its header and
+ *  keeps the hash, key and signature TLVs for the verify stage.
+ *
+ * Return:
+ *  0 if the image has the TLVs of an ECDSA P-256 signed image
+ *
+ ******************************************************************************/
+static int bench_load_image(const char *path, const struct flash_area *fap,
+                            struct image_header *hdr)
+{
+    struct image_tlv_iter it;
+    uint8_t keyhash[BENCH_SHA256_SIZE];
+    bool have_hash = false;
+    bool have_keyhash = false;
+    uint32_t off;
+    uint16_t len;
+    uint16_t type;
+
+    if ((0 != sim_flash_map_load(FLASH_AREA_IMAGE_PRIMARY(0U), path)) ||
+        (0 != flash_area_read(fap, 0U, hdr, sizeof(*hdr))) ||
+        (IMAGE_MAGIC != hdr->ih_magic) ||
+        (0 != bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false)))
+    {
+        return -1;
+    }
+
+    bench_sig_len = 0U;
+    while (0 == bootutil_tlv_iter_next(&it, &off, &len, &type))
+    {
+        if ((IMAGE_TLV_SHA256 == type) && (BENCH_SHA256_SIZE == len))
+        {
+            have_hash = (0 == flash_area_read(fap, off, bench_hash, len));
+        }
+        else if ((IMAGE_TLV_KEYHASH == type) && (BENCH_SHA256_SIZE == len))
+        {
+            have_keyhash = (0 == flash_area_read(fap, off, keyhash, len));
+        }
+        else if ((IMAGE_TLV_ECDSA256 == type) && (len <= BENCH_SIG_MAX_SIZE) &&
+                 (0 == flash_area_read(fap, off, bench_sig, len)))
+        {
+            bench_sig_len = len;
+        }
+    }
+
+    bench_key_id = have_keyhash ? bench_find_key(keyhash, BENCH_SHA256_SIZE) : -1;
+
+    return (have_hash && (0U != bench_sig_len) && (bench_key_id >= 0)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: bench_report
+ ******************************************************************************/
+static void bench_report(FILE *csv, const bench_stage_t *stage, uint32_t iterations,
+                         double ns_per_op)
+{
+    double mib_per_s = 0.0;
+
+    if ((0U != stage->bytes) && (ns_per_op > 0.0))
+    {
+        mib_per_s = ((double)stage->bytes * 1e9) / (ns_per_op * 1048576.0);
+    }
+
+    printf("  %-11s %8" PRIu32 " bytes %12.1f us", stage->name, stage->bytes,
+           ns_per_op / 1000.0);
+    if (0.0 != mib_per_s)
+    {
+        printf(" %9.2f MiB/s", mib_per_s);
+    }
+    printf("\n");
+
+    if (NULL != csv)
+    {
+        fprintf(csv, "%s,%" PRIu32 ",%" PRIu32 ",%.1f,%.3f\n", stage->name,
+                stage->bytes, iterations, ns_per_op, mib_per_s);
+    }
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************
+ * Summary:
+ *  Measures every stage and reports them.
+ *
+ * Return:
+ *  BENCH_EXIT_OK if every stage ran, BENCH_EXIT_INVALID if the image or its
+ *  signature is not valid
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    bench_params_t params =
+    {
+        .flash_file = BENCH_DEFAULT_FLASH_FILE,
+        .min_ms = BENCH_MIN_MS_DEFAULT,
+        .rounds = BENCH_ROUNDS_DEFAULT,
+    };
+    const struct flash_area *fap = NULL;
+    struct image_header hdr;
+    bench_stage_t stage;
+    uint8_t *payload;
+    FILE *csv = NULL;
+    uint32_t iterations = 0U;
+    double ns_per_op;
+    int exit_code = BENCH_EXIT_OK;
+#if defined(CY_BOOT_CRYPTO_ARENA)
+    boot_mem_stats_t mem_stats;
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
+    if (0 != parse_args(argc, argv, &params))
+    {
+        usage(argv[0]);
+        return BENCH_EXIT_USAGE;
+    }
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+    /* mbedTLS allocates from the arena of the Bootloader app */
+    boot_mem_init();
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
+    if ((0 != sim_flash_map_init(params.flash_file, &bench_no_timing, &bench_no_timing)) ||
+        (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(0U), &fap)))
+    {
+        fprintf(stderr, "crypto_bench: cannot set up the simulated flash\n");
+        flash_sim_close();
+        return BENCH_EXIT_USAGE;
+    }
+
+    if (NULL != params.csv_file)
+    {
+        csv = fopen(params.csv_file, "w");
+        if (NULL == csv)
+        {
+            fprintf(stderr, "Cannot open %s\n", params.csv_file);
+            flash_area_close(fap);
+            flash_sim_close();
+            return BENCH_EXIT_USAGE;
+        }
+        fprintf(csv, "stage,bytes,iterations,ns_per_op,mib_per_s\n");
+    }
+
+    printf("mbedTLS %s, %s, slot 0x%" PRIx32 " bytes\n", MBEDTLS_VERSION_STRING,
+           MBEDTLS_CONFIG_FILE, (uint32_t)fap->fa_size);
+
+    /* Pseudo-random payload, the time of SHA-256 does not depend on the data */
+    payload = malloc(fap->fa_size);
+    if (NULL == payload)
+    {
+        exit_code = BENCH_EXIT_USAGE;
+    }
+    else
+    {
+        for (uint32_t i = 0U; i < fap->fa_size; i++)
+        {
+            payload[i] = (uint8_t)((i * 2654435761U) >> 24);
+        }
+
+        memset(&stage, 0, sizeof(stage));
+        stage.name = "sha256";
+        stage.op = bench_op_sha256;
+        stage.buf = payload;
+        for (uint32_t size = BENCH_SHA_MIN_SIZE; size != 0U; size *= 2U)
+        {
+            stage.bytes = (size < fap->fa_size) ? size : (uint32_t)fap->fa_size;
+            ns_per_op = bench_run_stage(&stage, &params, &iterations);
+            bench_report(csv, &stage, iterations, ns_per_op);
+            if (stage.bytes == fap->fa_size)
+            {
+                break;
+            }
+        }
+        free(payload);
+    }
+
+    if ((BENCH_EXIT_OK == exit_code) && (NULL != params.image))
+    {
+        static const struct
+        {
+            const char *name;
+            bench_op_t op;
+        } image_stages[] =
+        {
+            { "tlv",        bench_op_tlv },
+            { "ecdsa_p256", bench_op_verify },
+            { "validate",   bench_op_validate },
+        };
+
+        if (0 != bench_load_image(params.image, fap, &hdr))
+        {
+            fprintf(stderr, "crypto_bench: %s is not an ECDSA P-256 signed image "
+                    "for the built-in key\n", params.image);
+            exit_code = BENCH_EXIT_INVALID;
+        }
+
+        for (uint32_t i = 0U;
+             (BENCH_EXIT_OK == exit_code) && (i < sizeof(image_stages) / sizeof(image_stages[0]));
+             i++)
+        {
+            memset(&stage, 0, sizeof(stage));
+            stage.name = image_stages[i].name;
+            stage.op = image_stages[i].op;
+            stage.fap = fap;
+            stage.hdr = &hdr;
+            /* The validation hashes the header, the payload and the
+             * protected TLVs */
+            if (bench_op_validate == stage.op)
+            {
+                stage.bytes = hdr.ih_hdr_size + hdr.ih_img_size + hdr.ih_protect_tlv_size;
+            }
+
+            ns_per_op = bench_run_stage(&stage, &params, &iterations);
+            if (0.0 == ns_per_op)
+            {
+                fprintf(stderr, "crypto_bench: stage %s failed\n", stage.name);
+                exit_code = BENCH_EXIT_INVALID;
+            }
+            else
+            {
+                /* Reported with the bytes read from the secondary slot, which
+                 * the install reads twice */
+                uint32_t image_size = stage.bytes;
+
+                stage.bytes = bench_install_stats.bytes;
+                bench_report(csv, &stage, iterations, ns_per_op);
+                printf("  %-11s %8" PRIu32 " bytes image, %" PRIu32 " decrypted, %" PRIu32
+                       " chunks programmed\n", "", image_size, bench_install_stats.decrypted,
+                       bench_install_stats.chunks);
+            }
+        }
+    }
+
+#if defined(CY_BOOT_ENC_UPGRADE)
+    /* The plain image first, so the difference of the two stages is the
+     * cost of the encryption */
+    if ((BENCH_EXIT_OK == exit_code) && (NULL != params.image))
+    {
+        const char *install_images[] = { params.image, params.enc_image };
+        const char *install_names[] = { "install", "enc_install" };
+        const struct flash_area *sec = NULL;
+
+        if (0 != flash_area_open(FLASH_AREA_IMAGE_SECONDARY(0U), &sec))
+        {
+            exit_code = BENCH_EXIT_USAGE;
+        }
+
+        for (uint32_t i = 0U; (BENCH_EXIT_OK == exit_code) && (i < 2U); i++)
+        {
+            if (NULL == install_images[i])
+            {
+                continue;
+            }
+
+            memset(&stage, 0, sizeof(stage));
+            stage.name = install_names[i];
+            stage.op = bench_op_install;
+            stage.fap = fap;
+            stage.sec = sec;
+            stage.hdr = &hdr;
+            if ((0 != bench_load_upgrade(install_images[i], sec, &hdr, &stage.bytes)) ||
+                ((0U != IS_ENCRYPTED(&hdr)) != (1U == i)))
+            {
+                fprintf(stderr, "crypto_bench: %s is not a%s upgrade image\n",
+                        install_images[i], (1U == i) ? "n encrypted" : " plain");
+                exit_code = BENCH_EXIT_INVALID;
+                break;
+            }
+
+            ns_per_op = bench_run_stage(&stage, &params, &iterations);
+            if (0.0 == ns_per_op)
+            {
+                fprintf(stderr, "crypto_bench: stage %s failed\n", stage.name);
+                exit_code = BENCH_EXIT_INVALID;
+            }
+            else
+            {
+                bench_report(csv, &stage, iterations, ns_per_op);
+            }
+        }
+
+        if (NULL != sec)
+        {
+            flash_area_close(sec);
+        }
+    }
+#endif /* defined(CY_BOOT_ENC_UPGRADE) */
+
+#if defined(CY_BOOT_CRYPTO_ARENA)
+    boot_mem_arena_reset();
+    boot_mem_get_stats(&mem_stats);
+    printf("Crypto arena: peak %" PRIu32 " of %" PRIu32 " bytes, %" PRIu32 " allocations, "
+           "%" PRIu32 " failed, %" PRIu32 " bytes not freed\n", mem_stats.arena_peak,
+           mem_stats.arena_size, mem_stats.arena_allocs, mem_stats.arena_failed,
+           mem_stats.arena_in_use);
+#endif /* defined(CY_BOOT_CRYPTO_ARENA) */
+
+    if (NULL != csv)
+    {
+        fclose(csv);
+    }
+    flash_area_close(fap);
+    flash_sim_close();
+
+    return exit_code;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,682 @@
+/******************************************************************************
+* File Name:   flash_sim.c
+*
+* Description: File-backed flash device model used by the host build of the
+*              MCUboot Bootloader app.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "flash_sim.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static flash_sim_dev_t flash_sim_devs[FLASH_SIM_MAX_DEVICES];
+
+/* Virtual time of the simulation, advanced by every flash operation */
+static uint64_t flash_sim_clock_ns;
+
+/* Program and erase operations of all devices, and the one to cut */
+static uint64_t flash_sim_ops;
+static uint64_t flash_sim_cut_op;
+static flash_sim_cut_handler_t flash_sim_cut_handler;
+static void *flash_sim_cut_arg;
+
+/******************************************************************************
+ * Function Name: flash_sim_account
+ ******************************************************************************
+ * Summary:
+ *  Advances the virtual clock and adds the cost to the caller's counters.
+ *
+ ******************************************************************************/
+static void flash_sim_account(flash_sim_stats_t *stats, uint64_t ns)
+{
+    flash_sim_clock_ns += ns;
+
+    if (NULL != stats)
+    {
+        stats->time_ns += ns;
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_busy_account
+ ******************************************************************************
+ * Summary:
+ *  Keeps the device busy for a started program or erase. The clock does not
+ *  move, the CPU is free until the next access to the device.
+ *
+ ******************************************************************************/
+static void flash_sim_busy_account(flash_sim_dev_t *dev, flash_sim_stats_t *stats,
+                                   uint64_t ns)
+{
+    dev->busy_until_ns = flash_sim_clock_ns + ns;
+
+    if (NULL != stats)
+    {
+        stats->time_ns += ns;
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_wear
+ ******************************************************************************
+ * Summary:
+ *  Counts an erase cycle for every erase sector in the range.
+ *
+ ******************************************************************************/
+static void flash_sim_wear(flash_sim_dev_t *dev, uint32_t off, uint32_t len)
+{
+    for (uint32_t sector = off / dev->erase_size;
+         (0U != len) && (sector <= (off + len - 1U) / dev->erase_size); sector++)
+    {
+        dev->erase_cycles[sector]++;
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_count_op
+ ******************************************************************************
+ * Summary:
+ *  Counts a program or erase. If it is the one selected by
+ *  flash_sim_set_power_cut(), changes only the first half of its range and
+ *  calls the handler, which does not return.
+ *
+ ******************************************************************************/
+static void flash_sim_count_op(flash_sim_dev_t *dev, bool erase, uint32_t off,
+                               const uint8_t *data, uint32_t len)
+{
+    flash_sim_ops++;
+
+    if ((0U != flash_sim_cut_op) && (flash_sim_ops == flash_sim_cut_op))
+    {
+        uint32_t torn = len / 2U;
+
+        flash_sim_cut_op = 0U;
+        if (erase)
+        {
+            memset(&dev->mem[off], dev->erased_val, torn);
+        }
+        else if (dev->row_write)
+        {
+            memcpy(&dev->mem[off], data, torn);
+        }
+        else
+        {
+            for (uint32_t i = 0U; i < torn; i++)
+            {
+                dev->mem[off + i] = (0U == dev->erased_val) ? (dev->mem[off + i] | data[i]) :
+                                                              (dev->mem[off + i] & data[i]);
+            }
+        }
+
+        flash_sim_cut_handler(dev, erase, off, flash_sim_cut_arg);
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_in_range
+ ******************************************************************************
+ * Summary:
+ *  Checks that [off, off + len) lies within the device.
+ *
+ ******************************************************************************/
+static bool flash_sim_in_range(const flash_sim_dev_t *dev, uint32_t off,
+                               uint32_t len)
+{
+    return (NULL != dev) && (NULL != dev->mem) &&
+           (off <= dev->size) && (len <= dev->size - off);
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_add_device
+ ******************************************************************************
+ * Summary:
+ *  Maps (and creates if needed) the backing file of a flash device. A newly
+ *  created file is filled with the erased value of the device.
+ *
+ * Parameters:
+ *  id - MCUboot flash device ID
+ *  path - backing file
+ *  size - device size in bytes
+ *  erase_size - erase sector size
+ *  prog_size - program unit size
+ *  erased_val - value of an erased byte
+ *  row_write - true if a program overwrites the previous content
+ *  timing - operation latencies
+ *
+ * Return:
+ *  FLASH_SIM_OK on success, FLASH_SIM_ERR otherwise
+ *
+ ******************************************************************************/
+int flash_sim_add_device(uint8_t id, const char *path, uint32_t size,
+                         uint32_t erase_size, uint32_t prog_size,
+                         uint8_t erased_val, bool row_write,
+                         const flash_sim_timing_t *timing)
+{
+    flash_sim_dev_t *dev = NULL;
+    struct stat st;
+    bool fresh = false;
+
+    for (uint32_t i = 0U; i < FLASH_SIM_MAX_DEVICES; i++)
+    {
+        if (!flash_sim_devs[i].in_use)
+        {
+            dev = &flash_sim_devs[i];
+            break;
+        }
+    }
+
+    if ((NULL == dev) || (0U == size) || (0U == erase_size) ||
+        (0U == prog_size) || (0U != (size % erase_size)))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    dev->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (dev->fd < 0)
+    {
+        fprintf(stderr, "flash_sim: cannot open %s: %s\n", path, strerror(errno));
+        return FLASH_SIM_ERR;
+    }
+
+    if (0 != fstat(dev->fd, &st))
+    {
+        close(dev->fd);
+        return FLASH_SIM_ERR;
+    }
+
+    /* A new file, or one left over from another flash map, starts erased */
+    if ((off_t)size != st.st_size)
+    {
+        fresh = true;
+        if (0 != ftruncate(dev->fd, (off_t)size))
+        {
+            close(dev->fd);
+            return FLASH_SIM_ERR;
+        }
+    }
+
+    dev->mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, dev->fd, 0);
+    if (MAP_FAILED == dev->mem)
+    {
+        dev->mem = NULL;
+        close(dev->fd);
+        return FLASH_SIM_ERR;
+    }
+
+    dev->erase_cycles = calloc(size / erase_size, sizeof(uint32_t));
+    if (NULL == dev->erase_cycles)
+    {
+        (void)munmap(dev->mem, size);
+        dev->mem = NULL;
+        close(dev->fd);
+        return FLASH_SIM_ERR;
+    }
+
+    dev->id = id;
+    dev->size = size;
+    dev->erase_size = erase_size;
+    dev->prog_size = prog_size;
+    dev->erased_val = erased_val;
+    dev->row_write = row_write;
+    dev->timing = *timing;
+    dev->in_use = true;
+
+    if (fresh)
+    {
+        flash_sim_fill_erased(dev);
+    }
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_get_device
+ ******************************************************************************
+ * Summary:
+ *  Looks up a simulated device by its MCUboot flash device ID.
+ *
+ ******************************************************************************/
+flash_sim_dev_t *flash_sim_get_device(uint8_t id)
+{
+    for (uint32_t i = 0U; i < FLASH_SIM_MAX_DEVICES; i++)
+    {
+        if (flash_sim_devs[i].in_use && (id == flash_sim_devs[i].id))
+        {
+            return &flash_sim_devs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_close
+ ******************************************************************************
+ * Summary:
+ *  Flushes and unmaps all devices.
+ *
+ ******************************************************************************/
+void flash_sim_close(void)
+{
+    for (uint32_t i = 0U; i < FLASH_SIM_MAX_DEVICES; i++)
+    {
+        flash_sim_dev_t *dev = &flash_sim_devs[i];
+
+        if (dev->in_use)
+        {
+            (void)msync(dev->mem, dev->size, MS_SYNC);
+            (void)munmap(dev->mem, dev->size);
+            (void)close(dev->fd);
+            free(dev->erase_cycles);
+            memset(dev, 0, sizeof(*dev));
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_read
+ ******************************************************************************
+ * Summary:
+ *  Reads from a device, one transaction.
+ *
+ ******************************************************************************/
+int flash_sim_read(flash_sim_dev_t *dev, uint32_t off, void *dst,
+                   uint32_t len, flash_sim_stats_t *stats)
+{
+    if (!flash_sim_in_range(dev, off, len))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    /* No read while write within a device */
+    flash_sim_wait(dev);
+    memcpy(dst, &dev->mem[off], len);
+
+    if (NULL != stats)
+    {
+        stats->reads++;
+        stats->read_bytes += len;
+    }
+    flash_sim_account(stats, dev->timing.read_op_ns +
+                             (uint64_t)dev->timing.read_byte_ns * len);
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_program
+ ******************************************************************************
+ * Summary:
+ *  Programs a device and returns the cost. Each started program unit costs
+ *  prog_op_ns. On NOR devices a program can only move bits away from the
+ *  erased value.
+ *
+ ******************************************************************************/
+static uint64_t flash_sim_program(flash_sim_dev_t *dev, uint32_t off, const void *src,
+                                  uint32_t len, flash_sim_stats_t *stats)
+{
+    const uint8_t *data = (const uint8_t *)src;
+    uint32_t units;
+
+    flash_sim_wait(dev);
+    flash_sim_count_op(dev, false, off, data, len);
+
+    if (dev->row_write)
+    {
+        /* A row write erases the rows it programs */
+        flash_sim_wear(dev, off, len);
+        memcpy(&dev->mem[off], data, len);
+    }
+    else
+    {
+        for (uint32_t i = 0U; i < len; i++)
+        {
+            if (0U == dev->erased_val)
+            {
+                dev->mem[off + i] |= data[i];
+            }
+            else
+            {
+                dev->mem[off + i] &= data[i];
+            }
+        }
+    }
+
+    units = ((off % dev->prog_size) + len + dev->prog_size - 1U) / dev->prog_size;
+
+    if (NULL != stats)
+    {
+        stats->writes++;
+        stats->write_bytes += len;
+    }
+
+    return (uint64_t)dev->timing.prog_op_ns * units;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_write
+ ******************************************************************************
+ * Summary:
+ *  Programs a device and waits for completion.
+ *
+ ******************************************************************************/
+int flash_sim_write(flash_sim_dev_t *dev, uint32_t off, const void *src,
+                    uint32_t len, flash_sim_stats_t *stats)
+{
+    if (!flash_sim_in_range(dev, off, len))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    flash_sim_account(stats, flash_sim_program(dev, off, src, len, stats));
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_start_write
+ ******************************************************************************
+ * Summary:
+ *  Starts programming a device like a non-blocking flash driver call. The
+ *  content changes at once, the time is spent by the next access to the
+ *  device or by flash_sim_wait().
+ *
+ ******************************************************************************/
+int flash_sim_start_write(flash_sim_dev_t *dev, uint32_t off, const void *src,
+                          uint32_t len, flash_sim_stats_t *stats)
+{
+    if (!flash_sim_in_range(dev, off, len))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    flash_sim_busy_account(dev, stats, flash_sim_program(dev, off, src, len, stats));
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_clear
+ ******************************************************************************
+ * Summary:
+ *  Erases whole sectors of a device and returns the cost.
+ *
+ ******************************************************************************/
+static uint64_t flash_sim_clear(flash_sim_dev_t *dev, uint32_t off, uint32_t len,
+                                flash_sim_stats_t *stats)
+{
+    uint32_t sectors;
+
+    flash_sim_wait(dev);
+    flash_sim_count_op(dev, true, off, NULL, len);
+
+    flash_sim_wear(dev, off, len);
+    memset(&dev->mem[off], dev->erased_val, len);
+    sectors = len / dev->erase_size;
+
+    if (NULL != stats)
+    {
+        stats->erases += sectors;
+        stats->erase_bytes += len;
+    }
+
+    return (uint64_t)dev->timing.erase_op_ns * sectors;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_erase
+ ******************************************************************************
+ * Summary:
+ *  Erases whole sectors of a device. The range must be sector aligned.
+ *
+ ******************************************************************************/
+int flash_sim_erase(flash_sim_dev_t *dev, uint32_t off, uint32_t len,
+                    flash_sim_stats_t *stats)
+{
+    if (!flash_sim_in_range(dev, off, len) ||
+        (0U != (off % dev->erase_size)) || (0U != (len % dev->erase_size)))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    flash_sim_account(stats, flash_sim_clear(dev, off, len, stats));
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_start_erase
+ ******************************************************************************
+ * Summary:
+ *  Starts erasing whole sectors of a device, see flash_sim_start_write().
+ *
+ ******************************************************************************/
+int flash_sim_start_erase(flash_sim_dev_t *dev, uint32_t off, uint32_t len,
+                          flash_sim_stats_t *stats)
+{
+    if (!flash_sim_in_range(dev, off, len) ||
+        (0U != (off % dev->erase_size)) || (0U != (len % dev->erase_size)))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    flash_sim_busy_account(dev, stats, flash_sim_clear(dev, off, len, stats));
+
+    return FLASH_SIM_OK;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_wait
+ ******************************************************************************
+ * Summary:
+ *  Waits until a started program or erase of the device has completed.
+ *
+ ******************************************************************************/
+void flash_sim_wait(flash_sim_dev_t *dev)
+{
+    if (dev->busy_until_ns > flash_sim_clock_ns)
+    {
+        flash_sim_clock_ns = dev->busy_until_ns;
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_load
+ ******************************************************************************
+ * Summary:
+ *  Copies a raw binary into the device without accounting, i.e. the way a
+ *  programmer would place it before the boot under test.
+ *
+ * Return:
+ *  Number of bytes loaded, FLASH_SIM_ERR on failure
+ *
+ ******************************************************************************/
+int flash_sim_load(flash_sim_dev_t *dev, uint32_t off, const char *path,
+                   uint32_t max_len)
+{
+    FILE *f = fopen(path, "rb");
+    struct stat st;
+    size_t len = 0U;
+
+    if ((NULL == f) || !flash_sim_in_range(dev, off, max_len) ||
+        (0 != fstat(fileno(f), &st)))
+    {
+        fprintf(stderr, "flash_sim: cannot load %s\n", path);
+        if (NULL != f)
+        {
+            fclose(f);
+        }
+        return FLASH_SIM_ERR;
+    }
+
+    /* An image padded to the slot size fills it exactly */
+    if ((uintmax_t)st.st_size > max_len)
+    {
+        fprintf(stderr, "flash_sim: %s is larger than 0x%" PRIx32 " bytes\n",
+                path, max_len);
+    }
+    else
+    {
+        len = fread(&dev->mem[off], 1U, (size_t)st.st_size, f);
+        if (len != (size_t)st.st_size)
+        {
+            fprintf(stderr, "flash_sim: cannot load %s\n", path);
+            len = 0U;
+        }
+    }
+    fclose(f);
+
+    return (0U == len) ? FLASH_SIM_ERR : (int)len;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_fill_erased
+ ******************************************************************************
+ * Summary:
+ *  Puts the whole device into the erased state without accounting.
+ *
+ ******************************************************************************/
+void flash_sim_fill_erased(flash_sim_dev_t *dev)
+{
+    memset(dev->mem, dev->erased_val, dev->size);
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_now_ns
+ ******************************************************************************
+ * Summary:
+ *  Returns the virtual time elapsed since the last flash_sim_reset_clock().
+ *
+ ******************************************************************************/
+uint64_t flash_sim_now_ns(void)
+{
+    return flash_sim_clock_ns;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_advance_ns
+ ******************************************************************************
+ * Summary:
+ *  Advances the virtual clock, e.g. to model CPU work between operations.
+ *
+ ******************************************************************************/
+void flash_sim_advance_ns(uint64_t ns)
+{
+    flash_sim_clock_ns += ns;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_reset_clock
+ ******************************************************************************/
+void flash_sim_reset_clock(void)
+{
+    flash_sim_clock_ns = 0U;
+
+    for (uint32_t i = 0U; i < FLASH_SIM_MAX_DEVICES; i++)
+    {
+        flash_sim_devs[i].busy_until_ns = 0U;
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_set_power_cut
+ ******************************************************************************
+ * Summary:
+ *  Selects the program or erase during which the power is cut, counted from
+ *  the first operation after the call. The cut happens once.
+ *
+ * Parameters:
+ *  op - 1 for the next operation, 0 to disable the cut
+ *  handler - called at the cut, must not return
+ *  arg - passed to the handler
+ *
+ ******************************************************************************/
+void flash_sim_set_power_cut(uint64_t op, flash_sim_cut_handler_t handler, void *arg)
+{
+    flash_sim_cut_op = (0U != op) ? (flash_sim_ops + op) : 0U;
+    flash_sim_cut_handler = handler;
+    flash_sim_cut_arg = arg;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_get_ops
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of program and erase operations since the start.
+ *
+ ******************************************************************************/
+uint64_t flash_sim_get_ops(void)
+{
+    return flash_sim_ops;
+}
+
+/******************************************************************************
+ * Function Name: flash_sim_parse_timing
+ ******************************************************************************
+ * Summary:
+ *  Parses "read_op,read_byte,prog,erase" (nanoseconds) into a timing set.
+ *
+ ******************************************************************************/
+int flash_sim_parse_timing(const char *spec, flash_sim_timing_t *timing)
+{
+    unsigned long v[4];
+    char tail;
+
+    if (4 != sscanf(spec, "%lu,%lu,%lu,%lu%c", &v[0], &v[1], &v[2], &v[3], &tail))
+    {
+        return FLASH_SIM_ERR;
+    }
+
+    timing->read_op_ns = (uint32_t)v[0];
+    timing->read_byte_ns = (uint32_t)v[1];
+    timing->prog_op_ns = (uint32_t)v[2];
+    timing->erase_op_ns = (uint32_t)v[3];
+
+    return FLASH_SIM_OK;
+}
+
+/* [] END OF FILE */
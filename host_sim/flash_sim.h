@@ -0,0 +1,149 @@
+/******************************************************************************
+* File Name:   flash_sim.h
+*
+* Description: File-backed flash device model used by the host build of the
+*              MCUboot Bootloader app. Each simulated device is an mmap'ed
+*              file with its own erase size, erased value and per-operation
+*              latencies. All operations advance a virtual clock so that boot
+*              and upgrade time can be estimated without hardware.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of simulated flash devices (internal + external) */
+#define FLASH_SIM_MAX_DEVICES   (2U)
+
+/* Return codes of the flash_sim_* functions */
+#define FLASH_SIM_OK            (0)
+#define FLASH_SIM_ERR           (-1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Per-operation latencies of a simulated device, in nanoseconds */
+typedef struct
+{
+    uint32_t read_op_ns;        /* Fixed cost of one read transaction */
+    uint32_t read_byte_ns;      /* Cost of every byte read */
+    uint32_t prog_op_ns;        /* Cost of programming one program unit */
+    uint32_t erase_op_ns;       /* Cost of erasing one erase sector */
+} flash_sim_timing_t;
+
+/* Operation counters, kept per flash area by the flash map layer */
+typedef struct
+{
+    uint64_t reads;
+    uint64_t read_bytes;
+    uint64_t writes;
+    uint64_t write_bytes;
+    uint64_t erases;
+    uint64_t erase_bytes;
+    uint64_t time_ns;
+} flash_sim_stats_t;
+
+/* Simulated flash device */
+typedef struct
+{
+    uint8_t  id;                /* MCUboot flash device ID */
+    bool     in_use;
+    bool     row_write;         /* true: program overwrites (PSoC 6 row write),
+                                 * false: program clears bits (NOR) */
+    uint8_t  erased_val;
+    uint32_t size;
+    uint32_t erase_size;
+    uint32_t prog_size;         /* Program unit, PLATFORM_CHUNK_SIZE */
+    flash_sim_timing_t timing;
+    uint64_t busy_until_ns;     /* End of a started program or erase */
+    uint32_t *erase_cycles;     /* Erase cycles of every erase sector, a row
+                                 * write counts as one */
+    uint8_t *mem;
+    int      fd;
+} flash_sim_dev_t;
+
+/* Called when a program or erase hits the power cut, after the first half
+ * of its range has been changed. It must not return (e.g. longjmp() back to
+ * the harness), like the CPU does not continue after a brown-out.
+ */
+typedef void (*flash_sim_cut_handler_t)(const flash_sim_dev_t *dev, bool erase,
+                                        uint32_t off, void *arg);
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int flash_sim_add_device(uint8_t id, const char *path, uint32_t size,
+                         uint32_t erase_size, uint32_t prog_size,
+                         uint8_t erased_val, bool row_write,
+                         const flash_sim_timing_t *timing);
+flash_sim_dev_t *flash_sim_get_device(uint8_t id);
+void flash_sim_close(void);
+
+int flash_sim_read(flash_sim_dev_t *dev, uint32_t off, void *dst,
+                   uint32_t len, flash_sim_stats_t *stats);
+int flash_sim_write(flash_sim_dev_t *dev, uint32_t off, const void *src,
+                    uint32_t len, flash_sim_stats_t *stats);
+int flash_sim_erase(flash_sim_dev_t *dev, uint32_t off, uint32_t len,
+                    flash_sim_stats_t *stats);
+int flash_sim_start_write(flash_sim_dev_t *dev, uint32_t off, const void *src,
+                          uint32_t len, flash_sim_stats_t *stats);
+int flash_sim_start_erase(flash_sim_dev_t *dev, uint32_t off, uint32_t len,
+                          flash_sim_stats_t *stats);
+void flash_sim_wait(flash_sim_dev_t *dev);
+
+int flash_sim_load(flash_sim_dev_t *dev, uint32_t off, const char *path,
+                   uint32_t max_len);
+void flash_sim_fill_erased(flash_sim_dev_t *dev);
+
+uint64_t flash_sim_now_ns(void);
+void flash_sim_advance_ns(uint64_t ns);
+void flash_sim_reset_clock(void);
+
+int flash_sim_parse_timing(const char *spec, flash_sim_timing_t *timing);
+
+void flash_sim_set_power_cut(uint64_t op, flash_sim_cut_handler_t handler, void *arg);
+uint64_t flash_sim_get_ops(void);
+
+#endif /* FLASH_SIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,709 @@
+/******************************************************************************
+* File Name:   fw_receiver_test.c
+*
+* Description: Host loopback test of the firmware receiver. Runs transfers over
+*              a pseudo-terminal, with a C sender and optionally
+*              scripts/fw_send.py, and checks the secondary slot.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fw_receiver.h"
+#include "fw_sha256.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SLOT_SIZE              (0x10000U)
+#define TEST_TRAILER_SIZE           (0x1000U)
+#define TEST_HEADER_SIZE            (0x400U)
+#define TEST_ERASED_VAL             (0x00U)
+
+/* Value of a slot byte that was never written by the receiver */
+#define TEST_STALE_VAL              (0xA5U)
+
+#define TEST_IMAGE_MAGIC            (0x96f3b83dU)
+#define TEST_TLV_INFO_MAGIC         (0x6907U)
+#define TEST_TLV_KEYHASH            (0x01U)
+#define TEST_TLV_SHA256             (0x10U)
+
+/* Sender behaviour */
+#define TEST_SEND_GOOD              (0U)
+#define TEST_SEND_CORRUPT           (1U)    /* Flips a payload byte */
+#define TEST_SEND_STALL             (2U)    /* Stops in the middle of the image */
+#define TEST_SEND_WRONG_SLOT        (3U)
+#define TEST_SEND_NO_HEADER         (4U)
+
+/* Exit codes, usable as CI verdicts */
+#define TEST_EXIT_OK                (0)
+#define TEST_EXIT_FAIL              (1)
+#define TEST_EXIT_USAGE             (3)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Device side: a RAM slot behind the master side of a pseudo-terminal */
+typedef struct
+{
+    int fd;
+    uint8_t *buf;                   /* Started receive */
+    uint32_t len;
+    uint32_t baud;
+    uint32_t rows;
+    uint8_t slot[TEST_SLOT_SIZE];
+} test_dev_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint8_t test_trailer_magic[16] =
+{
+    0x77U, 0xc2U, 0x95U, 0xf3U, 0x60U, 0xd2U, 0xefU, 0x7fU,
+    0x35U, 0x52U, 0x50U, 0x0fU, 0x2cU, 0xb6U, 0x79U, 0x80U
+};
+
+static uint8_t test_image[TEST_SLOT_SIZE];
+static uint32_t test_image_size;
+static test_dev_t test_dev;
+static uint32_t test_failures;
+
+/******************************************************************************
+ * Function Name: test_put16/test_put32
+ ******************************************************************************/
+static void test_put16(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8U);
+}
+
+static void test_put32(uint8_t *p, uint32_t v)
+{
+    test_put16(p, v);
+    test_put16(p + 2, v >> 16U);
+}
+
+/******************************************************************************
+ * Function Name: test_make_image
+ ******************************************************************************
+ * Summary:
+ *  Builds a padded UPGRADE slot: an MCUboot header, a pseudo-random payload,
+ *  a key hash and a SHA-256 TLV, the erased padding and the trailer magic.
+ *
+ ******************************************************************************/
+static void test_make_image(uint32_t payload_size)
+{
+    fw_sha256_t sha;
+    uint32_t seed = 0x12345678U;
+    uint32_t tlv = TEST_HEADER_SIZE + payload_size;
+
+    (void)memset(test_image, TEST_ERASED_VAL, sizeof(test_image));
+
+    test_put32(&test_image[0], TEST_IMAGE_MAGIC);
+    test_put16(&test_image[8], TEST_HEADER_SIZE);
+    test_put32(&test_image[12], payload_size);
+    test_image[20] = 2U;
+
+    for (uint32_t i = TEST_HEADER_SIZE; i < tlv; i++)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        test_image[i] = (uint8_t)(seed >> 16U);
+    }
+
+    test_put16(&test_image[tlv], TEST_TLV_INFO_MAGIC);
+    test_put16(&test_image[tlv + 2U], 4U + (2U * (4U + FW_SHA256_DIGEST_SIZE)));
+    test_put16(&test_image[tlv + 4U], TEST_TLV_KEYHASH);
+    test_put16(&test_image[tlv + 6U], FW_SHA256_DIGEST_SIZE);
+    (void)memset(&test_image[tlv + 8U], 0x5AU, FW_SHA256_DIGEST_SIZE);
+    test_put16(&test_image[tlv + 8U + FW_SHA256_DIGEST_SIZE], TEST_TLV_SHA256);
+    test_put16(&test_image[tlv + 10U + FW_SHA256_DIGEST_SIZE], FW_SHA256_DIGEST_SIZE);
+
+    fw_sha256_init(&sha);
+    fw_sha256_update(&sha, test_image, tlv);
+    fw_sha256_finish(&sha, &test_image[tlv + 12U + FW_SHA256_DIGEST_SIZE]);
+
+    test_image_size = tlv + 12U + (2U * FW_SHA256_DIGEST_SIZE);
+
+    (void)memcpy(&test_image[TEST_SLOT_SIZE - sizeof(test_trailer_magic)], test_trailer_magic,
+                 sizeof(test_trailer_magic));
+}
+
+/******************************************************************************
+ * Function Name: test_recv_start
+ ******************************************************************************/
+static int test_recv_start(void *ctx, uint8_t *buf, uint32_t len)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    dev->buf = buf;
+    dev->len = len;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_recv_wait
+ ******************************************************************************/
+static int test_recv_wait(void *ctx, uint32_t timeout_ms)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+    struct pollfd pfd = { .fd = dev->fd, .events = POLLIN };
+
+    while (0U != dev->len)
+    {
+        ssize_t n;
+
+        if (poll(&pfd, 1, (int)timeout_ms) <= 0)
+        {
+            dev->len = 0U;
+            return -1;
+        }
+
+        n = read(dev->fd, dev->buf, dev->len);
+        if (n <= 0)
+        {
+            dev->len = 0U;
+            return -1;
+        }
+
+        dev->buf += n;
+        dev->len -= (uint32_t)n;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_recv_abort
+ ******************************************************************************/
+static void test_recv_abort(void *ctx)
+{
+    ((test_dev_t *)ctx)->len = 0U;
+}
+
+/******************************************************************************
+ * Function Name: test_send
+ ******************************************************************************/
+static int test_send(void *ctx, const uint8_t *buf, uint32_t len)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    return (write(dev->fd, buf, len) == (ssize_t)len) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: test_set_baud
+ ******************************************************************************/
+static int test_set_baud(void *ctx, uint32_t baud)
+{
+    ((test_dev_t *)ctx)->baud = baud;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_program_start
+ ******************************************************************************/
+static int test_program_start(void *ctx, uint32_t off, const uint8_t *row)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    if ((0U != (off % FW_RECEIVER_ROW_SIZE)) || (off >= TEST_SLOT_SIZE))
+    {
+        return -1;
+    }
+
+    (void)memcpy(&dev->slot[off], row, FW_RECEIVER_ROW_SIZE);
+    dev->rows++;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_program_wait
+ ******************************************************************************/
+static int test_program_wait(void *ctx)
+{
+    (void)ctx;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_read
+ ******************************************************************************/
+static int test_read(void *ctx, uint32_t off, uint8_t *buf, uint32_t len)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    if ((off > TEST_SLOT_SIZE) || (len > (TEST_SLOT_SIZE - off)))
+    {
+        return -1;
+    }
+
+    (void)memcpy(buf, &dev->slot[off], len);
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_now_ms
+ ******************************************************************************/
+static uint32_t test_now_ms(void *ctx)
+{
+    struct timespec ts;
+
+    (void)ctx;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+}
+
+/******************************************************************************
+ * Function Name: test_wait_reply
+ ******************************************************************************
+ * Summary:
+ *  Sender side: returns 0 for an ACK, the error code of a NAK, or -1.
+ *
+ ******************************************************************************/
+static int test_wait_reply(int fd)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    uint8_t reply[2];
+
+    for (uint32_t i = 0U; i < 2U; i++)
+    {
+        if ((poll(&pfd, 1, 5000) <= 0) || (1 != read(fd, &reply[i], 1U)))
+        {
+            return -1;
+        }
+        if (FW_RECEIVER_ACK == reply[0])
+        {
+            return 0;
+        }
+        if (FW_RECEIVER_NAK != reply[0])
+        {
+            return -1;
+        }
+    }
+
+    return reply[1];
+}
+
+/******************************************************************************
+ * Function Name: test_sender
+ ******************************************************************************
+ * Summary:
+ *  Sender side, same protocol as scripts/fw_send.py. Runs in a child
+ *  process and exits with the result of test_wait_reply().
+ *
+ ******************************************************************************/
+static void test_sender(int fd, uint32_t mode)
+{
+    static uint8_t image[TEST_SLOT_SIZE];
+    uint8_t frame[sizeof(fw_receiver_start_t)];
+    uint32_t pending = 0U;
+    int rc = -1;
+
+    (void)memcpy(image, test_image, sizeof(image));
+    if (TEST_SEND_CORRUPT == mode)
+    {
+        image[TEST_HEADER_SIZE + 100U] ^= 0x01U;
+    }
+    else if (TEST_SEND_NO_HEADER == mode)
+    {
+        image[0] ^= 0xFFU;
+    }
+
+    test_put32(&frame[0], FW_RECEIVER_MAGIC);
+    test_put32(&frame[4], (TEST_SEND_WRONG_SLOT == mode) ? (TEST_SLOT_SIZE / 2U) : TEST_SLOT_SIZE);
+    test_put32(&frame[8], test_image_size);
+    test_put32(&frame[12], TEST_TRAILER_SIZE);
+    test_put32(&frame[16], 921600U);
+
+    if ((write(fd, frame, sizeof(frame)) != (ssize_t)sizeof(frame)) ||
+        (0 != (rc = test_wait_reply(fd))))
+    {
+        _exit(rc);
+    }
+
+    for (uint32_t pos = 0U; pos < test_image_size; pos += FW_RECEIVER_BLOCK_SIZE)
+    {
+        uint32_t len = test_image_size - pos;
+
+        if (len > FW_RECEIVER_BLOCK_SIZE)
+        {
+            len = FW_RECEIVER_BLOCK_SIZE;
+        }
+
+        if ((TEST_SEND_STALL == mode) && (pos >= (test_image_size / 2U)))
+        {
+            pause();
+        }
+
+        if (2U == pending)
+        {
+            if (0 != (rc = test_wait_reply(fd)))
+            {
+                _exit(rc);
+            }
+            pending--;
+        }
+
+        if (write(fd, &image[pos], len) != (ssize_t)len)
+        {
+            _exit(-1);
+        }
+        pending++;
+    }
+
+    /* Outstanding blocks and the hash check */
+    for (pending++; 0U != pending; pending--)
+    {
+        if (0 != (rc = test_wait_reply(fd)))
+        {
+            _exit(rc);
+        }
+    }
+
+    for (uint32_t pos = 0U; pos < TEST_TRAILER_SIZE; pos += FW_RECEIVER_BLOCK_SIZE)
+    {
+        uint32_t len = TEST_TRAILER_SIZE - pos;
+
+        if (len > FW_RECEIVER_BLOCK_SIZE)
+        {
+            len = FW_RECEIVER_BLOCK_SIZE;
+        }
+
+        if ((write(fd, &image[(TEST_SLOT_SIZE - TEST_TRAILER_SIZE) + pos], len) != (ssize_t)len) ||
+            (0 != (rc = test_wait_reply(fd))))
+        {
+            _exit(rc);
+        }
+    }
+
+    _exit(0);
+}
+
+/******************************************************************************
+ * Function Name: test_slot_matches
+ ******************************************************************************
+ * Summary:
+ *  Checks the rows of the image and the trailer, and that the padding in
+ *  between was not written.
+ *
+ ******************************************************************************/
+static bool test_slot_matches(void)
+{
+    uint32_t image_end = (test_image_size + FW_RECEIVER_ROW_SIZE - 1U) &
+                         ~(FW_RECEIVER_ROW_SIZE - 1U);
+    uint32_t trailer = TEST_SLOT_SIZE - TEST_TRAILER_SIZE;
+
+    if ((0 != memcmp(test_dev.slot, test_image, image_end)) ||
+        (0 != memcmp(&test_dev.slot[trailer], &test_image[trailer], TEST_TRAILER_SIZE)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = image_end; i < trailer; i++)
+    {
+        if (TEST_STALE_VAL != test_dev.slot[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: test_pending
+ ******************************************************************************
+ * Summary:
+ *  Returns true if the slot trailer holds the magic of a pending upgrade.
+ *
+ ******************************************************************************/
+static bool test_pending(void)
+{
+    return 0 == memcmp(&test_dev.slot[TEST_SLOT_SIZE - sizeof(test_trailer_magic)],
+                       test_trailer_magic, sizeof(test_trailer_magic));
+}
+
+/******************************************************************************
+ * Function Name: test_drain
+ ******************************************************************************
+ * Summary:
+ *  Drops the bytes left in both directions by a failed transfer.
+ *
+ ******************************************************************************/
+static void test_drain(int master, int slave)
+{
+    struct pollfd pfd[2] = { { .fd = master, .events = POLLIN },
+                             { .fd = slave, .events = POLLIN } };
+    uint8_t buf[256];
+
+    while (poll(pfd, 2, 100) > 0)
+    {
+        for (uint32_t i = 0U; i < 2U; i++)
+        {
+            if (0 != (pfd[i].revents & POLLIN))
+            {
+                (void)read(pfd[i].fd, buf, sizeof(buf));
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: test_transfer
+ ******************************************************************************
+ * Summary:
+ *  Runs the receiver against a sender in a child process: the C sender for
+ *  the given mode, or the command line cmd with the slave path and image.
+ *
+ ******************************************************************************/
+static void test_transfer(const char *name, int master, int slave, const char *slave_path,
+                          uint32_t mode, const char *cmd, int expected, bool pending)
+{
+    static const fw_receiver_port_t port =
+    {
+        .recv_start = test_recv_start,
+        .recv_wait = test_recv_wait,
+        .recv_abort = test_recv_abort,
+        .send = test_send,
+        .set_baud = test_set_baud,
+        .program_start = test_program_start,
+        .program_wait = test_program_wait,
+        .read = test_read,
+        .now_ms = test_now_ms,
+        .slot_size = TEST_SLOT_SIZE,
+        .baud = 115200U,
+        .erased_val = TEST_ERASED_VAL,
+        .ctx = &test_dev
+    };
+    fw_receiver_stats_t stats = { 0U, 0U, 0U };
+    char shell[1024];
+    pid_t pid;
+    int status = 0;
+    int sent;
+    int rc;
+
+    /* A pending upgrade from an earlier transfer */
+    (void)memset(test_dev.slot, TEST_STALE_VAL, sizeof(test_dev.slot));
+    (void)memcpy(&test_dev.slot[TEST_SLOT_SIZE - sizeof(test_trailer_magic)], test_trailer_magic,
+                 sizeof(test_trailer_magic));
+    test_dev.fd = master;
+    test_dev.rows = 0U;
+    test_dev.baud = port.baud;
+
+    pid = fork();
+    if (0 == pid)
+    {
+        if (NULL == cmd)
+        {
+            test_sender(slave, mode);
+        }
+        (void)snprintf(shell, sizeof(shell), "%s -p %s -i build/fw_receiver_test.bin -B 230400",
+                       cmd, slave_path);
+        execl("/bin/sh", "sh", "-c", shell, (char *)NULL);
+        _exit(127);
+    }
+
+    rc = fw_receiver_run(&port, &stats);
+    if (TEST_SEND_STALL == mode)
+    {
+        (void)kill(pid, SIGKILL);
+    }
+    (void)waitpid(pid, &status, 0);
+    sent = WIFEXITED(status) ? (int)(int8_t)WEXITSTATUS(status) : -1;
+
+    if ((rc != expected) || ((NULL == cmd) && (TEST_SEND_STALL != mode) && (sent != rc)) ||
+        ((NULL != cmd) && (0 != sent)) || (test_pending() != pending) ||
+        (port.baud != test_dev.baud) || ((FW_RECEIVER_OK == rc) && !test_slot_matches()))
+    {
+        test_failures++;
+        printf("FAIL %-28s rc %d, sender %d, pending %d\n", name, rc, sent, test_pending());
+    }
+    else
+    {
+        printf("PASS %-28s rc %d, %6lu bytes received, %3u rows written\n", name, rc,
+               (unsigned long)stats.bytes, (unsigned int)test_dev.rows);
+    }
+
+    test_drain(master, slave);
+}
+
+/******************************************************************************
+ * Function Name: test_sha256
+ ******************************************************************************/
+static void test_sha256(void)
+{
+    static const uint8_t abc_digest[FW_SHA256_DIGEST_SIZE] =
+    {
+        0xbaU, 0x78U, 0x16U, 0xbfU, 0x8fU, 0x01U, 0xcfU, 0xeaU, 0x41U, 0x41U, 0x40U, 0xdeU,
+        0x5dU, 0xaeU, 0x22U, 0x23U, 0xb0U, 0x03U, 0x61U, 0xa3U, 0x96U, 0x17U, 0x7aU, 0x9cU,
+        0xb4U, 0x10U, 0xffU, 0x61U, 0xf2U, 0x00U, 0x15U, 0xadU
+    };
+    uint8_t digest[FW_SHA256_DIGEST_SIZE];
+    fw_sha256_t sha;
+
+    fw_sha256_init(&sha);
+    fw_sha256_update(&sha, (const uint8_t *)"a", 1U);
+    fw_sha256_update(&sha, (const uint8_t *)"bc", 2U);
+    fw_sha256_finish(&sha, digest);
+
+    if (0 != memcmp(digest, abc_digest, sizeof(digest)))
+    {
+        test_failures++;
+        printf("FAIL %-28s\n", "sha256 \"abc\"");
+    }
+    else
+    {
+        printf("PASS %-28s\n", "sha256 \"abc\"");
+    }
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************
+ * Summary:
+ *  Host loopback test of the firmware receiver over a pseudo-terminal. With
+ *  -x, the transfers are also run with the given sender command, e.g.
+ *  -x "python3 ../scripts/fw_send.py".
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char *cmd = NULL;
+    struct termios tio;
+    const char *slave_path;
+    FILE *bin;
+    int master;
+    int slave;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "x:")))
+    {
+        if ('x' == opt)
+        {
+            cmd = optarg;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-x \"<sender command>\"]\n", argv[0]);
+            return TEST_EXIT_USAGE;
+        }
+    }
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (0 != grantpt(master)) || (0 != unlockpt(master)) ||
+        (NULL == (slave_path = ptsname(master))))
+    {
+        perror("posix_openpt");
+        return TEST_EXIT_FAIL;
+    }
+
+    /* Kept open, so the master does not see a hangup between the senders */
+    slave = open(slave_path, O_RDWR | O_NOCTTY);
+    if ((slave < 0) || (0 != tcgetattr(slave, &tio)))
+    {
+        perror(slave_path);
+        return TEST_EXIT_FAIL;
+    }
+    cfmakeraw(&tio);
+    (void)tcsetattr(slave, TCSANOW, &tio);
+    (void)tcgetattr(master, &tio);
+    cfmakeraw(&tio);
+    (void)tcsetattr(master, TCSANOW, &tio);
+
+    test_sha256();
+
+    test_make_image(0x8000U + 123U);
+    test_transfer("image", master, slave, slave_path, TEST_SEND_GOOD, NULL,
+                  FW_RECEIVER_OK, true);
+    test_transfer("corrupt payload", master, slave, slave_path, TEST_SEND_CORRUPT, NULL,
+                  FW_RECEIVER_ERR_HASH, false);
+    test_transfer("sender stalls", master, slave, slave_path, TEST_SEND_STALL, NULL,
+                  FW_RECEIVER_ERR_TIMEOUT, false);
+    test_transfer("wrong slot size", master, slave, slave_path, TEST_SEND_WRONG_SLOT, NULL,
+                  FW_RECEIVER_ERR_SIZE, true);
+    test_transfer("no image header", master, slave, slave_path, TEST_SEND_NO_HEADER, NULL,
+                  FW_RECEIVER_ERR_HEADER, false);
+
+    /* Largest image below the trailer, ending on a block boundary */
+    test_make_image(TEST_SLOT_SIZE - TEST_TRAILER_SIZE - TEST_HEADER_SIZE -
+                    (12U + (2U * FW_SHA256_DIGEST_SIZE)));
+    test_transfer("full slot", master, slave, slave_path, TEST_SEND_GOOD, NULL,
+                  FW_RECEIVER_OK, true);
+
+    if (NULL != cmd)
+    {
+        test_make_image(0x6000U + 7U);
+        bin = fopen("build/fw_receiver_test.bin", "wb");
+        if ((NULL == bin) || (1U != fwrite(test_image, sizeof(test_image), 1U, bin)) ||
+            (0 != fclose(bin)))
+        {
+            perror("build/fw_receiver_test.bin");
+            return TEST_EXIT_FAIL;
+        }
+        test_transfer("sender command", master, slave, slave_path, TEST_SEND_GOOD, cmd,
+                      FW_RECEIVER_OK, true);
+    }
+
+    (void)close(slave);
+    (void)close(master);
+
+    printf("%s: %u failure(s)\n", (0U == test_failures) ? "PASSED" : "FAILED",
+           (unsigned int)test_failures);
+
+    return (0U == test_failures) ? TEST_EXIT_OK : TEST_EXIT_FAIL;
+}
+
+/* [] END OF FILE */
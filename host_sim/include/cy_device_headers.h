@@ -0,0 +1,7 @@
+/* Host build stand-in for the PDL header of the same name, see sim_platform.h */
+#ifndef SIM_CY_DEVICE_HEADERS_H
+#define SIM_CY_DEVICE_HEADERS_H
+
+#include "sim_platform.h"
+
+#endif /* SIM_CY_DEVICE_HEADERS_H */
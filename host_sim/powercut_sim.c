@@ -0,0 +1,681 @@
+/******************************************************************************
+* File Name:   powercut_sim.c
+*
+* Description: Host power-loss harness of the swap upgrade. It cuts the power
+*              of the simulated flash at every Nth program or erase of the
+*              upgrade, boots again and checks that the upgrade recovers,
+*              reporting the recovery boot time and the extra flash writes of
+*              every cut point.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* MCUboot header files */
+#include "memorymap.h"
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/fault_injection_hardening.h"
+
+#include "flash_sim.h"
+#include "sim_flash_map.h"
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+#include "flash_cache.h"
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same defaults as boot_sim */
+#define CUT_INT_TIMING_DEFAULT      { 0U, 10U, 16000000U, 11000000U }
+#define CUT_EXT_TIMING_DEFAULT      { 1000U, 40U, 700000U, 520000000U }
+
+#define CUT_DEFAULT_FLASH_FILE      "powercut_flash.bin"
+
+/* Exit codes, usable as CI verdicts */
+#define CUT_EXIT_OK                 (0)
+#define CUT_EXIT_FAIL               (1)
+#define CUT_EXIT_USAGE              (3)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    const char *flash_file;
+    const char *primary;
+    const char *secondary;
+    const char *csv_file;
+    uint64_t step;
+    uint64_t first;
+    uint64_t last;
+    uint64_t max_us;
+    flash_sim_timing_t int_timing;
+    flash_sim_timing_t ext_timing;
+} cut_params_t;
+
+/* Where the power was cut */
+typedef struct
+{
+    uint8_t  dev_id;
+    bool     erase;
+    uint32_t off;
+} cut_point_t;
+
+/* Flash contents of one device before the upgrade */
+typedef struct
+{
+    flash_sim_dev_t *dev;
+    uint8_t *mem;
+} cut_snapshot_t;
+
+/* Outcome of the boot without a power cut */
+typedef struct
+{
+    uint64_t ops;
+    flash_sim_stats_t stats;
+    uint32_t image_off;
+    struct image_version version;
+    uint8_t *primary;
+    uint8_t *secondary;
+    uint32_t primary_len;
+    uint32_t secondary_len;
+} cut_reference_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static jmp_buf cut_env;
+static cut_point_t cut_point;
+static cut_snapshot_t cut_snapshots[FLASH_SIM_MAX_DEVICES];
+static uint32_t cut_snapshot_count;
+
+/******************************************************************************
+ * Function Name: usage
+ ******************************************************************************/
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "USAGE: %s -p BIN -s BIN [options]\n\n"
+        "OPTIONS:\n"
+        "  -f, --flash=FILE        backing file of the internal flash (default %s)\n"
+        "  -p, --primary=BIN       signed image to place into the primary slot\n"
+        "  -s, --secondary=BIN     signed upgrade image (imgtool --pad) to place\n"
+        "                          into the secondary slot\n"
+        "  -e, --step=N            cut at every Nth program or erase (default 1)\n"
+        "  -F, --first=N           first operation to cut (default 1)\n"
+        "  -L, --last=N            last operation to cut (default: all)\n"
+        "  -t, --timing-int=SPEC   internal flash latencies, ns\n"
+        "  -T, --timing-ext=SPEC   external flash latencies, ns\n"
+        "                          SPEC = read_op,read_byte,program,erase\n"
+        "  -c, --csv=FILE          write one row per power cut to FILE\n"
+        "  -m, --max-us=US         fail if any recovery boot takes longer than US\n"
+        "  -h, --help              display this information\n",
+        prog, CUT_DEFAULT_FLASH_FILE);
+}
+
+/******************************************************************************
+ * Function Name: parse_args
+ ******************************************************************************/
+static int parse_args(int argc, char *argv[], cut_params_t *p)
+{
+    static const struct option opts[] =
+    {
+        { "flash",      required_argument, NULL, 'f' },
+        { "primary",    required_argument, NULL, 'p' },
+        { "secondary",  required_argument, NULL, 's' },
+        { "step",       required_argument, NULL, 'e' },
+        { "first",      required_argument, NULL, 'F' },
+        { "last",       required_argument, NULL, 'L' },
+        { "timing-int", required_argument, NULL, 't' },
+        { "timing-ext", required_argument, NULL, 'T' },
+        { "csv",        required_argument, NULL, 'c' },
+        { "max-us",     required_argument, NULL, 'm' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    int opt;
+
+    while (-1 != (opt = getopt_long(argc, argv, "f:p:s:e:F:L:t:T:c:m:h", opts, NULL)))
+    {
+        switch (opt)
+        {
+            case 'f': p->flash_file = optarg; break;
+            case 'p': p->primary = optarg; break;
+            case 's': p->secondary = optarg; break;
+            case 'e': p->step = strtoull(optarg, NULL, 0); break;
+            case 'F': p->first = strtoull(optarg, NULL, 0); break;
+            case 'L': p->last = strtoull(optarg, NULL, 0); break;
+            case 'c': p->csv_file = optarg; break;
+            case 'm': p->max_us = strtoull(optarg, NULL, 0); break;
+            case 't':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->int_timing))
+                {
+                    return -1;
+                }
+                break;
+            case 'T':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->ext_timing))
+                {
+                    return -1;
+                }
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    return ((NULL != p->primary) && (NULL != p->secondary) &&
+            (p->step > 0U) && (p->first > 0U)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: cut_handler
+ ******************************************************************************
+ * Summary:
+ *  Power cut: abandons boot_go() the way a reset does. MCUboot's own
+ *  simulator unwinds the same way, boot_go() keeps no state across calls
+ *  that flash does not hold.
+ *
+ ******************************************************************************/
+static void cut_handler(const flash_sim_dev_t *dev, bool erase, uint32_t off, void *arg)
+{
+    (void)arg;
+
+    cut_point.dev_id = dev->id;
+    cut_point.erase = erase;
+    cut_point.off = off;
+
+    longjmp(cut_env, 1);
+}
+
+/******************************************************************************
+ * Function Name: snapshot_take
+ ******************************************************************************
+ * Summary:
+ *  Copies every simulated device, i.e. the state before the upgrade.
+ *
+ * Return:
+ *  0 on success, -1 if out of memory
+ *
+ ******************************************************************************/
+static int snapshot_take(void)
+{
+    cut_snapshot_count = 0U;
+
+    for (uint32_t i = 0U; NULL != boot_area_descs[i]; i++)
+    {
+        flash_sim_dev_t *dev = flash_sim_get_device(boot_area_descs[i]->fa_device_id);
+        bool known = false;
+
+        for (uint32_t j = 0U; j < cut_snapshot_count; j++)
+        {
+            known = known || (cut_snapshots[j].dev == dev);
+        }
+
+        if ((NULL != dev) && !known && (cut_snapshot_count < FLASH_SIM_MAX_DEVICES))
+        {
+            cut_snapshot_t *snap = &cut_snapshots[cut_snapshot_count];
+
+            snap->mem = malloc(dev->size);
+            if (NULL == snap->mem)
+            {
+                return -1;
+            }
+            memcpy(snap->mem, dev->mem, dev->size);
+            snap->dev = dev;
+            cut_snapshot_count++;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: snapshot_restore
+ ******************************************************************************/
+static void snapshot_restore(void)
+{
+    for (uint32_t i = 0U; i < cut_snapshot_count; i++)
+    {
+        memcpy(cut_snapshots[i].dev->mem, cut_snapshots[i].mem, cut_snapshots[i].dev->size);
+        cut_snapshots[i].dev->busy_until_ns = 0U;
+    }
+}
+
+/******************************************************************************
+ * Function Name: slot_mem
+ ******************************************************************************
+ * Summary:
+ *  Returns the simulated memory of an image slot.
+ *
+ ******************************************************************************/
+static const uint8_t *slot_mem(uint8_t fa_id, uint32_t *size)
+{
+    const struct flash_area *fa = NULL;
+    flash_sim_dev_t *dev = NULL;
+
+    if (0 == flash_area_open(fa_id, &fa))
+    {
+        dev = flash_sim_get_device(fa->fa_device_id);
+    }
+
+    if (NULL == dev)
+    {
+        *size = 0U;
+        return NULL;
+    }
+
+    *size = fa->fa_size;
+    return &dev->mem[fa->fa_off];
+}
+
+/******************************************************************************
+ * Function Name: image_len
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of the image in a slot including its TLVs, so that the
+ *  trailer, whose contents legitimately depend on the cut point, is not
+ *  compared.
+ *
+ ******************************************************************************/
+static uint32_t image_len(const uint8_t *slot, uint32_t size)
+{
+    struct image_header hdr;
+    struct image_tlv_info info;
+    uint32_t len;
+
+    memcpy(&hdr, slot, sizeof(hdr));
+    if ((IMAGE_MAGIC != hdr.ih_magic) ||
+        ((uint64_t)hdr.ih_hdr_size + hdr.ih_img_size + hdr.ih_protect_tlv_size +
+         sizeof(info) > size))
+    {
+        return 0U;
+    }
+
+    len = hdr.ih_hdr_size + hdr.ih_img_size + hdr.ih_protect_tlv_size;
+    memcpy(&info, &slot[len], sizeof(info));
+
+    if ((IMAGE_TLV_INFO_MAGIC != info.it_magic) || ((uint64_t)len + info.it_tlv_tot > size))
+    {
+        return 0U;
+    }
+
+    return len + info.it_tlv_tot;
+}
+
+/******************************************************************************
+ * Function Name: run_boot
+ ******************************************************************************
+ * Summary:
+ *  Runs one boot_go() with fresh counters. Returns false if the power was
+ *  cut during it.
+ *
+ ******************************************************************************/
+static bool run_boot(struct boot_rsp *rsp, fih_int *fih_status, flash_sim_stats_t *stats)
+{
+    /* Static: not clobbered by longjmp() */
+    static volatile bool cut;
+
+    memset(rsp, 0, sizeof(*rsp));
+    *fih_status = FIH_FAILURE;
+    cut = false;
+    sim_flash_map_reset_stats();
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+    /* The cache is in RAM, every boot starts with it empty */
+    flash_cache_reset();
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+
+    if (0 == setjmp(cut_env))
+    {
+        FIH_CALL(boot_go, *fih_status, rsp);
+    }
+    else
+    {
+        cut = true;
+    }
+
+    flash_sim_set_power_cut(0U, NULL, NULL);
+    sim_flash_map_total(stats);
+
+    return !cut;
+}
+
+/******************************************************************************
+ * Function Name: check_result
+ ******************************************************************************
+ * Summary:
+ *  Compares the outcome of a boot with the boot without a power cut: the
+ *  same image must be booted and both slots must hold the same images.
+ *
+ * Return:
+ *  NULL if it matches, otherwise the reason
+ *
+ ******************************************************************************/
+static const char *check_result(fih_int fih_status, const struct boot_rsp *rsp,
+                                const cut_reference_t *ref)
+{
+    const uint8_t *primary;
+    const uint8_t *secondary;
+    uint32_t size;
+
+    if (FIH_TRUE != fih_eq(fih_status, FIH_SUCCESS))
+    {
+        return "no_boot";
+    }
+
+    if ((rsp->br_image_off != ref->image_off) ||
+        (0 != memcmp(&rsp->br_hdr->ih_ver, &ref->version, sizeof(ref->version))))
+    {
+        return "wrong_image";
+    }
+
+    primary = slot_mem(FLASH_AREA_IMAGE_PRIMARY(0U), &size);
+    secondary = slot_mem(FLASH_AREA_IMAGE_SECONDARY(0U), &size);
+
+    if ((NULL == primary) || (0 != memcmp(primary, ref->primary, ref->primary_len)))
+    {
+        return "primary_corrupt";
+    }
+
+    if ((NULL == secondary) || (0 != memcmp(secondary, ref->secondary, ref->secondary_len)))
+    {
+        return "secondary_corrupt";
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: run_reference
+ ******************************************************************************
+ * Summary:
+ *  Runs the upgrade without a power cut and keeps what every recovery must
+ *  end up with.
+ *
+ * Return:
+ *  0 on success, -1 if the upgrade did not boot
+ *
+ ******************************************************************************/
+static int run_reference(cut_reference_t *ref)
+{
+    struct boot_rsp rsp;
+    fih_int fih_status;
+    const uint8_t *slot;
+    uint32_t size;
+    uint64_t ops = flash_sim_get_ops();
+
+    (void)run_boot(&rsp, &fih_status, &ref->stats);
+    ref->ops = flash_sim_get_ops() - ops;
+
+    if (FIH_TRUE != fih_eq(fih_status, FIH_SUCCESS))
+    {
+        fprintf(stderr, "The upgrade does not boot without a power cut\n");
+        return -1;
+    }
+
+    ref->image_off = rsp.br_image_off;
+    ref->version = rsp.br_hdr->ih_ver;
+
+    slot = slot_mem(FLASH_AREA_IMAGE_PRIMARY(0U), &size);
+    ref->primary_len = image_len(slot, size);
+    ref->primary = malloc(size);
+    if (NULL != ref->primary)
+    {
+        memcpy(ref->primary, slot, size);
+    }
+
+    slot = slot_mem(FLASH_AREA_IMAGE_SECONDARY(0U), &size);
+    ref->secondary_len = image_len(slot, size);
+    ref->secondary = malloc(size);
+    if (NULL != ref->secondary)
+    {
+        memcpy(ref->secondary, slot, size);
+    }
+
+    return ((NULL != ref->primary) && (NULL != ref->secondary)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: cut_area
+ ******************************************************************************
+ * Summary:
+ *  Returns the ID of the flash area that holds the cut operation.
+ *
+ ******************************************************************************/
+static int cut_area(const cut_point_t *cp)
+{
+    for (uint32_t i = 0U; NULL != boot_area_descs[i]; i++)
+    {
+        const struct flash_area *fa = boot_area_descs[i];
+
+        if ((fa->fa_device_id == cp->dev_id) && (cp->off >= fa->fa_off) &&
+            (cp->off < fa->fa_off + fa->fa_size))
+        {
+            return (int)fa->fa_id;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************
+ * Summary:
+ *  Runs the upgrade once without a power cut, then once per cut point:
+ *  restores the flash, cuts the power at the selected program or erase,
+ *  and boots again. Every recovery must boot the upgraded image with both
+ *  slots holding the same images as without a power cut.
+ *
+ * Return:
+ *  CUT_EXIT_OK if every recovery succeeded within the time budget
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    cut_params_t params =
+    {
+        .flash_file = CUT_DEFAULT_FLASH_FILE,
+        .step = 1U,
+        .first = 1U,
+        .int_timing = CUT_INT_TIMING_DEFAULT,
+        .ext_timing = CUT_EXT_TIMING_DEFAULT,
+    };
+    cut_reference_t ref;
+    FILE *csv = NULL;
+    uint64_t worst_ns = 0U;
+    uint64_t worst_op = 0U;
+    uint64_t worst_extra = 0U;
+    uint32_t cuts = 0U;
+    uint32_t failures = 0U;
+    int exit_code = CUT_EXIT_OK;
+
+    memset(&ref, 0, sizeof(ref));
+
+    if (0 != parse_args(argc, argv, &params))
+    {
+        usage(argv[0]);
+        return CUT_EXIT_USAGE;
+    }
+
+    if (0 != sim_flash_map_init(params.flash_file, &params.int_timing,
+                                &params.ext_timing))
+    {
+        fprintf(stderr, "Cannot set up the simulated flash\n");
+        return CUT_EXIT_USAGE;
+    }
+
+    for (uint32_t i = 0U; NULL != boot_area_descs[i]; i++)
+    {
+        flash_sim_dev_t *dev = flash_sim_get_device(boot_area_descs[i]->fa_device_id);
+
+        if (NULL != dev)
+        {
+            flash_sim_fill_erased(dev);
+        }
+    }
+
+    if ((0 != sim_flash_map_load(FLASH_AREA_IMAGE_PRIMARY(0U), params.primary)) ||
+        (0 != sim_flash_map_load(FLASH_AREA_IMAGE_SECONDARY(0U), params.secondary)) ||
+        (0 != snapshot_take()) || (0 != run_reference(&ref)))
+    {
+        flash_sim_close();
+        return CUT_EXIT_USAGE;
+    }
+
+    printf("Upgrade without power cut: %" PRIu64 " program/erase operations, "
+           "%" PRIu64 " writes, %" PRIu64 " erases, %" PRIu64 ".%03" PRIu64 " ms\n",
+           ref.ops, ref.stats.writes, ref.stats.erases,
+           ref.stats.time_ns / 1000000U, (ref.stats.time_ns / 1000U) % 1000U);
+
+    if ((0U == ref.primary_len) || (0U == ref.secondary_len))
+    {
+        printf("Warning: no image in the secondary slot after the upgrade, "
+               "the slots are not compared\n");
+    }
+
+    if (NULL != params.csv_file)
+    {
+        csv = fopen(params.csv_file, "w");
+        if (NULL == csv)
+        {
+            fprintf(stderr, "Cannot open %s\n", params.csv_file);
+            flash_sim_close();
+            return CUT_EXIT_USAGE;
+        }
+        fprintf(csv, "op,area,offset,kind,cut_us,recovery_us,recovery_writes,"
+                     "recovery_write_bytes,recovery_erases,extra_writes,"
+                     "extra_erases,result\n");
+    }
+
+    for (uint64_t op = params.first;
+         (op <= ref.ops) && ((0U == params.last) || (op <= params.last));
+         op += params.step)
+    {
+        struct boot_rsp rsp;
+        fih_int fih_status;
+        flash_sim_stats_t before;
+        flash_sim_stats_t after;
+        const char *failure;
+        uint64_t extra_writes;
+        uint64_t extra_erases;
+
+        snapshot_restore();
+        flash_sim_set_power_cut(op, cut_handler, NULL);
+
+        if (run_boot(&rsp, &fih_status, &before))
+        {
+            fprintf(stderr, "Operation %" PRIu64 " was not reached\n", op);
+            exit_code = CUT_EXIT_FAIL;
+            break;
+        }
+
+        (void)run_boot(&rsp, &fih_status, &after);
+        failure = check_result(fih_status, &rsp, &ref);
+
+        extra_writes = before.writes + after.writes;
+        extra_writes = (extra_writes > ref.stats.writes) ? (extra_writes - ref.stats.writes) : 0U;
+        extra_erases = before.erases + after.erases;
+        extra_erases = (extra_erases > ref.stats.erases) ? (extra_erases - ref.stats.erases) : 0U;
+
+        if (NULL != csv)
+        {
+            fprintf(csv, "%" PRIu64 ",%d,%#" PRIx32 ",%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64
+                    ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%s\n",
+                    op, cut_area(&cut_point), cut_point.off,
+                    cut_point.erase ? "erase" : "write", before.time_ns / 1000U,
+                    after.time_ns / 1000U, after.writes, after.write_bytes,
+                    after.erases, extra_writes, extra_erases,
+                    (NULL == failure) ? "ok" : failure);
+        }
+
+        if (NULL != failure)
+        {
+            printf("Cut at operation %" PRIu64 " (%s of area %d at %#" PRIx32 "): %s\n",
+                   op, cut_point.erase ? "erase" : "write", cut_area(&cut_point),
+                   cut_point.off, failure);
+            failures++;
+        }
+
+        if (after.time_ns > worst_ns)
+        {
+            worst_ns = after.time_ns;
+            worst_op = op;
+        }
+        worst_extra = (extra_writes > worst_extra) ? extra_writes : worst_extra;
+        cuts++;
+    }
+
+    printf("%" PRIu32 " power cuts, %" PRIu32 " failed recoveries\n", cuts, failures);
+    printf("Worst recovery boot: %" PRIu64 ".%03" PRIu64 " ms (cut at operation %"
+           PRIu64 "), at most %" PRIu64 " extra writes\n", worst_ns / 1000000U,
+           (worst_ns / 1000U) % 1000U, worst_op, worst_extra);
+
+    if (0U != failures)
+    {
+        exit_code = CUT_EXIT_FAIL;
+    }
+    else if ((0U != params.max_us) && (worst_ns / 1000U > params.max_us))
+    {
+        printf("Recovery exceeds the %" PRIu64 " us budget\n", params.max_us);
+        exit_code = CUT_EXIT_FAIL;
+    }
+
+    if (NULL != csv)
+    {
+        fclose(csv);
+    }
+    free(ref.primary);
+    free(ref.secondary);
+    for (uint32_t i = 0U; i < cut_snapshot_count; i++)
+    {
+        free(cut_snapshots[i].mem);
+    }
+    flash_sim_close();
+
+    return exit_code;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,414 @@
+/******************************************************************************
+* File Name:   sfdp_cache_test.c
+*
+* Description: Host test of the SFDP cache. Runs consecutive boots against
+*              simulated QSPI parts with synthetic JESD216 SFDP tables and
+*              checks when the discovery runs and when the record is written.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sfdp_cache.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SFDP_SIGNATURE         (0x50444653U)   /* "SFDP" */
+#define TEST_SFDP_SIZE              (0x50U)
+#define TEST_BFPT_OFFSET            (0x10U)
+#define TEST_BFPT_DWORDS            (16U)
+
+/* Modeled cost of the SFDP reads, single-bit at 50 MHz plus the command */
+#define TEST_CMD_NS                 (1000U)
+#define TEST_BYTE_NS                (160U)
+
+/* Exit codes, usable as CI verdicts */
+#define TEST_EXIT_OK                (0)
+#define TEST_EXIT_FAIL              (1)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+/* Memory configuration derived from the basic flash parameter table */
+typedef struct
+{
+    uint32_t mem_size;
+    uint32_t erase_size;
+    uint32_t page_size;
+    uint8_t  erase_cmd;
+    uint8_t  read_cmd;
+    uint8_t  read_dummy;
+    uint8_t  addr_bytes;
+} test_mem_cfg_t;
+
+/* Simulated memory part and the internal flash record */
+typedef struct
+{
+    uint8_t jedec_id[SFDP_CACHE_ID_SIZE];
+    uint8_t sfdp[TEST_SFDP_SIZE];
+    bool hybrid;                        /* Configuration cannot be cached */
+    bool restore_fails;                 /* E.g. a changed driver layout */
+    bool ready;
+    test_mem_cfg_t cfg;                 /* Configuration in use */
+    uint8_t record[SFDP_CACHE_RECORD_SIZE];
+    uint32_t discoveries;
+    uint32_t stores;
+    uint64_t time_ns;
+} test_dev_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t test_failures;
+
+/******************************************************************************
+ * Function Name: test_put32
+ ******************************************************************************/
+static void test_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8U);
+    p[2] = (uint8_t)(v >> 16U);
+    p[3] = (uint8_t)(v >> 24U);
+}
+
+/******************************************************************************
+ * Function Name: test_get32
+ ******************************************************************************/
+static uint32_t test_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8U) | ((uint32_t)p[2] << 16U) |
+           ((uint32_t)p[3] << 24U);
+}
+
+/******************************************************************************
+ * Function Name: test_make_sfdp
+ ******************************************************************************
+ * Summary:
+ *  Builds a JESD216 SFDP area with a single basic flash parameter table:
+ *  density, one uniform erase type, 1-4-4 fast read, page size and the
+ *  address bytes.
+ *
+ ******************************************************************************/
+static void test_make_sfdp(uint8_t *sfdp, uint32_t size_log2, uint32_t erase_log2,
+                           uint8_t erase_cmd, uint8_t read_dummy, bool addr4)
+{
+    uint8_t *bfpt = &sfdp[TEST_BFPT_OFFSET];
+
+    (void)memset(sfdp, 0xFF, TEST_SFDP_SIZE);
+
+    /* SFDP header: signature, revision 1.6, one parameter header */
+    test_put32(&sfdp[0], TEST_SFDP_SIGNATURE);
+    sfdp[4] = 6U;
+    sfdp[5] = 1U;
+    sfdp[6] = 0U;
+    sfdp[7] = 0xFFU;
+
+    /* Parameter header 0: basic flash parameter table */
+    sfdp[8] = 0x00U;
+    sfdp[9] = 6U;
+    sfdp[10] = 1U;
+    sfdp[11] = TEST_BFPT_DWORDS;
+    sfdp[12] = TEST_BFPT_OFFSET;
+    sfdp[13] = 0U;
+    sfdp[14] = 0U;
+    sfdp[15] = 0xFFU;
+
+    /* DWORD1: 1-4-4 fast read supported, address bytes */
+    test_put32(&bfpt[0], 0xFF0000E5U | (1UL << 21U) | ((addr4 ? 2UL : 0UL) << 17U));
+    /* DWORD2: density in bits minus one */
+    test_put32(&bfpt[4], (1UL << (size_log2 + 3U)) - 1U);
+    /* DWORD3: 1-4-4 fast read opcode 0xEB, mode clocks 2, wait states */
+    test_put32(&bfpt[8], 0x0000EB40U | (uint32_t)read_dummy);
+    /* DWORD8: erase type 1 */
+    test_put32(&bfpt[28], 0xFFFF0000U | ((uint32_t)erase_cmd << 8U) | erase_log2);
+    /* DWORD9: no erase types 2 to 4 */
+    test_put32(&bfpt[32], 0x00000000U);
+    /* DWORD11: page size 2^8 */
+    test_put32(&bfpt[40], 0x00000080U);
+}
+
+/******************************************************************************
+ * Function Name: test_parse_sfdp
+ ******************************************************************************
+ * Summary:
+ *  Reads and parses the SFDP area of the part, charging the reads.
+ *
+ ******************************************************************************/
+static int test_parse_sfdp(test_dev_t *dev, test_mem_cfg_t *cfg)
+{
+    const uint8_t *bfpt;
+    uint32_t dword;
+
+    /* Header and parameter header, then the table */
+    dev->time_ns += 2U * TEST_CMD_NS + (uint64_t)TEST_BYTE_NS * TEST_SFDP_SIZE;
+
+    if ((TEST_SFDP_SIGNATURE != test_get32(&dev->sfdp[0])) || (0x00U != dev->sfdp[8]) ||
+        (dev->sfdp[11] < 11U))
+    {
+        return -1;
+    }
+
+    bfpt = &dev->sfdp[dev->sfdp[12]];
+    (void)memset(cfg, 0, sizeof(*cfg));
+
+    dword = test_get32(&bfpt[4]);
+    cfg->mem_size = (0U != (dword & 0x80000000U)) ? 0U : ((dword + 1U) / 8U);
+
+    dword = test_get32(&bfpt[0]);
+    cfg->addr_bytes = (0U != ((dword >> 17U) & 3U)) ? 4U : 3U;
+    if (0U != (dword & (1UL << 21U)))
+    {
+        dword = test_get32(&bfpt[8]);
+        cfg->read_cmd = (uint8_t)(dword >> 8U);
+        cfg->read_dummy = (uint8_t)((dword & 0x1FU) + ((dword >> 5U) & 7U));
+    }
+    else
+    {
+        cfg->read_cmd = 0x03U;
+    }
+
+    dword = test_get32(&bfpt[28]);
+    cfg->erase_size = 1UL << (dword & 0xFFU);
+    cfg->erase_cmd = (uint8_t)(dword >> 8U);
+
+    cfg->page_size = 1UL << ((test_get32(&bfpt[40]) >> 4U) & 0xFU);
+
+    return (0U != cfg->mem_size) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Port of the simulated part
+ ******************************************************************************/
+static int test_discover(void *ctx)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    dev->discoveries++;
+    dev->ready = (0 == test_parse_sfdp(dev, &dev->cfg));
+
+    return dev->ready ? 0 : -1;
+}
+
+static int test_restore(void *ctx, const uint8_t *cfg, uint32_t size)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    if (dev->restore_fails || (sizeof(dev->cfg) != size))
+    {
+        return -1;
+    }
+
+    (void)memcpy(&dev->cfg, cfg, size);
+    dev->ready = true;
+
+    return 0;
+}
+
+static int test_save(void *ctx, uint8_t *cfg, uint32_t max_size, uint32_t *size)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    if (dev->hybrid || (sizeof(dev->cfg) > max_size))
+    {
+        return -1;
+    }
+
+    (void)memcpy(cfg, &dev->cfg, sizeof(dev->cfg));
+    *size = sizeof(dev->cfg);
+
+    return 0;
+}
+
+static int test_read_id(void *ctx, uint8_t id[SFDP_CACHE_ID_SIZE])
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    if (!dev->ready)
+    {
+        return -1;
+    }
+
+    dev->time_ns += TEST_CMD_NS + (uint64_t)TEST_BYTE_NS * SFDP_CACHE_ID_SIZE;
+    (void)memcpy(id, dev->jedec_id, SFDP_CACHE_ID_SIZE);
+
+    return 0;
+}
+
+static void test_release(void *ctx)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    dev->ready = false;
+    (void)memset(&dev->cfg, 0, sizeof(dev->cfg));
+}
+
+static int test_load(void *ctx, uint8_t *rec)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    (void)memcpy(rec, dev->record, SFDP_CACHE_RECORD_SIZE);
+
+    return 0;
+}
+
+static int test_store(void *ctx, const uint8_t *rec)
+{
+    test_dev_t *dev = (test_dev_t *)ctx;
+
+    dev->stores++;
+    (void)memcpy(dev->record, rec, SFDP_CACHE_RECORD_SIZE);
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: test_boot
+ ******************************************************************************
+ * Summary:
+ *  Runs the cache like one boot and checks the result, the number of SFDP
+ *  discoveries and record writes, and the configuration in use.
+ *
+ ******************************************************************************/
+static void test_boot(const char *name, test_dev_t *dev, int exp_rc, uint32_t exp_discoveries,
+                      uint32_t exp_stores)
+{
+    const sfdp_cache_port_t port =
+    {
+        .discover = test_discover,
+        .restore = test_restore,
+        .save = test_save,
+        .read_id = test_read_id,
+        .release = test_release,
+        .load = test_load,
+        .store = test_store,
+        .ctx = dev
+    };
+    test_mem_cfg_t expected;
+    bool cfg_ok = true;
+    uint64_t time_ns;
+    int rc;
+
+    dev->ready = false;
+    dev->discoveries = 0U;
+    dev->stores = 0U;
+    dev->time_ns = 0U;
+    (void)memset(&dev->cfg, 0, sizeof(dev->cfg));
+
+    rc = sfdp_cache_init(&port);
+    time_ns = dev->time_ns;
+
+    if (SFDP_CACHE_ERROR != rc)
+    {
+        cfg_ok = dev->ready && (0 == test_parse_sfdp(dev, &expected)) &&
+                 (0 == memcmp(&expected, &dev->cfg, sizeof(expected)));
+    }
+
+    if ((exp_rc != rc) || (exp_discoveries != dev->discoveries) ||
+        (exp_stores != dev->stores) || !cfg_ok)
+    {
+        test_failures++;
+        printf("FAIL %-28s rc %d, discoveries %u, stores %u, config %s\n", name, rc,
+               (unsigned int)dev->discoveries, (unsigned int)dev->stores,
+               cfg_ok ? "ok" : "wrong");
+    }
+    else
+    {
+        printf("PASS %-28s %s, SFDP/ID reads %6.1f us\n", name,
+               (SFDP_CACHE_HIT == rc) ? "hit " : ((SFDP_CACHE_MISS == rc) ? "miss" : "err "),
+               (double)time_ns / 1e3);
+    }
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************/
+int main(void)
+{
+    static test_dev_t dev;
+    static const uint8_t s25fl512s[SFDP_CACHE_ID_SIZE] = { 0x01U, 0x02U, 0x20U };
+    static const uint8_t s25fl128s[SFDP_CACHE_ID_SIZE] = { 0x01U, 0x20U, 0x18U };
+
+    /* 64 MB, 256 KB sectors, 4-byte addresses. The record starts erased */
+    (void)memcpy(dev.jedec_id, s25fl512s, sizeof(dev.jedec_id));
+    test_make_sfdp(dev.sfdp, 26U, 18U, 0xDCU, 8U, true);
+    (void)memset(dev.record, 0x00, sizeof(dev.record));
+
+    test_boot("cold boot", &dev, SFDP_CACHE_MISS, 1U, 1U);
+    test_boot("warm boot", &dev, SFDP_CACHE_HIT, 0U, 0U);
+    test_boot("warm boot, no rewrite", &dev, SFDP_CACHE_HIT, 0U, 0U);
+
+    /* Another part: the ID check fails, the new part is discovered */
+    (void)memcpy(dev.jedec_id, s25fl128s, sizeof(dev.jedec_id));
+    test_make_sfdp(dev.sfdp, 24U, 16U, 0xD8U, 6U, false);
+    test_boot("replaced part", &dev, SFDP_CACHE_MISS, 1U, 1U);
+    test_boot("replaced part, warm boot", &dev, SFDP_CACHE_HIT, 0U, 0U);
+
+    /* A damaged record is rebuilt */
+    dev.record[sizeof(sfdp_cache_header_t) + 1U] ^= 0x10U;
+    test_boot("corrupted record", &dev, SFDP_CACHE_MISS, 1U, 1U);
+    dev.record[0] ^= 0x01U;
+    test_boot("corrupted magic", &dev, SFDP_CACHE_MISS, 1U, 1U);
+
+    /* The driver rejects the cached configuration */
+    dev.restore_fails = true;
+    test_boot("restore fails", &dev, SFDP_CACHE_MISS, 1U, 0U);
+    dev.restore_fails = false;
+
+    /* Configurations that cannot be cached are discovered every boot */
+    dev.hybrid = true;
+    (void)memset(dev.record, 0x00, sizeof(dev.record));
+    test_boot("not cacheable", &dev, SFDP_CACHE_MISS, 1U, 0U);
+    test_boot("not cacheable, again", &dev, SFDP_CACHE_MISS, 1U, 0U);
+    dev.hybrid = false;
+
+    /* A part without a valid SFDP area fails, the record is kept */
+    test_boot("valid record", &dev, SFDP_CACHE_MISS, 1U, 1U);
+    (void)memcpy(dev.jedec_id, s25fl512s, sizeof(dev.jedec_id));
+    dev.sfdp[0] = 0x00U;
+    test_boot("no SFDP", &dev, SFDP_CACHE_ERROR, 1U, 0U);
+
+    printf("%s: %u failure(s)\n", (0U == test_failures) ? "PASSED" : "FAILED",
+           (unsigned int)test_failures);
+
+    return (0U == test_failures) ? TEST_EXIT_OK : TEST_EXIT_FAIL;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,536 @@
+/******************************************************************************
+* File Name:   sim_flash_map.c
+*
+* Description: MCUboot flash map backend on top of the flash simulator. It
+*              replaces platforms/memory/flash_map_backend of the target
+*              build and counts every read, write and erase per flash area.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "memorymap.h"
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "flash_map_backend_platform.h"
+
+#include "sim_flash_map.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Memory-mapped base addresses of the PSoC 6 internal flash and SMIF window */
+#define SIM_INT_FLASH_BASE          (0x10000000U)
+#define SIM_EXT_FLASH_BASE          (0x18000000U)
+
+/* Erased values: PSoC 6 internal flash reads 0 after erase, NOR flash 0xFF */
+#define SIM_INT_ERASED_VAL          (0x00U)
+#define SIM_EXT_ERASED_VAL          (0xFFU)
+
+#ifndef CY_MAX_EXT_FLASH_ERASE_SIZE
+#define CY_MAX_EXT_FLASH_ERASE_SIZE (0x40000U)
+#endif
+
+#define SIM_IS_INTERNAL(dev_id)     (FLASH_DEVICE_INTERNAL_FLASH == (dev_id))
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Counters, indexed like flash_areas[] */
+static flash_sim_stats_t sim_area_stats[SIM_FLASH_MAP_MAX_AREAS];
+
+static uint32_t sim_area_count;
+
+/******************************************************************************
+ * Function Name: sim_area_index
+ ******************************************************************************
+ * Summary:
+ *  Returns the index of a flash area in flash_areas[], or -1.
+ *
+ ******************************************************************************/
+static int sim_area_index(const struct flash_area *fa)
+{
+    for (uint32_t i = 0U; i < sim_area_count; i++)
+    {
+        if (boot_area_descs[i] == fa)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * Function Name: sim_area_dev
+ ******************************************************************************
+ * Summary:
+ *  Resolves the simulated device and counters that back a flash area.
+ *
+ ******************************************************************************/
+static flash_sim_dev_t *sim_area_dev(const struct flash_area *fa,
+                                     flash_sim_stats_t **stats)
+{
+    int idx = sim_area_index(fa);
+
+    if (idx < 0)
+    {
+        return NULL;
+    }
+
+    *stats = &sim_area_stats[idx];
+    return flash_sim_get_device(fa->fa_device_id);
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_init
+ ******************************************************************************
+ * Summary:
+ *  Creates one simulated device per flash device referenced by the generated
+ *  flash areas. The device is sized to the end of the last area on it.
+ *  Internal flash is backed by flash_file, external flash by
+ *  flash_file + ".ext".
+ *
+ * Return:
+ *  0 on success, -1 otherwise
+ *
+ ******************************************************************************/
+int sim_flash_map_init(const char *flash_file,
+                       const flash_sim_timing_t *int_timing,
+                       const flash_sim_timing_t *ext_timing)
+{
+    uint32_t int_end = 0U;
+    uint32_t ext_end = 0U;
+    uint8_t ext_id = 0U;
+    char ext_file[512];
+    int rc = FLASH_SIM_OK;
+
+    sim_area_count = 0U;
+    while ((sim_area_count < SIM_FLASH_MAP_MAX_AREAS) &&
+           (NULL != boot_area_descs[sim_area_count]))
+    {
+        const struct flash_area *fa = boot_area_descs[sim_area_count];
+        uint32_t end = fa->fa_off + fa->fa_size;
+
+        if (SIM_IS_INTERNAL(fa->fa_device_id))
+        {
+            int_end = (end > int_end) ? end : int_end;
+        }
+        else
+        {
+            ext_end = (end > ext_end) ? end : ext_end;
+            ext_id = fa->fa_device_id;
+        }
+        sim_area_count++;
+    }
+
+    if (int_end > 0U)
+    {
+        int_end = (int_end + MEMORY_ALIGN - 1U) & ~(uint32_t)(MEMORY_ALIGN - 1U);
+        rc = flash_sim_add_device(FLASH_DEVICE_INTERNAL_FLASH, flash_file,
+                                  int_end, MEMORY_ALIGN,
+                                  MCUBOOT_PLATFORM_CHUNK_SIZE,
+                                  SIM_INT_ERASED_VAL, true, int_timing);
+    }
+
+    if ((FLASH_SIM_OK == rc) && (ext_end > 0U))
+    {
+        ext_end = (ext_end + CY_MAX_EXT_FLASH_ERASE_SIZE - 1U) &
+                  ~(uint32_t)(CY_MAX_EXT_FLASH_ERASE_SIZE - 1U);
+        (void)snprintf(ext_file, sizeof(ext_file), "%s.ext", flash_file);
+        rc = flash_sim_add_device(ext_id, ext_file, ext_end,
+                                  CY_MAX_EXT_FLASH_ERASE_SIZE,
+                                  MCUBOOT_PLATFORM_CHUNK_SIZE,
+                                  SIM_EXT_ERASED_VAL, false, ext_timing);
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_load
+ ******************************************************************************
+ * Summary:
+ *  Places a raw image at the start of a flash area. The area is erased first
+ *  so that left-overs of a previous run do not leak into the trailer.
+ *
+ ******************************************************************************/
+int sim_flash_map_load(uint8_t fa_id, const char *path)
+{
+    const struct flash_area *fa = NULL;
+    flash_sim_dev_t *dev;
+
+    if (0 != flash_area_open(fa_id, &fa))
+    {
+        return -1;
+    }
+
+    dev = flash_sim_get_device(fa->fa_device_id);
+    if (NULL == dev)
+    {
+        return -1;
+    }
+
+    memset(&dev->mem[fa->fa_off], dev->erased_val, fa->fa_size);
+
+    return (flash_sim_load(dev, fa->fa_off, path, fa->fa_size) > 0) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_reset_stats
+ ******************************************************************************/
+void sim_flash_map_reset_stats(void)
+{
+    memset(sim_area_stats, 0, sizeof(sim_area_stats));
+    flash_sim_reset_clock();
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_total
+ ******************************************************************************
+ * Summary:
+ *  Sums up the counters of all flash areas.
+ *
+ ******************************************************************************/
+void sim_flash_map_total(flash_sim_stats_t *total)
+{
+    memset(total, 0, sizeof(*total));
+
+    for (uint32_t i = 0U; i < sim_area_count; i++)
+    {
+        total->reads += sim_area_stats[i].reads;
+        total->read_bytes += sim_area_stats[i].read_bytes;
+        total->writes += sim_area_stats[i].writes;
+        total->write_bytes += sim_area_stats[i].write_bytes;
+        total->erases += sim_area_stats[i].erases;
+        total->erase_bytes += sim_area_stats[i].erase_bytes;
+        total->time_ns += sim_area_stats[i].time_ns;
+    }
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_report
+ ******************************************************************************
+ * Summary:
+ *  Prints the per-area counters, either as a table or as CSV rows prefixed
+ *  with the given label (one row per area plus a "total" row).
+ *
+ ******************************************************************************/
+void sim_flash_map_report(FILE *out, bool csv, const char *label)
+{
+    flash_sim_stats_t total;
+
+    sim_flash_map_total(&total);
+
+    if (!csv)
+    {
+        fprintf(out, "%-6s %10s %10s %8s %10s %8s %10s %12s\n", "area",
+                "offset", "reads", "rd_kb", "writes", "wr_kb", "erases", "time_us");
+    }
+
+    for (uint32_t i = 0U; i <= sim_area_count; i++)
+    {
+        const flash_sim_stats_t *s = (i < sim_area_count) ? &sim_area_stats[i] : &total;
+        char name[16];
+
+        if (i < sim_area_count)
+        {
+            (void)snprintf(name, sizeof(name), "%u", (unsigned)boot_area_descs[i]->fa_id);
+        }
+        else
+        {
+            (void)snprintf(name, sizeof(name), "total");
+        }
+
+        if (csv)
+        {
+            fprintf(out, "%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64
+                    ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n", label, name,
+                    s->reads, s->read_bytes, s->writes, s->write_bytes,
+                    s->erases, s->erase_bytes, s->time_ns / 1000U);
+        }
+        else
+        {
+            fprintf(out, "%-6s %#10" PRIx32 " %10" PRIu64 " %8" PRIu64 " %10" PRIu64
+                    " %8" PRIu64 " %10" PRIu64 " %12" PRIu64 "\n", name,
+                    (i < sim_area_count) ? boot_area_descs[i]->fa_off : 0U,
+                    s->reads, s->read_bytes / 1024U, s->writes,
+                    s->write_bytes / 1024U, s->erases, s->time_ns / 1000U);
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: sim_flash_map_report_wear
+ ******************************************************************************
+ * Summary:
+ *  Prints the erase cycles of the flash areas since the simulator was set
+ *  up, either as a table with the total and the most worn sector of every
+ *  area, or as CSV with one row per erase sector.
+ *
+ ******************************************************************************/
+void sim_flash_map_report_wear(FILE *out, bool csv)
+{
+    if (csv)
+    {
+        fprintf(out, "area,sector,offset,erase_cycles\n");
+    }
+    else
+    {
+        fprintf(out, "%-6s %10s %8s %10s %10s %10s\n", "area", "offset",
+                "sectors", "cycles", "max", "max_at");
+    }
+
+    for (uint32_t i = 0U; i < sim_area_count; i++)
+    {
+        const struct flash_area *fa = boot_area_descs[i];
+        const flash_sim_dev_t *dev = flash_sim_get_device(fa->fa_device_id);
+        uint64_t total = 0U;
+        uint32_t max = 0U;
+        uint32_t max_at = fa->fa_off;
+        uint32_t sectors;
+
+        if (NULL == dev)
+        {
+            continue;
+        }
+
+        sectors = fa->fa_size / dev->erase_size;
+        for (uint32_t sector = 0U; sector < sectors; sector++)
+        {
+            uint32_t off = fa->fa_off + (sector * dev->erase_size);
+            uint32_t cycles = dev->erase_cycles[off / dev->erase_size];
+
+            if (csv)
+            {
+                fprintf(out, "%u,%" PRIu32 ",%#" PRIx32 ",%" PRIu32 "\n",
+                        (unsigned)fa->fa_id, sector, off, cycles);
+            }
+
+            total += cycles;
+            if (cycles > max)
+            {
+                max = cycles;
+                max_at = off;
+            }
+        }
+
+        if (!csv)
+        {
+            fprintf(out, "%-6u %#10" PRIx32 " %8" PRIu32 " %10" PRIu64 " %10" PRIu32
+                    " %#10" PRIx32 "\n", (unsigned)fa->fa_id, fa->fa_off, sectors,
+                    total, max, max_at);
+        }
+    }
+}
+
+/******************************************************************************
+* MCUboot flash map backend API
+*******************************************************************************/
+
+int flash_device_base(uint8_t fd_id, uintptr_t *ret)
+{
+    *ret = SIM_IS_INTERNAL(fd_id) ? SIM_INT_FLASH_BASE : SIM_EXT_FLASH_BASE;
+    return 0;
+}
+
+int flash_area_open(uint8_t id, const struct flash_area **fa)
+{
+    for (uint32_t i = 0U; NULL != boot_area_descs[i]; i++)
+    {
+        if (id == boot_area_descs[i]->fa_id)
+        {
+            *fa = boot_area_descs[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+void flash_area_close(const struct flash_area *fa)
+{
+    (void)fa;
+}
+
+int flash_area_read(const struct flash_area *fa, uint32_t off, void *dst,
+                    uint32_t len)
+{
+    flash_sim_stats_t *stats = NULL;
+    flash_sim_dev_t *dev = sim_area_dev(fa, &stats);
+
+    if ((NULL == dev) || (off > fa->fa_size) || (len > fa->fa_size - off))
+    {
+        return -1;
+    }
+
+    return flash_sim_read(dev, fa->fa_off + off, dst, len, stats);
+}
+
+int flash_area_write(const struct flash_area *fa, uint32_t off,
+                     const void *src, uint32_t len)
+{
+    flash_sim_stats_t *stats = NULL;
+    flash_sim_dev_t *dev = sim_area_dev(fa, &stats);
+
+    if ((NULL == dev) || (off > fa->fa_size) || (len > fa->fa_size - off))
+    {
+        return -1;
+    }
+
+    return flash_sim_write(dev, fa->fa_off + off, src, len, stats);
+}
+
+int flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len)
+{
+    flash_sim_stats_t *stats = NULL;
+    flash_sim_dev_t *dev = sim_area_dev(fa, &stats);
+
+    if ((NULL == dev) || (off > fa->fa_size) || (len > fa->fa_size - off))
+    {
+        return -1;
+    }
+
+    return flash_sim_erase(dev, fa->fa_off + off, len, stats);
+}
+
+size_t flash_area_align(const struct flash_area *fa)
+{
+    return SIM_IS_INTERNAL(fa->fa_device_id) ? MEMORY_ALIGN : 1U;
+}
+
+uint8_t flash_area_erased_val(const struct flash_area *fa)
+{
+    return SIM_IS_INTERNAL(fa->fa_device_id) ? SIM_INT_ERASED_VAL : SIM_EXT_ERASED_VAL;
+}
+
+int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
+                             void *dst, uint32_t len)
+{
+    const uint8_t *buf = (const uint8_t *)dst;
+    uint8_t erased_val = flash_area_erased_val(fa);
+
+    if (0 != flash_area_read(fa, off, dst, len))
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        if (buf[i] != erased_val)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int flash_area_get_sectors(int fa_id, uint32_t *count,
+                           struct flash_sector *sectors)
+{
+    const struct flash_area *fa = NULL;
+    flash_sim_dev_t *dev;
+    uint32_t max = *count;
+    uint32_t n = 0U;
+
+    if (0 != flash_area_open((uint8_t)fa_id, &fa))
+    {
+        return -1;
+    }
+
+    dev = flash_sim_get_device(fa->fa_device_id);
+    if (NULL == dev)
+    {
+        return -1;
+    }
+
+    for (uint32_t off = 0U; off < fa->fa_size; off += dev->erase_size)
+    {
+        if (n >= max)
+        {
+            return -1;
+        }
+        sectors[n].fs_off = off;
+        sectors[n].fs_size = dev->erase_size;
+        n++;
+    }
+
+    *count = n;
+    return 0;
+}
+
+int flash_area_id_from_multi_image_slot(int image_index, int slot)
+{
+    switch (slot)
+    {
+        case 0:
+            return (int)FLASH_AREA_IMAGE_PRIMARY((uint32_t)image_index);
+        case 1:
+            return (int)FLASH_AREA_IMAGE_SECONDARY((uint32_t)image_index);
+        case 2:
+            return (int)FLASH_AREA_IMAGE_SCRATCH;
+        default:
+            return -1;
+    }
+}
+
+int flash_area_id_from_image_slot(int slot)
+{
+    return flash_area_id_from_multi_image_slot(0, slot);
+}
+
+int flash_area_id_to_multi_image_slot(int image_index, int area_id)
+{
+    if (area_id == (int)FLASH_AREA_IMAGE_PRIMARY((uint32_t)image_index))
+    {
+        return 0;
+    }
+    if (area_id == (int)FLASH_AREA_IMAGE_SECONDARY((uint32_t)image_index))
+    {
+        return 1;
+    }
+
+    return -1;
+}
+
+int flash_area_id_to_image_slot(int area_id)
+{
+    return flash_area_id_to_multi_image_slot(0, area_id);
+}
+
+/* [] END OF FILE */
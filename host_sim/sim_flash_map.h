@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name:   sim_flash_map.h
+*
+* Description: MCUboot flash map backend on top of the flash simulator. The
+*              flash areas come from the memorymap.c generated from the
+*              flashmap JSON, so the simulated layout always matches the one
+*              the Bootloader app is built with.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SIM_FLASH_MAP_H
+#define SIM_FLASH_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "flash_sim.h"
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Upper bound of entries in the generated flash_areas[] */
+#define SIM_FLASH_MAP_MAX_AREAS     (16U)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int  sim_flash_map_init(const char *flash_file,
+                        const flash_sim_timing_t *int_timing,
+                        const flash_sim_timing_t *ext_timing);
+int  sim_flash_map_load(uint8_t fa_id, const char *path);
+void sim_flash_map_reset_stats(void);
+void sim_flash_map_total(flash_sim_stats_t *total);
+void sim_flash_map_report(FILE *out, bool csv, const char *label);
+void sim_flash_map_report_wear(FILE *out, bool csv);
+
+#endif /* SIM_FLASH_MAP_H */
+
+/* [] END OF FILE */
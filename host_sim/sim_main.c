@@ -0,0 +1,454 @@
+/******************************************************************************
+* File Name:   sim_main.c
+*
+* Description: Host entry point of the MCUboot Bootloader app simulator. It
+*              places images into a simulated flash laid out by the flashmap
+*              JSON, runs boot_go() one or more times and reports the flash
+*              operations and the estimated flash time of every boot.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* MCUboot header files */
+#include "memorymap.h"
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/fault_injection_hardening.h"
+
+#include "flash_sim.h"
+#include "sim_flash_map.h"
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+#include "flash_cache.h"
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+#if defined(CY_BOOT_IMAGE_CACHE)
+#include "image_cache.h"
+#endif /* CY_BOOT_IMAGE_CACHE */
+#if defined(CY_BOOT_MULTI_IMAGE)
+#include "image_verify.h"
+#endif /* CY_BOOT_MULTI_IMAGE */
+
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Default latencies, typical PSoC 6 datasheet values. Internal flash: row
+ * write (erase + program) 16 ms, row erase 11 ms, ~10 ns/byte read.
+ * External S25FL512S in quad mode: 256-KB sector erase 520 ms, 512-byte
+ * program 0.7 ms, ~1 us command overhead and 40 ns/byte read.
+ */
+#define SIM_INT_TIMING_DEFAULT      { 0U, 10U, 16000000U, 11000000U }
+#define SIM_EXT_TIMING_DEFAULT      { 1000U, 40U, 700000U, 520000000U }
+
+#define SIM_DEFAULT_FLASH_FILE      "flash.bin"
+
+/* Exit codes, usable as CI verdicts */
+#define SIM_EXIT_OK                 (0)
+#define SIM_EXIT_NO_BOOT            (1)
+#define SIM_EXIT_SLOW               (2)
+#define SIM_EXIT_USAGE              (3)
+
+/******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    const char *flash_file;
+    const char *primary[MCUBOOT_IMAGE_NUMBER];
+    const char *secondary[MCUBOOT_IMAGE_NUMBER];
+    const char *csv_file;
+    const char *wear_file;
+    uint32_t boots;
+    uint64_t max_us;
+    bool erase_all;
+    flash_sim_timing_t int_timing;
+    flash_sim_timing_t ext_timing;
+} sim_params_t;
+
+/******************************************************************************
+ * Function Name: usage
+ ******************************************************************************/
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "USAGE: %s [options]\n\n"
+        "OPTIONS:\n"
+        "  -f, --flash=FILE        backing file of the internal flash (default %s)\n"
+        "  -i, --image=N           image of the following -p and -s, 1 to %u (default 1)\n"
+        "  -p, --primary=BIN       signed image to place into the primary slot\n"
+        "  -s, --secondary=BIN     signed image to place into the secondary slot\n"
+        "  -e, --erase             start from fully erased flash\n"
+        "  -n, --boots=N           number of consecutive boots to run (default 1)\n"
+        "  -t, --timing-int=SPEC   internal flash latencies, ns\n"
+        "  -T, --timing-ext=SPEC   external flash latencies, ns\n"
+        "                          SPEC = read_op,read_byte,program,erase\n"
+        "  -c, --csv=FILE          append per-area counters to FILE as CSV\n"
+        "  -w, --wear=FILE         write the erase cycles of every sector to FILE\n"
+        "  -m, --max-us=US         fail if any boot takes longer than US\n"
+        "  -h, --help              display this information\n",
+        prog, SIM_DEFAULT_FLASH_FILE, (unsigned int)MCUBOOT_IMAGE_NUMBER);
+}
+
+/******************************************************************************
+ * Function Name: parse_args
+ ******************************************************************************/
+static int parse_args(int argc, char *argv[], sim_params_t *p)
+{
+    static const struct option opts[] =
+    {
+        { "flash",      required_argument, NULL, 'f' },
+        { "image",      required_argument, NULL, 'i' },
+        { "primary",    required_argument, NULL, 'p' },
+        { "secondary",  required_argument, NULL, 's' },
+        { "erase",      no_argument,       NULL, 'e' },
+        { "boots",      required_argument, NULL, 'n' },
+        { "timing-int", required_argument, NULL, 't' },
+        { "timing-ext", required_argument, NULL, 'T' },
+        { "csv",        required_argument, NULL, 'c' },
+        { "wear",       required_argument, NULL, 'w' },
+        { "max-us",     required_argument, NULL, 'm' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    uint32_t image = 0U;
+    int opt;
+
+    while (-1 != (opt = getopt_long(argc, argv, "f:i:p:s:en:t:T:c:w:m:h", opts, NULL)))
+    {
+        switch (opt)
+        {
+            case 'f': p->flash_file = optarg; break;
+            case 'p': p->primary[image] = optarg; break;
+            case 's': p->secondary[image] = optarg; break;
+            case 'i':
+                image = (uint32_t)strtoul(optarg, NULL, 0) - 1U;
+                if (image >= (uint32_t)MCUBOOT_IMAGE_NUMBER)
+                {
+                    return -1;
+                }
+                break;
+            case 'e': p->erase_all = true; break;
+            case 'n': p->boots = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': p->csv_file = optarg; break;
+            case 'w': p->wear_file = optarg; break;
+            case 'm': p->max_us = strtoull(optarg, NULL, 0); break;
+            case 't':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->int_timing))
+                {
+                    return -1;
+                }
+                break;
+            case 'T':
+                if (FLASH_SIM_OK != flash_sim_parse_timing(optarg, &p->ext_timing))
+                {
+                    return -1;
+                }
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    return (p->boots > 0U) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: sim_cpu_ns
+ ******************************************************************************/
+static uint64_t sim_cpu_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: sim_boot
+ ******************************************************************************
+ * Summary:
+ *  Runs boot_go(), or skips it on a validated image cache hit, like the
+ *  main() of the Bootloader app.
+ *
+ ******************************************************************************/
+static fih_int sim_boot(struct boot_rsp *rsp)
+{
+    fih_int fih_status = FIH_FAILURE;
+#if defined(CY_BOOT_IMAGE_CACHE)
+    uint32_t warm_boots = 0U;
+    int cache_result = image_cache_check(0U, rsp, &warm_boots);
+
+    if (IMAGE_CACHE_HIT == cache_result)
+    {
+        printf("Validated image cache: warm boot %" PRIu32 " of %u\n", warm_boots,
+               (unsigned int)IMAGE_CACHE_FULL_PERIOD);
+        return FIH_SUCCESS;
+    }
+
+    printf("Validated image cache: full validation (reason %d)\n", cache_result);
+#endif /* CY_BOOT_IMAGE_CACHE */
+
+    FIH_CALL(boot_go, fih_status, rsp);
+
+#if defined(CY_BOOT_IMAGE_CACHE)
+    if (FIH_TRUE == fih_eq(fih_status, FIH_SUCCESS))
+    {
+        image_cache_update(0U, rsp);
+    }
+    else
+    {
+        image_cache_invalidate();
+    }
+#endif /* CY_BOOT_IMAGE_CACHE */
+
+    return fih_status;
+}
+
+/******************************************************************************
+ * Function Name: erase_all
+ ******************************************************************************
+ * Summary:
+ *  Erases every simulated device without accounting.
+ *
+ ******************************************************************************/
+static void erase_all(void)
+{
+    for (uint32_t i = 0U; NULL != boot_area_descs[i]; i++)
+    {
+        flash_sim_dev_t *dev = flash_sim_get_device(boot_area_descs[i]->fa_device_id);
+
+        if (NULL != dev)
+        {
+            flash_sim_fill_erased(dev);
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: main
+ ******************************************************************************
+ * Summary:
+ *  Runs the requested number of boots and reports each of them.
+ *
+ * Return:
+ *  SIM_EXIT_OK if every boot found a bootable image within the time budget
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+    sim_params_t params =
+    {
+        .flash_file = SIM_DEFAULT_FLASH_FILE,
+        .boots = 1U,
+        .int_timing = SIM_INT_TIMING_DEFAULT,
+        .ext_timing = SIM_EXT_TIMING_DEFAULT,
+    };
+    FILE *csv = NULL;
+    int exit_code = SIM_EXIT_OK;
+
+    if (0 != parse_args(argc, argv, &params))
+    {
+        usage(argv[0]);
+        return SIM_EXIT_USAGE;
+    }
+
+    if (0 != sim_flash_map_init(params.flash_file, &params.int_timing,
+                                &params.ext_timing))
+    {
+        fprintf(stderr, "Cannot set up the simulated flash\n");
+        return SIM_EXIT_USAGE;
+    }
+
+    if (params.erase_all)
+    {
+        erase_all();
+    }
+
+    for (uint32_t image = 0U; image < (uint32_t)MCUBOOT_IMAGE_NUMBER; image++)
+    {
+        if (((NULL != params.primary[image]) &&
+             (0 != sim_flash_map_load(FLASH_AREA_IMAGE_PRIMARY(image), params.primary[image]))) ||
+            ((NULL != params.secondary[image]) &&
+             (0 != sim_flash_map_load(FLASH_AREA_IMAGE_SECONDARY(image), params.secondary[image]))))
+        {
+            flash_sim_close();
+            return SIM_EXIT_USAGE;
+        }
+    }
+
+    if (NULL != params.csv_file)
+    {
+        csv = fopen(params.csv_file, "a");
+        if (NULL == csv)
+        {
+            fprintf(stderr, "Cannot open %s\n", params.csv_file);
+            flash_sim_close();
+            return SIM_EXIT_USAGE;
+        }
+
+        /* Header only for a new file, so several runs can share one CSV */
+        if ((0 == fseek(csv, 0, SEEK_END)) && (0 == ftell(csv)))
+        {
+            fprintf(csv, "boot,area,reads,read_bytes,writes,write_bytes,"
+                         "erases,erase_bytes,time_us\n");
+        }
+    }
+
+    for (uint32_t boot = 1U; boot <= params.boots; boot++)
+    {
+        struct boot_rsp rsp;
+        fih_int fih_status = FIH_FAILURE;
+        flash_sim_stats_t total;
+        char label[32];
+        uint64_t cpu_ns;
+
+        memset(&rsp, 0, sizeof(rsp));
+        sim_flash_map_reset_stats();
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+        /* The cache is in RAM, every boot starts with it empty */
+        flash_cache_reset();
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+#if defined(CY_BOOT_MULTI_IMAGE)
+        image_verify_init();
+#endif /* CY_BOOT_MULTI_IMAGE */
+
+        printf("\n=== Boot %" PRIu32 " ===\n", boot);
+        cpu_ns = sim_cpu_ns();
+        fih_status = sim_boot(&rsp);
+        cpu_ns = sim_cpu_ns() - cpu_ns;
+
+        sim_flash_map_total(&total);
+
+        if (FIH_TRUE == fih_eq(fih_status, FIH_SUCCESS))
+        {
+            printf("Boot image at offset 0x%08" PRIx32 ", version %u.%u.%u\n",
+                   rsp.br_image_off, rsp.br_hdr->ih_ver.iv_major,
+                   rsp.br_hdr->ih_ver.iv_minor, rsp.br_hdr->ih_ver.iv_revision);
+        }
+        else
+        {
+            printf("No bootable image found\n");
+            exit_code = SIM_EXIT_NO_BOOT;
+        }
+
+        sim_flash_map_report(stdout, false, NULL);
+#if defined(CY_BOOT_FLASH_READ_CACHE)
+        {
+            flash_cache_stats_t cache_stats;
+
+            flash_cache_get_stats(&cache_stats);
+            printf("Read cache: %" PRIu32 " hits, %" PRIu32 " misses, %" PRIu32
+                   " bytes fetched, %" PRIu32 " bypassed\n", cache_stats.hits,
+                   cache_stats.misses, cache_stats.bytes_fetched, cache_stats.bypassed);
+        }
+#endif /* CY_BOOT_FLASH_READ_CACHE */
+#if defined(CY_BOOT_MULTI_IMAGE)
+        for (uint32_t image = 0U; image < (uint32_t)MCUBOOT_IMAGE_NUMBER; image++)
+        {
+            image_verify_stats_t verify_stats;
+
+            image_verify_get_stats(image, &verify_stats);
+            printf("Image %" PRIu32 ": %" PRIu32 " validations, %" PRIu32 " failed, %"
+                   PRIu32 " us\n", image + 1U, verify_stats.validations,
+                   verify_stats.failures, verify_stats.time_us);
+        }
+        {
+            image_verify_key_stats_t key_stats;
+
+            image_verify_get_key_stats(&key_stats);
+            printf("Public keys: %" PRIu32 " parsed, %" PRIu32 " signatures checked, %"
+                   PRIu32 " mismatched\n", key_stats.key_loads, key_stats.key_hits,
+                   key_stats.verify_failures);
+        }
+#endif /* CY_BOOT_MULTI_IMAGE */
+        printf("Estimated flash time: %" PRIu64 ".%03" PRIu64 " ms\n",
+               total.time_ns / 1000000U, (total.time_ns / 1000U) % 1000U);
+        printf("Host CPU time: %" PRIu64 ".%03" PRIu64 " ms\n",
+               cpu_ns / 1000000U, (cpu_ns / 1000U) % 1000U);
+
+        if (NULL != csv)
+        {
+            (void)snprintf(label, sizeof(label), "%" PRIu32, boot);
+            sim_flash_map_report(csv, true, label);
+        }
+
+        if ((0U != params.max_us) && (total.time_ns / 1000U > params.max_us) &&
+            (SIM_EXIT_OK == exit_code))
+        {
+            printf("Boot %" PRIu32 " exceeds the %" PRIu64 " us budget\n",
+                   boot, params.max_us);
+            exit_code = SIM_EXIT_SLOW;
+        }
+    }
+
+    /* Over all boots, an upgrade can take several */
+    printf("\n=== Erase cycles ===\n");
+    sim_flash_map_report_wear(stdout, false);
+
+    if (NULL != params.wear_file)
+    {
+        FILE *wear = fopen(params.wear_file, "w");
+
+        if (NULL != wear)
+        {
+            sim_flash_map_report_wear(wear, true);
+            fclose(wear);
+        }
+        else
+        {
+            fprintf(stderr, "Cannot open %s\n", params.wear_file);
+            exit_code = SIM_EXIT_USAGE;
+        }
+    }
+
+    if (NULL != csv)
+    {
+        fclose(csv);
+    }
+    flash_sim_close();
+
+    return exit_code;
+}
+
+/* [] END OF FILE */
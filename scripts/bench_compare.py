@@ -0,0 +1,144 @@
+"""MCUBoot Bootloader Benchmark Comparison
+Copyright (c) 2026 Infineon Technologies AG
+
+Compares the CSV results of host_sim/crypto_bench against a baseline, e.g.
+the results committed before mcuboot.mtb or the mbedTLS version is bumped.
+Rows are matched by stage and size. Exits with a non-zero code when a stage
+got slower than the allowed tolerance, so it can be used as a CI check.
+"""
+
+import sys
+import getopt
+import csv
+from enum import Enum
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG         = 1
+    IO          = 2
+    FORMAT      = 3
+    REGRESSION  = 4
+
+
+# Columns written by crypto_bench
+KEY_COLUMNS = ('stage', 'bytes')
+TIME_COLUMN = 'ns_per_op'
+
+TOLERANCE_DEFAULT = 10.0
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.baseline = ''
+        self.current = ''
+        self.tolerance = TOLERANCE_DEFAULT
+        self.missing_ok = False
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -b <baseline.csv> -c <current.csv> [-t <percent>] [-m]
+
+OPTIONS:
+-h  --help       Display the usage information
+-b  --baseline=  Results of the reference build
+-c  --current=   Results of the build to check
+-t  --tolerance= Allowed slowdown of a stage in percent (default {})
+-m  --missing-ok Do not fail when a baseline stage is not in the results
+'''.format(TOLERANCE_DEFAULT)
+
+        try:
+            opts, unused = getopt.getopt(
+                sys.argv[1:], 'hb:c:t:m',
+                ['help', 'baseline=', 'current=', 'tolerance=', 'missing-ok'])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        for opt, arg in opts:
+            if opt in ('-h', '--help'):
+                print(usage, file=sys.stderr)
+                sys.exit()
+            elif opt in ('-b', '--baseline'):
+                self.baseline = arg
+            elif opt in ('-c', '--current'):
+                self.current = arg
+            elif opt in ('-t', '--tolerance'):
+                self.tolerance = float(arg)
+            elif opt in ('-m', '--missing-ok'):
+                self.missing_ok = True
+
+        if not self.baseline or not self.current:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def load_results(path):
+    """Returns {(stage, bytes): ns_per_op} in file order"""
+    results = {}
+    with open(path, newline='') as in_f:
+        reader = csv.DictReader(in_f)
+        missing = [c for c in KEY_COLUMNS + (TIME_COLUMN,)
+                   if c not in (reader.fieldnames or [])]
+        if missing:
+            raise ValueError(path + ': missing column ' + ', '.join(missing))
+        for row in reader:
+            key = (row['stage'], int(row['bytes'], 0))
+            results[key] = float(row[TIME_COLUMN])
+    return results
+
+
+def compare(baseline, current, tolerance):
+    """Returns [(stage, bytes, base_ns, cur_ns, change_percent, verdict)]"""
+    rows = []
+    for key, base_ns in baseline.items():
+        cur_ns = current.get(key)
+        if cur_ns is None:
+            rows.append(key + (base_ns, None, None, 'missing'))
+            continue
+        change = 100.0 * (cur_ns - base_ns) / base_ns if base_ns else 0.0
+        rows.append(key + (base_ns, cur_ns, change,
+                           'SLOWER' if change > tolerance else 'ok'))
+    for key, cur_ns in current.items():
+        if key not in baseline:
+            rows.append(key + (None, cur_ns, None, 'new'))
+    return rows
+
+
+def main():
+    """Benchmark comparison"""
+    params = CmdLineParams()
+
+    try:
+        baseline = load_results(params.baseline)
+        current = load_results(params.current)
+    except OSError as err:
+        print('Cannot read the results:', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+    except (ValueError, KeyError) as err:
+        print('Cannot parse the results:', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    rows = compare(baseline, current, params.tolerance)
+
+    print('{:<12} {:>9} {:>14} {:>14} {:>9}'.format(
+        'stage', 'bytes', 'baseline us', 'current us', 'change'))
+    for stage, size, base_ns, cur_ns, change, verdict in rows:
+        print('{:<12} {:>9} {:>14} {:>14} {:>9}  {}'.format(
+            stage, size,
+            '-' if base_ns is None else '{:.1f}'.format(base_ns / 1000.0),
+            '-' if cur_ns is None else '{:.1f}'.format(cur_ns / 1000.0),
+            '-' if change is None else '{:+.1f}%'.format(change),
+            verdict))
+
+    slower = [r for r in rows if r[5] == 'SLOWER']
+    missing = [r for r in rows if r[5] == 'missing']
+    if slower or (missing and not params.missing_ok):
+        print('{} stage(s) slower than {:.1f}%, {} missing'.format(
+            len(slower), params.tolerance, len(missing)), file=sys.stderr)
+        sys.exit(Error.REGRESSION.value)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,183 @@
+"""MCUBoot Bootloader Tokenized Log Decoder
+Copyright (c) 2026 Infineon Technologies AG
+
+Restores the text of the tokenized boot log (USE_BOOT_LOG_TOKENIZED=1). The
+records are taken from the BOOT_LOG_RAW lines of a serial console log, printed
+either by the Blinky app or by the Bootloader app when no image was booted.
+The format strings are read from the .boot_log_fmt section of the Bootloader
+app ELF file that produced the records.
+"""
+
+import sys
+import getopt
+import re
+import struct
+from enum import Enum
+
+from elffile import ElfFile, ElfError
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+
+
+# Record layout, see boot_log_record_t in common/boot_shared_data.h
+RECORD_HEADER = '<HBB'
+MAX_ARGS = 6
+
+LEVELS = {1: 'ERR', 2: 'WRN', 3: 'INF', 4: 'DBG'}
+
+RAW_LINE = re.compile(r'BOOT_LOG_RAW:\s*([0-9a-fA-F]+)')
+LOST_LINE = re.compile(r'BOOT_LOG_LOST:\s*(\d+)')
+
+# printf conversion: flags, width, precision, length, conversion
+CONVERSION = re.compile(r'%([-+ #0]*)(\d*|\*)(?:\.(\d+|\*))?(hh|h|ll|l|j|z|t|L)?([diouxXcspn%])')
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.elf_file = ''
+        self.in_file = ''
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -e <bootloader_app.elf> [-i <console.log>]
+
+OPTIONS:
+-h  --help       Display the usage information
+-e  --elf=       ELF file of the Bootloader app that produced the log
+-i  --ifile=     Console log with BOOT_LOG_RAW lines (default: stdin)
+'''
+
+        try:
+            opts, unused = getopt.getopt(sys.argv[1:], 'he:i:',
+                                         ['help', 'elf=', 'ifile='])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        for opt, arg in opts:
+            if opt in ('-h', '--help'):
+                print(usage, file=sys.stderr)
+                sys.exit()
+            elif opt in ('-e', '--elf'):
+                self.elf_file = arg
+            elif opt in ('-i', '--ifile'):
+                self.in_file = arg
+
+        if len(self.elf_file) == 0:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+class Detokenizer:
+    """Formats log records with the strings of the Bootloader app ELF file"""
+
+    def __init__(self, elf):
+        self.elf = elf
+        self.strings = elf.section_data('.boot_log_fmt')
+        if self.strings is None:
+            raise ElfError('no .boot_log_fmt section, was the Bootloader app '
+                           'built with USE_BOOT_LOG_TOKENIZED=1?')
+
+    def format_string(self, token):
+        """Returns the format string of a token"""
+        if token >= len(self.strings):
+            return None
+        end = self.strings.find(b'\0', token)
+        return self.strings[token:end].decode('latin-1')
+
+    def convert(self, match, args):
+        """Formats one printf conversion with the next 32-bit argument"""
+        flags, width, prec, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if not args:
+            return '<?>'
+        value = args.pop(0)
+
+        if conv == 's':
+            text = self.elf.read_cstring(value)
+            return text if text is not None else '<0x{:08x}>'.format(value)
+        if conv == 'p':
+            return '0x{:08x}'.format(value)
+        if conv in 'di':
+            value = struct.unpack('<i', struct.pack('<I', value))[0]
+            conv = 'd'
+        elif conv == 'c':
+            value = chr(value & 0xFF)
+        elif conv == 'n':
+            return ''
+
+        spec = '%' + flags + ('' if width == '*' else width)
+        if prec is not None and prec != '*':
+            spec += '.' + prec
+        return (spec + conv) % value
+
+    def format(self, record):
+        """Returns the text of one record"""
+        token, info, seq = struct.unpack_from(RECORD_HEADER, record, 0)
+        nargs = info & 0xF
+        stored = min(nargs, MAX_ARGS)
+        args = list(struct.unpack_from('<' + str(stored) + 'I', record, 4))
+        level = LEVELS.get(info >> 4, '???')
+
+        fmt = self.format_string(token)
+        if fmt is None:
+            return '[{}] <unknown token 0x{:04x}> {}'.format(level, token, args), seq
+
+        text = CONVERSION.sub(lambda m: self.convert(m, args), fmt)
+        if nargs > stored:
+            text += ' <{} arguments not recorded>'.format(nargs - stored)
+        return '[{}] {}'.format(level, text), seq
+
+
+def main():
+    """Tokenized log decoder"""
+    params = CmdLineParams()
+
+    try:
+        detok = Detokenizer(ElfFile(params.elf_file))
+        if params.in_file:
+            with open(params.in_file, 'r', errors='replace') as in_f:
+                lines = in_f.readlines()
+        else:
+            lines = sys.stdin.readlines()
+    except OSError as err:
+        print('Cannot read input:', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+    except ElfError as err:
+        print(err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    prev_seq = None
+    for line in lines:
+        lost = LOST_LINE.search(line)
+        if lost:
+            print('... {} older records were overwritten'.format(lost.group(1)))
+            prev_seq = None
+            continue
+
+        raw = RAW_LINE.search(line)
+        if not raw:
+            continue
+
+        try:
+            text, seq = detok.format(bytes.fromhex(raw.group(1)))
+        except (ValueError, struct.error):
+            print('<corrupted record>')
+            continue
+
+        # A gap in the sequence numbers means lost console output
+        if prev_seq is not None and seq != (prev_seq + 1) & 0xFF:
+            print('... records missing')
+        prev_seq = seq
+        print(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,181 @@
+"""MCUBoot Bootloader Boot Phase Timing Decoder
+Copyright (c) 2026 Infineon Technologies AG
+
+Decodes the boot timing record that the Bootloader app (USE_BOOT_TIMING=1)
+places into the MCUboot shared data area. Accepts either a binary dump of the
+shared data area (e.g. "dump binary memory shared.bin 0x08000800 0x08000a00"
+in GDB) or a serial console log of the Blinky app with a BOOT_TIMING_RAW line.
+"""
+
+import sys
+import getopt
+import re
+import struct
+from enum import Enum
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+
+
+# Shared data area layout, see common/boot_shared_data.h
+SHARED_DATA_TLV_MAGIC = 0x2016
+SHARED_DATA_MAJOR_CY = 0xC
+SHARED_DATA_MINOR_TIMING = 0x001
+TIMING_RECORD_VERSION = 1
+
+# Order of boot_timing_phase_t
+PHASES = ['start', 'bsp_init', 'retarget_io', 'qspi_init', 'boot_go',
+          'wdt_init', 'handoff']
+
+RAW_LINE_TAG = 'BOOT_TIMING_RAW:'
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.in_file = ''
+        self.raw = ''
+        self.clock_hz = None
+        self.csv = False
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -i <dump.bin|console.log> | -r <hex> [-f <clock_hz>] [-c]
+
+OPTIONS:
+-h  --help       Display the usage information
+-i  --ifile=     Binary dump of the shared data area or console log
+-r  --raw=       Hex string printed after BOOT_TIMING_RAW:
+-f  --freq=      Override the core clock in Hz stored in the record
+-c  --csv        Print CSV instead of a table
+'''
+
+        try:
+            opts, unused = getopt.getopt(
+                sys.argv[1:], 'hi:r:f:c',
+                ['help', 'ifile=', 'raw=', 'freq=', 'csv'])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        for opt, arg in opts:
+            if opt in ('-h', '--help'):
+                print(usage, file=sys.stderr)
+                sys.exit()
+            elif opt in ('-i', '--ifile'):
+                self.in_file = arg
+            elif opt in ('-r', '--raw'):
+                self.raw = arg
+            elif opt in ('-f', '--freq'):
+                self.clock_hz = int(arg, 0)
+            elif opt in ('-c', '--csv'):
+                self.csv = True
+
+        if (len(self.in_file) == 0) == (len(self.raw) == 0):
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def find_in_shared_area(data):
+    """Returns the timing record from a shared data area dump"""
+    magic, total = struct.unpack_from('<HH', data, 0)
+    if magic != SHARED_DATA_TLV_MAGIC:
+        raise ValueError('no shared data magic at the start of the dump')
+
+    total = min(total, len(data))
+    tlv_type = (SHARED_DATA_MAJOR_CY << 12) | SHARED_DATA_MINOR_TIMING
+    off = 4
+    while off + 4 <= total:
+        typ, size = struct.unpack_from('<HH', data, off)
+        off += 4
+        if typ == tlv_type:
+            return data[off:off + size]
+        off += size
+
+    raise ValueError('no boot timing record in the shared data area')
+
+
+def load_record(params):
+    """Returns the raw timing record selected by the command line"""
+    if params.raw:
+        return bytes.fromhex(params.raw.strip())
+
+    with open(params.in_file, 'rb') as in_f:
+        data = in_f.read()
+
+    if data[:2] == struct.pack('<H', SHARED_DATA_TLV_MAGIC):
+        return find_in_shared_area(data)
+
+    # Console log: take the last record, in case the log spans several boots
+    lines = re.findall(RAW_LINE_TAG + r'\s*([0-9a-fA-F]+)',
+                       data.decode('ascii', errors='replace'))
+    if not lines:
+        raise ValueError('no ' + RAW_LINE_TAG + ' line in the log')
+    return bytes.fromhex(lines[-1])
+
+
+def decode(record, clock_hz=None):
+    """Returns [(phase, cycles, us)] and the core clock"""
+    version, count, valid_mask, rec_clock = struct.unpack_from('<BBHI', record, 0)
+    if version != TIMING_RECORD_VERSION:
+        raise ValueError('unsupported record version ' + str(version))
+    if len(record) < 8 + 4 * count:
+        raise ValueError('truncated record')
+
+    stamps = struct.unpack_from('<' + str(count) + 'I', record, 8)
+    clock_hz = clock_hz or rec_clock
+    if not clock_hz:
+        raise ValueError('no core clock in the record, use --freq')
+
+    phases = []
+    prev = 0
+    for i in range(1, count):
+        if not valid_mask & (1 << i):
+            continue
+        # The counter is 32-bit, a single phase may wrap it once
+        cycles = (stamps[i] - prev) & 0xFFFFFFFF
+        name = PHASES[i] if i < len(PHASES) else 'phase_' + str(i)
+        phases.append((name, cycles, cycles * 1000000 // clock_hz))
+        prev = stamps[i]
+    return phases, clock_hz
+
+
+def main():
+    """Boot timing decoder"""
+    params = CmdLineParams()
+
+    try:
+        record = load_record(params)
+        phases, clock_hz = decode(record, params.clock_hz)
+    except OSError as err:
+        print('Cannot read', params.in_file, ':', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+    except (ValueError, struct.error) as err:
+        print('Cannot decode the boot timing record:', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    total_cycles = sum(p[1] for p in phases)
+    total_us = total_cycles * 1000000 // clock_hz
+
+    if params.csv:
+        print('phase,cycles,us,percent')
+        for name, cycles, usec in phases:
+            print('{},{},{},{:.1f}'.format(name, cycles, usec,
+                                           100.0 * cycles / max(total_cycles, 1)))
+        print('total,{},{},100.0'.format(total_cycles, total_us))
+        return
+
+    print('Core clock: {} Hz'.format(clock_hz))
+    print('{:<12} {:>12} {:>10} {:>7}'.format('phase', 'cycles', 'us', '%'))
+    for name, cycles, usec in phases:
+        print('{:<12} {:>12} {:>10} {:>6.1f}%'.format(
+            name, cycles, usec, 100.0 * cycles / max(total_cycles, 1)))
+    print('{:<12} {:>12} {:>10}'.format('total', total_cycles, total_us))
+
+
+if __name__ == '__main__':
+    main()
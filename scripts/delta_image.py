@@ -0,0 +1,360 @@
+"""MCUBoot Delta Upgrade Image Generator
+Copyright (c) 2026 Infineon Technologies AG
+
+Generates a patch (USE_DELTA_UPGRADE=1) that turns the signed image in the
+primary slot into a new signed image. The output starts with the header of
+bootloader_app/source/delta_upgrade.h, followed by the page index and the page
+operations. The Bootloader app checks the signature of the patched image and
+rewrites the primary slot in place, page by page.
+
+A page may only copy from old pages that the Bootloader app has not rewritten
+yet. Both page orders are tried, ascending for images that shrink and
+descending for images that grow, and the smaller patch is written.
+"""
+
+import sys
+import getopt
+import struct
+import hashlib
+from bisect import bisect_left
+from enum import Enum
+
+from ihex import read_hex, write_hex, HexError
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+    SIZE    = 4
+
+
+# Patch header, see delta_upgrade_header_t
+DELTA_UPGRADE_MAGIC = 0x50444D43
+DELTA_UPGRADE_VERSION = 1
+DELTA_UPGRADE_HEADER = '<IHHIIIIII32s'
+DELTA_FLAG_REVERSE = 1
+DELTA_PAGE_UNCHANGED = 0xFFFFFFFF
+
+# Page operations, see delta_upgrade.h
+DELTA_OP_COPY = 0x80
+DELTA_OP_MAX_LEN = 128
+
+# Pages at the end of the secondary slot reserved for the journal
+DELTA_JOURNAL_PAGES = 4
+
+# Shortest copy, a copy costs 2 to 6 bytes
+MIN_MATCH = 4
+# Candidates searched per position, trades speed for patch size
+MAX_CANDIDATES = 32
+
+IMAGE_MAGIC = 0x96f3b83d
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.old_file = ''
+        self.new_file = ''
+        self.out_file = ''
+        self.address = None
+        self.slot_size = None
+        self.page_size = 0x200
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -b <old.hex> -i <new.hex> -o <patch.hex> [-a <address>] [-s <slot_size>] [-p <page_size>]
+
+OPTIONS:
+-h  --help       Display the usage information
+-b  --base=      Signed image in the primary slot, Intel HEX or binary
+-i  --ifile=     New signed image, Intel HEX or binary
+-o  --ofile=     Patch, Intel HEX or binary (by extension)
+-a  --address=   Address of the output (default: address of the new image)
+-s  --slot-size= Secondary slot size, to check that the patch fits
+-p  --page-size= Page size of the Bootloader app (default: 0x200)
+'''
+
+        try:
+            opts, unused = getopt.getopt(sys.argv[1:], 'hb:i:o:a:s:p:',
+                                         ['help', 'base=', 'ifile=', 'ofile=',
+                                          'address=', 'slot-size=', 'page-size='])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        try:
+            for opt, arg in opts:
+                if opt in ('-h', '--help'):
+                    print(usage, file=sys.stderr)
+                    sys.exit()
+                elif opt in ('-b', '--base'):
+                    self.old_file = arg
+                elif opt in ('-i', '--ifile'):
+                    self.new_file = arg
+                elif opt in ('-o', '--ofile'):
+                    self.out_file = arg
+                elif opt in ('-a', '--address'):
+                    self.address = int(arg, 0)
+                elif opt in ('-s', '--slot-size'):
+                    self.slot_size = int(arg, 0)
+                elif opt in ('-p', '--page-size'):
+                    self.page_size = int(arg, 0)
+        except ValueError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if len(self.old_file) == 0 or len(self.new_file) == 0 or \
+           len(self.out_file) == 0 or self.page_size <= 0:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def read_image(path):
+    """Returns (address, bytes) of a signed image"""
+    if path.lower().endswith('.hex'):
+        address, image = read_hex(path)
+    else:
+        address = 0
+        with open(path, 'rb') as in_f:
+            image = in_f.read()
+
+    if len(image) < 32 or struct.unpack_from('<I', image)[0] != IMAGE_MAGIC:
+        raise HexError(f'{path} is not a signed MCUboot image')
+    return address, image
+
+
+def zigzag(value):
+    """LEB128 of the zigzag-encoded signed value"""
+    value = (value << 1) ^ (value >> 31)
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+class Matcher:
+    """Finds copies from the old image with an index of its 4-byte prefixes"""
+
+    def __init__(self, old):
+        self.old = old
+        self.index = {}
+        for pos in range(len(old) - MIN_MATCH + 1):
+            self.index.setdefault(old[pos:pos + MIN_MATCH], []).append(pos)
+
+    def match_len(self, src, new, dst, limit, src_end):
+        """Length of the common run of old[src:] and new[dst:]"""
+        limit = min(limit, src_end - src)
+        length = 0
+        while length < limit and self.old[src + length] == new[dst + length]:
+            length += 1
+        return length
+
+    def find(self, new, dst, limit, src_lo, src_hi, last_src):
+        """Longest copy for new[dst:dst+limit] from old[src_lo:src_hi], the
+        continuation of the previous copy is tried first"""
+        best_len, best_src = 0, 0
+
+        if src_lo <= last_src < src_hi:
+            best_len = self.match_len(last_src, new, dst, limit, src_hi)
+            best_src = last_src
+        if best_len == limit or limit < MIN_MATCH:
+            return best_len, best_src
+
+        cands = self.index.get(new[dst:dst + MIN_MATCH], [])
+        lo = bisect_left(cands, src_lo)
+        hi = bisect_left(cands, src_hi)
+        # The candidates nearest to the same offset first
+        mid = min(max(bisect_left(cands, dst), lo), hi)
+        order = []
+        left, right = mid - 1, mid
+        while len(order) < MAX_CANDIDATES and (left >= lo or right < hi):
+            if right < hi:
+                order.append(cands[right])
+                right += 1
+            if left >= lo:
+                order.append(cands[left])
+                left -= 1
+
+        for src in order:
+            length = self.match_len(src, new, dst, limit, src_hi)
+            if length > best_len:
+                best_len, best_src = length, src
+                if length == limit:
+                    break
+
+        return best_len, best_src
+
+
+def encode_page(matcher, new, page, page_size, src_lo, src_hi):
+    """Operations of one page, copies only from old[src_lo:src_hi]"""
+    start = page * page_size
+    end = min(start + page_size, len(new))
+    ops = bytearray()
+    literal = bytearray()
+    last_src = -1
+    pos = start
+
+    def flush():
+        for i in range(0, len(literal), DELTA_OP_MAX_LEN):
+            part = literal[i:i + DELTA_OP_MAX_LEN]
+            ops.append(len(part) - 1)
+            ops.extend(part)
+        literal.clear()
+
+    while pos < end:
+        length, src = matcher.find(new, pos, end - pos, src_lo, src_hi, last_src)
+        if length >= MIN_MATCH:
+            flush()
+            while length > 0:
+                part = min(length, DELTA_OP_MAX_LEN)
+                ops.append(DELTA_OP_COPY | (part - 1))
+                ops.extend(zigzag(src - pos))
+                pos += part
+                src += part
+                length -= part
+            last_src = src
+        else:
+            literal.append(new[pos])
+            pos += 1
+            last_src = last_src + 1 if last_src >= 0 else -1
+    flush()
+
+    return bytes(ops)
+
+
+def make_patch(matcher, old, new, page_size, reverse):
+    """Returns (flags, index, operations) for one page order"""
+    pages = (len(new) + page_size - 1) // page_size
+    index = []
+    ops = bytearray()
+
+    for page in range(pages):
+        start = page * page_size
+        end = start + page_size
+        if end <= len(new) and end <= len(old) and new[start:end] == old[start:end]:
+            index.append(DELTA_PAGE_UNCHANGED)
+            continue
+
+        # Pages rewritten in earlier steps hold the new image already
+        if reverse:
+            src_hi = min(len(old), end)
+            page_ops = encode_page(matcher, new, page, page_size, 0, src_hi)
+            if pages * page_size < len(old):
+                alt = encode_page(matcher, new, page, page_size,
+                                  pages * page_size, len(old))
+                page_ops = min(page_ops, alt, key=len)
+        else:
+            page_ops = encode_page(matcher, new, page, page_size, start, len(old))
+
+        index.append(len(ops))
+        ops += page_ops
+
+    return (DELTA_FLAG_REVERSE if reverse else 0), index, bytes(ops)
+
+
+def apply_patch(old, new_size, page_size, flags, index, ops, erased=0xFF):
+    """Reference in-place patcher, used to check the output"""
+    pages = len(index)
+    flash = bytearray(old) + bytearray([erased]) * (pages * page_size)
+    order = range(pages - 1, -1, -1) if flags & DELTA_FLAG_REVERSE else range(pages)
+    done = set()
+
+    for page in order:
+        start = page * page_size
+        length = min(page_size, new_size - start)
+        out = bytearray()
+        if index[page] == DELTA_PAGE_UNCHANGED:
+            out += flash[start:start + length]
+        else:
+            pos = index[page]
+            while len(out) < length:
+                op = ops[pos]
+                pos += 1
+                count = (op & 0x7F) + 1
+                if op & DELTA_OP_COPY:
+                    value, shift = 0, 0
+                    while True:
+                        byte = ops[pos]
+                        pos += 1
+                        value |= (byte & 0x7F) << shift
+                        shift += 7
+                        if not byte & 0x80:
+                            break
+                    src = start + len(out) + ((value >> 1) ^ -(value & 1))
+                    assert not {src // page_size, (src + count - 1) // page_size} & done
+                    out += flash[src:src + count]
+                else:
+                    out += ops[pos:pos + count]
+                    pos += count
+        flash[start:start + page_size] = out + bytearray([erased]) * (page_size - length)
+        done.add(page)
+
+    return bytes(flash[:new_size])
+
+
+def main():
+    """Delta image generator"""
+    params = CmdLineParams()
+
+    try:
+        unused, old = read_image(params.old_file)
+        address, new = read_image(params.new_file)
+    except (OSError, HexError) as err:
+        print('Cannot read the images -', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    page_size = params.page_size
+    matcher = Matcher(old)
+    best = None
+    for reverse in (False, True):
+        flags, index, ops = make_patch(matcher, old, new, page_size, reverse)
+        if apply_patch(old, len(new), page_size, flags, index, ops) != new:
+            print('Internal error: patch check failed', file=sys.stderr)
+            sys.exit(Error.FORMAT.value)
+        if best is None or len(ops) < len(best[2]):
+            best = (flags, index, ops)
+
+    flags, index, ops = best
+    body = struct.pack(f'<{len(index)}I', *index) + ops
+    hdr_size = struct.calcsize(DELTA_UPGRADE_HEADER)
+    patch_id = struct.unpack('<I', hashlib.sha256(
+        hashlib.sha256(old).digest() + body).digest()[:4])[0]
+    out = struct.pack(DELTA_UPGRADE_HEADER, DELTA_UPGRADE_MAGIC,
+                      DELTA_UPGRADE_VERSION, hdr_size, flags, page_size,
+                      len(old), len(new), len(ops), patch_id,
+                      hashlib.sha256(old).digest()) + body
+
+    if params.slot_size is not None and \
+       len(out) > params.slot_size - DELTA_JOURNAL_PAGES * page_size:
+        print('Patch of', len(out), 'bytes does not fit the slot with its journal',
+              file=sys.stderr)
+        sys.exit(Error.SIZE.value)
+
+    if params.address is not None:
+        address = params.address
+
+    try:
+        if params.out_file.lower().endswith('.hex'):
+            write_hex(params.out_file, address, out)
+        else:
+            with open(params.out_file, 'wb') as out_f:
+                out_f.write(out)
+    except OSError as err:
+        print('Cannot write', params.out_file, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    changed = sum(1 for entry in index if entry != DELTA_PAGE_UNCHANGED)
+    print(f'{params.new_file}: {len(new)} bytes, patch {len(out)} bytes, '
+          f'{changed} of {len(index)} pages changed'
+          f'{" (descending order)" if flags & DELTA_FLAG_REVERSE else ""}')
+
+
+if __name__ == '__main__':
+    main()
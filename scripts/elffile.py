@@ -0,0 +1,142 @@
+"""Minimal ELF File Reader
+Copyright (c) 2026 Infineon Technologies AG
+
+Reads sections, program headers, and symbols of little-endian ELF files
+(32-bit Arm images of the Bootloader app and the Blinky app, and 64-bit host
+builds). Uses only the Python standard library, so the scripts in this
+directory run with the Python shipped with ModusToolbox.
+"""
+
+import struct
+from collections import namedtuple
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+PT_LOAD = 1
+
+Section = namedtuple('Section', 'name type flags addr offset size link')
+Segment = namedtuple('Segment', 'type offset vaddr paddr filesz memsz flags')
+Symbol = namedtuple('Symbol', 'name value size info shndx')
+
+
+class ElfError(Exception):
+    ''' Malformed or unsupported ELF file '''
+
+
+class ElfFile:
+    """Parsed ELF file"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as elf_f:
+            self.data = elf_f.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ElfError(path + ' is not an ELF file')
+        if self.data[5] != 1:
+            raise ElfError(path + ' is not little-endian')
+
+        self.is64 = self.data[4] == 2
+        if self.is64:
+            (self.entry, phoff, shoff, phentsize, phnum, shentsize, shnum,
+             shstrndx) = struct.unpack_from('<24xQQQ6xHHHHH', self.data, 0)
+        else:
+            (self.entry, phoff, shoff, phentsize, phnum, shentsize, shnum,
+             shstrndx) = struct.unpack_from('<24xIII6xHHHHH', self.data, 0)
+
+        self.sections = self._read_sections(shoff, shentsize, shnum, shstrndx)
+        self.segments = self._read_segments(phoff, phentsize, phnum)
+        self._symbols = None
+
+    def _read_sections(self, shoff, shentsize, shnum, shstrndx):
+        raw = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if self.is64:
+                raw.append(struct.unpack_from('<IIQQQQI', self.data, off))
+            else:
+                raw.append(struct.unpack_from('<IIIIIII', self.data, off))
+
+        if not raw:
+            return []
+        strtab_off = raw[shstrndx][4]
+        return [Section(self._cstring(strtab_off + r[0]), *r[1:]) for r in raw]
+
+    def _read_segments(self, phoff, phentsize, phnum):
+        segments = []
+        for i in range(phnum):
+            off = phoff + i * phentsize
+            if self.is64:
+                typ, flags, offset, vaddr, paddr, filesz, memsz = \
+                    struct.unpack_from('<IIQQQQQ', self.data, off)
+            else:
+                typ, offset, vaddr, paddr, filesz, memsz, flags = \
+                    struct.unpack_from('<IIIIIII', self.data, off)
+            segments.append(Segment(typ, offset, vaddr, paddr, filesz, memsz, flags))
+        return segments
+
+    def _cstring(self, off):
+        end = self.data.index(b'\0', off)
+        return self.data[off:end].decode('latin-1')
+
+    def section(self, name):
+        """Returns the section with the given name, or None"""
+        for sec in self.sections:
+            if sec.name == name:
+                return sec
+        return None
+
+    def section_data(self, name):
+        """Returns the contents of a section, or None if there is no such section"""
+        sec = self.section(name)
+        if sec is None or sec.type == SHT_NOBITS:
+            return None
+        return self.data[sec.offset:sec.offset + sec.size]
+
+    def load_segments(self):
+        """Returns [(load address, bytes)] of the PT_LOAD segments with contents"""
+        return [(seg.paddr, self.data[seg.offset:seg.offset + seg.filesz])
+                for seg in self.segments
+                if seg.type == PT_LOAD and seg.filesz > 0]
+
+    def read(self, addr, size):
+        """Reads bytes at a run-time address from the allocated sections"""
+        for sec in self.sections:
+            if (sec.flags & SHF_ALLOC and sec.type != SHT_NOBITS and
+                    sec.addr <= addr and addr + size <= sec.addr + sec.size):
+                off = sec.offset + addr - sec.addr
+                return self.data[off:off + size]
+        return None
+
+    def read_cstring(self, addr, max_len=256):
+        """Reads a NUL-terminated string at a run-time address, or None"""
+        for sec in self.sections:
+            if (sec.flags & SHF_ALLOC and sec.type != SHT_NOBITS and
+                    sec.addr <= addr < sec.addr + sec.size):
+                off = sec.offset + addr - sec.addr
+                end = min(sec.offset + sec.size, off + max_len)
+                raw = self.data[off:end]
+                return raw.split(b'\0', 1)[0].decode('latin-1')
+        return None
+
+    def symbols(self):
+        """Returns the entries of .symtab"""
+        if self._symbols is not None:
+            return self._symbols
+
+        self._symbols = []
+        for sec in self.sections:
+            if sec.type != SHT_SYMTAB:
+                continue
+            strtab = self.sections[sec.link]
+            entsize = 24 if self.is64 else 16
+            for off in range(sec.offset, sec.offset + sec.size, entsize):
+                if self.is64:
+                    name, info, _, shndx, value, size = \
+                        struct.unpack_from('<IBBHQQ', self.data, off)
+                else:
+                    name, value, size, info, _, shndx = \
+                        struct.unpack_from('<IIIBBH', self.data, off)
+                self._symbols.append(Symbol(self._cstring(strtab.offset + name),
+                                            value, size, info, shndx))
+        return self._symbols
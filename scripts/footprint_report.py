@@ -0,0 +1,349 @@
+"""MCUBoot Bootloader Footprint Report
+Copyright (c) 2026 Infineon Technologies AG
+
+Attributes the flash and RAM of the Bootloader app to its components (MCUboot,
+mbedTLS, HAL/PDL, retarget-io, ...) from the GNU linker map file, and the
+largest stack frame of each component from the .su files of -fstack-usage.
+Compares the result against a baseline and exits with a non-zero code when
+a component grew by more than the threshold, so the bootloader does not only
+fail at the link when it runs out of its flash or RAM budget.
+"""
+
+import sys
+import getopt
+import json
+import os
+import re
+from enum import Enum
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG         = 1
+    IO          = 2
+    FORMAT      = 3
+    REGRESSION  = 4
+
+
+# Memory regions of linker_bootloader.ld
+FLASH_REGION = 'flash'
+RAM_REGION = 'ram'
+
+# Output sections that are not allocated by any component: the heap takes
+# the rest of the RAM up to the stack, the stack has a fixed size
+HEAP_SECTIONS = ('.heap',)
+STACK_SECTIONS = ('.stack_dummy',)
+
+# The first component whose pattern matches the path of an object file (or
+# of a .su file, which the compiler writes next to it) owns its sections.
+# mbedTLS is a submodule of MCUboot, so it is checked first
+COMPONENTS = (
+    ('mbedtls',     r'/mbedtls/'),
+    ('mcuboot',     r'/mcuboot/'),
+    ('retarget-io', r'/retarget-io/'),
+    ('hal/pdl',     r'/(mtb-pdl-cat1|mtb-hal-cat1|core-lib)/'),
+    ('bsp',         r'/(bsps|TARGET_[^/]*|GeneratedSource)/'),
+    ('app',         r'(^|/)source/'),
+    ('toolchain',   r'\.a\('),
+)
+OTHER = 'other'
+FILL = 'fill'
+
+THRESHOLD_DEFAULT = 256
+
+MEMORY_LINE = re.compile(r'^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)')
+SECTION_LINE = re.compile(r'^(\s?)(\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)'
+                          r'(?:\s+load address\s+(0x[0-9a-fA-F]+)|\s+(.*))?)?\s*$')
+ADDR_LINE = re.compile(r'^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)'
+                       r'(?:\s+load address\s+(0x[0-9a-fA-F]+)|\s+(.*))?\s*$')
+SU_LINE = re.compile(r'^(.*):(\S+)\t(\d+)\t(\S+)')
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.map_file = ''
+        self.stack_dir = None
+        self.baseline = None
+        self.update = False
+        self.threshold = THRESHOLD_DEFAULT
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -m <app.map> [-s <build_dir>] [-b <baseline.json>] [-t <bytes>] [-u]
+
+OPTIONS:
+-h  --help       Display the usage information
+-m  --map=       Linker map file of the Bootloader app
+-s  --stack_dir= Directory searched for the .su files of -fstack-usage
+-b  --baseline=  Footprint of the reference build. Not checked if the file
+                 does not exist
+-t  --threshold= Allowed growth of a component in bytes (default {})
+-u  --update     Write the footprint to the baseline instead of checking it
+'''.format(THRESHOLD_DEFAULT)
+
+        try:
+            opts, unused = getopt.getopt(
+                sys.argv[1:], 'hm:s:b:t:u',
+                ['help', 'map=', 'stack_dir=', 'baseline=', 'threshold=',
+                 'update'])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        for opt, arg in opts:
+            if opt in ('-h', '--help'):
+                print(usage, file=sys.stderr)
+                sys.exit()
+            elif opt in ('-m', '--map'):
+                self.map_file = arg
+            elif opt in ('-s', '--stack_dir'):
+                self.stack_dir = arg
+            elif opt in ('-b', '--baseline'):
+                self.baseline = arg
+            elif opt in ('-t', '--threshold'):
+                self.threshold = int(arg, 0)
+            elif opt in ('-u', '--update'):
+                self.update = True
+
+        if not self.map_file or (self.update and not self.baseline):
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def component_of(path):
+    """Component that owns an object file"""
+    path = path.replace('\\', '/')
+    for name, pattern in COMPONENTS:
+        if re.search(pattern, path):
+            return name
+    return OTHER
+
+
+def region_of(regions, addr):
+    """Name of the memory region that holds an address"""
+    for name, (origin, length) in regions.items():
+        if origin <= addr < origin + length:
+            return name
+    return None
+
+
+def read_map(path):
+    """Returns the memory regions {name: (origin, length)}, the footprint
+    {component: {'flash': bytes, 'ram': bytes}} and the sizes of the
+    heap and the stack"""
+    with open(path, encoding='UTF-8', errors='replace') as map_f:
+        lines = map_f.read().splitlines()
+
+    regions = {}
+    start = None
+    for num, line in enumerate(lines):
+        if line.startswith('Memory Configuration'):
+            for mem_line in lines[num + 1:]:
+                if mem_line.startswith('Linker script and memory map'):
+                    break
+                match = MEMORY_LINE.match(mem_line)
+                if match and match.group(1) != '*default*':
+                    regions[match.group(1)] = (int(match.group(2), 16),
+                                               int(match.group(3), 16))
+        elif line.startswith('Linker script and memory map'):
+            start = num + 1
+            break
+    if start is None or FLASH_REGION not in regions or \
+            RAM_REGION not in regions:
+        raise ValueError(path + ': no memory configuration with the ' +
+                         FLASH_REGION + ' and ' + RAM_REGION + ' regions')
+
+    footprint = {}
+    reserved = {'heap': 0, 'stack': 0}
+    out_name = None
+    out_load = None
+    pending = None
+    for line in lines[start:]:
+        if line.startswith('Cross Reference Table'):
+            break
+        if not line.strip():
+            continue
+        if pending is not None:
+            # The addresses of a long section name follow on the next line
+            match = ADDR_LINE.match(line)
+            if match is None:
+                pending = None
+                continue
+            indent, name = pending
+            pending = None
+            fields = match.groups()
+        else:
+            match = SECTION_LINE.match(line)
+            if match is None or match.group(2).startswith(('*(', '0x')) or \
+                    match.group(2) in ('KEEP', '*', 'LOAD', 'OUTPUT'):
+                continue
+            indent, name = match.group(1), match.group(2)
+            if match.group(3) is None:
+                if name.startswith('.') or name == '*fill*':
+                    pending = (indent, name)
+                continue
+            fields = match.groups()[2:]
+
+        addr, size, load, obj = int(fields[0], 16), int(fields[1], 16), \
+            fields[2], fields[3]
+        if not indent:
+            # Output section
+            out_name = name
+            out_load = region_of(regions, int(load, 16)) if load else None
+            if name in HEAP_SECTIONS:
+                reserved['heap'] += size
+            elif name in STACK_SECTIONS:
+                reserved['stack'] += size
+            continue
+        if size == 0 or out_name in HEAP_SECTIONS + STACK_SECTIONS:
+            continue
+
+        region = region_of(regions, addr)
+        owner = FILL if name == '*fill*' else component_of(obj or '')
+        usage = footprint.setdefault(owner, {'flash': 0, 'ram': 0})
+        if region == FLASH_REGION:
+            usage['flash'] += size
+        elif region == RAM_REGION:
+            usage['ram'] += size
+            # Initialized data is also copied from flash
+            if out_load == FLASH_REGION:
+                usage['flash'] += size
+
+    return regions, footprint, reserved
+
+
+def read_stack_usage(stack_dir):
+    """Returns {component: (largest frame, function)} of the .su files"""
+    frames = {}
+    for root, unused, files in os.walk(stack_dir):
+        for su_file in files:
+            if not su_file.endswith('.su'):
+                continue
+            path = os.path.join(root, su_file)
+            owner = component_of('/' + os.path.relpath(path, stack_dir))
+            with open(path, encoding='UTF-8', errors='replace') as su_f:
+                for line in su_f:
+                    match = SU_LINE.match(line)
+                    if match is None:
+                        continue
+                    frame = int(match.group(3))
+                    if frame > frames.get(owner, (-1, ''))[0]:
+                        frames[owner] = (frame, match.group(2))
+    return frames
+
+
+def compare(baseline, current, threshold):
+    """Returns [(component, kind, base, cur, verdict)] for every number
+    of the baseline and the current footprint"""
+    rows = []
+    for owner in list(baseline) + [c for c in current if c not in baseline]:
+        base = baseline.get(owner, {})
+        cur = current.get(owner, {})
+        for kind in ('flash', 'ram', 'stack'):
+            base_val = base.get(kind)
+            cur_val = cur.get(kind)
+            if base_val is None and cur_val is None:
+                continue
+            if base_val is None:
+                verdict = 'new' if cur_val <= threshold else 'GREW'
+            elif cur_val is None:
+                verdict = 'missing'
+            else:
+                verdict = 'GREW' if cur_val - base_val > threshold else 'ok'
+            rows.append((owner, kind, base_val, cur_val, verdict))
+    return rows
+
+
+def main():
+    """Footprint report"""
+    params = CmdLineParams()
+
+    try:
+        regions, footprint, reserved = read_map(params.map_file)
+        frames = read_stack_usage(params.stack_dir) \
+            if params.stack_dir is not None else {}
+    except OSError as err:
+        print('Cannot read the map file:', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+    except ValueError as err:
+        print('Cannot parse the map file:', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    for owner, (frame, unused) in frames.items():
+        footprint.setdefault(owner, {'flash': 0, 'ram': 0})['stack'] = frame
+    order = [c for c, unused in COMPONENTS] + [OTHER, FILL]
+    owners = sorted(footprint, key=order.index)
+
+    print('{:<12} {:>9} {:>9} {:>9}  {}'.format(
+        'component', 'flash', 'ram', 'stack', 'largest frame'))
+    for owner in owners:
+        usage = footprint[owner]
+        print('{:<12} {:>9} {:>9} {:>9}  {}'.format(
+            owner, usage['flash'], usage['ram'],
+            '-' if 'stack' not in usage else usage['stack'],
+            frames.get(owner, (0, ''))[1]))
+
+    flash_used = sum(u['flash'] for u in footprint.values())
+    ram_used = sum(u['ram'] for u in footprint.values())
+    flash_size = regions[FLASH_REGION][1]
+    ram_size = regions[RAM_REGION][1]
+    print('{:<12} {:>9} {:>9}'.format('total', flash_used, ram_used))
+    print('flash: {} of {} bytes, {} free'.format(
+        flash_used, flash_size, flash_size - flash_used))
+    print('ram:   {} of {} bytes, {} bytes stack, {} bytes heap'.format(
+        ram_used, ram_size, reserved['stack'], reserved['heap']))
+
+    current = {'components': footprint,
+               'total': {'flash': flash_used, 'ram': ram_used}}
+
+    if params.update:
+        try:
+            with open(params.baseline, 'w', encoding='UTF-8') as out_f:
+                json.dump(current, out_f, indent=4, sort_keys=True)
+                out_f.write('\n')
+        except OSError as err:
+            print('Cannot write the baseline:', err, file=sys.stderr)
+            sys.exit(Error.IO.value)
+        return
+
+    if params.baseline is None:
+        return
+    try:
+        with open(params.baseline, encoding='UTF-8') as in_f:
+            baseline = json.load(in_f)
+    except FileNotFoundError:
+        print('No baseline', params.baseline, '- store one with -u',
+              file=sys.stderr)
+        return
+    except (OSError, ValueError) as err:
+        print('Cannot read the baseline:', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    rows = compare(dict(baseline.get('components', {}),
+                        total=baseline.get('total', {})),
+                   dict(current['components'], total=current['total']),
+                   params.threshold)
+    changed = [r for r in rows if r[4] != 'ok' or r[2] != r[3]]
+    if changed:
+        print()
+        print('{:<12} {:<6} {:>9} {:>9} {:>9}'.format(
+            'component', '', 'baseline', 'current', 'change'))
+    for owner, kind, base_val, cur_val, verdict in changed:
+        print('{:<12} {:<6} {:>9} {:>9} {:>9}  {}'.format(
+            owner, kind,
+            '-' if base_val is None else base_val,
+            '-' if cur_val is None else cur_val,
+            '-' if None in (base_val, cur_val)
+            else '{:+d}'.format(cur_val - base_val),
+            verdict))
+
+    grew = [r for r in rows if r[4] == 'GREW']
+    if grew:
+        print('{} footprint(s) grew by more than {} bytes'.format(
+            len(grew), params.threshold), file=sys.stderr)
+        sys.exit(Error.REGRESSION.value)
+
+
+if __name__ == '__main__':
+    main()
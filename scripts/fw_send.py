@@ -0,0 +1,282 @@
+"""MCUBoot Firmware Sender
+Copyright (c) 2026 Infineon Technologies AG
+
+Sends a padded UPGRADE image to the firmware receiver of the Blinky app
+(USE_FW_RECEIVER=1) over a serial port. Only the signed image and the slot
+trailer are sent, see blinky_app/source/fw_receiver.h for the protocol.
+Uses only the Python standard library, the serial port is driven through
+termios (Linux and macOS).
+"""
+
+import os
+import sys
+import time
+import getopt
+import select
+import struct
+import termios
+import tty
+from enum import Enum
+
+from ihex import read_hex, HexError
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+    SIZE    = 4
+    REMOTE  = 5
+
+
+# Protocol, see fw_receiver.h
+FW_RECEIVER_MAGIC = 0x58525746
+FW_RECEIVER_START = '<IIIII'
+FW_RECEIVER_ACK = 0x06
+FW_RECEIVER_NAK = 0x15
+FW_RECEIVER_ERRORS = {
+    1: 'malformed start frame',
+    2: 'image does not fit the slot',
+    3: 'not an MCUboot image',
+    4: 'timeout',
+    5: 'flash write failed',
+    6: 'hash mismatch',
+    7: 'UART error',
+}
+
+# Blocks sent ahead of the ACKs, one per receive buffer of the device
+WINDOW = 2
+
+ROW_SIZE = 512
+BLOCK_SIZE_DEFAULT = 2048
+TRAILER_SIZE_DEFAULT = 0x1000
+BAUD_DEFAULT = 115200
+TIMEOUT_S = 5.0
+
+IMAGE_MAGIC = 0x96f3b83d
+TLV_INFO_MAGIC = 0x6907
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.port = ''
+        self.in_file = ''
+        self.baud = BAUD_DEFAULT
+        self.fast_baud = 0
+        self.block_size = BLOCK_SIZE_DEFAULT
+        self.trailer_size = TRAILER_SIZE_DEFAULT
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -p <port> -i <upgrade.hex> [-b <baud>] [-B <baud>] [-k <size>] [-t <size>]
+
+OPTIONS:
+-h  --help       Display the usage information
+-p  --port=      Serial port of the board, e.g. /dev/ttyACM0
+-i  --ifile=     Padded UPGRADE image, Intel HEX or binary
+-b  --baud=      Baud rate of the debug UART (default {})
+-B  --fast-baud= Baud rate of the transfer, if both sides support it
+-k  --block=     FW_RECEIVER_BLOCK_SIZE of the Blinky app (default {})
+-t  --trailer=   Bytes at the end of the slot that hold the trailer
+                 (default {:#x})
+'''.format(BAUD_DEFAULT, BLOCK_SIZE_DEFAULT, TRAILER_SIZE_DEFAULT)
+
+        try:
+            opts, unused = getopt.getopt(
+                sys.argv[1:], 'hp:i:b:B:k:t:',
+                ['help', 'port=', 'ifile=', 'baud=', 'fast-baud=', 'block=',
+                 'trailer='])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        try:
+            for opt, arg in opts:
+                if opt in ('-h', '--help'):
+                    print(usage, file=sys.stderr)
+                    sys.exit()
+                elif opt in ('-p', '--port'):
+                    self.port = arg
+                elif opt in ('-i', '--ifile'):
+                    self.in_file = arg
+                elif opt in ('-b', '--baud'):
+                    self.baud = int(arg, 0)
+                elif opt in ('-B', '--fast-baud'):
+                    self.fast_baud = int(arg, 0)
+                elif opt in ('-k', '--block'):
+                    self.block_size = int(arg, 0)
+                elif opt in ('-t', '--trailer'):
+                    self.trailer_size = int(arg, 0)
+        except ValueError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if not self.port or not self.in_file or self.block_size <= 0 or \
+                self.block_size % ROW_SIZE or self.trailer_size % ROW_SIZE:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+class RemoteError(Exception):
+    ''' NAK from the firmware receiver '''
+
+
+class SerialPort:
+    """Raw serial port through termios"""
+
+    def __init__(self, path, baud):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        self.set_baud(baud)
+        termios.tcflush(self.fd, termios.TCIFLUSH)
+
+    def set_baud(self, baud):
+        """Changes the baud rate once the pending output is sent"""
+        speed = getattr(termios, 'B' + str(baud), None)
+        if speed is None:
+            raise ValueError('unsupported baud rate ' + str(baud))
+        termios.tcdrain(self.fd)
+        attr = termios.tcgetattr(self.fd)
+        attr[4] = attr[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            view = view[os.write(self.fd, view):]
+
+    def read_byte(self, timeout):
+        ready, unused, unused = select.select([self.fd], [], [], timeout)
+        if not ready:
+            raise TimeoutError('no response from the board')
+        data = os.read(self.fd, 1)
+        if not data:
+            raise OSError('serial port closed')
+        return data[0]
+
+    def close(self):
+        os.close(self.fd)
+
+
+def image_size(image):
+    """Returns the size of the signed image, from the header to the last TLV"""
+    if len(image) < 32:
+        raise ValueError('not a signed MCUboot image')
+    magic, unused, hdr_size, protect_size, img_size = \
+        struct.unpack_from('<IIHHI', image)
+    if magic != IMAGE_MAGIC:
+        raise ValueError('not a signed MCUboot image')
+    tlv_off = hdr_size + img_size + protect_size
+    if tlv_off + 4 > len(image):
+        raise ValueError('truncated image')
+    info_magic, tlv_tot = struct.unpack_from('<HH', image, tlv_off)
+    if info_magic != TLV_INFO_MAGIC or tlv_off + tlv_tot > len(image):
+        raise ValueError('no TLV area after the image')
+    return tlv_off + tlv_tot
+
+
+def wait_reply(port):
+    """Waits for an ACK, raises RemoteError for a NAK"""
+    reply = port.read_byte(TIMEOUT_S)
+    if reply == FW_RECEIVER_NAK:
+        code = port.read_byte(TIMEOUT_S)
+        raise RemoteError(FW_RECEIVER_ERRORS.get(code, 'error ' + str(code)))
+    if reply != FW_RECEIVER_ACK:
+        raise RemoteError('unexpected response 0x{:02x}'.format(reply))
+
+
+def send(port, params, slot, size, trailer_size):
+    """Runs one transfer, returns the number of bytes sent"""
+    port.write(struct.pack(FW_RECEIVER_START, FW_RECEIVER_MAGIC, len(slot),
+                           size, trailer_size, params.fast_baud))
+    wait_reply(port)
+    if params.fast_baud:
+        port.set_baud(params.fast_baud)
+
+    try:
+        # The device acknowledges every block once it is programmed, and
+        # receives the next one meanwhile
+        blocks = [slot[pos:min(pos + params.block_size, size)]
+                  for pos in range(0, size, params.block_size)]
+        pending = 0
+        for block in blocks:
+            if pending == WINDOW:
+                wait_reply(port)
+                pending -= 1
+            port.write(block)
+            pending += 1
+        for unused in range(pending):
+            wait_reply(port)
+
+        # Result of the hash check
+        wait_reply(port)
+
+        trailer = slot[len(slot) - trailer_size:]
+        for pos in range(0, trailer_size, params.block_size):
+            port.write(trailer[pos:pos + params.block_size])
+            wait_reply(port)
+    finally:
+        if params.fast_baud:
+            port.set_baud(params.baud)
+
+    return size + trailer_size
+
+
+def main():
+    """Firmware sender"""
+    params = CmdLineParams()
+
+    try:
+        if params.in_file.lower().endswith('.hex'):
+            unused, slot = read_hex(params.in_file)
+        else:
+            with open(params.in_file, 'rb') as in_f:
+                slot = in_f.read()
+    except (OSError, HexError) as err:
+        print('Cannot read', params.in_file, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    try:
+        size = image_size(slot)
+    except (ValueError, struct.error) as err:
+        print(params.in_file, '-', err, file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    trailer_size = params.trailer_size
+    row_end = (size + ROW_SIZE - 1) // ROW_SIZE * ROW_SIZE
+    if len(slot) == size:
+        print(params.in_file, 'is not padded to the slot size, use the '
+              'UPGRADE image', file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+    if row_end > len(slot) - trailer_size:
+        print('The image overlaps the last', hex(trailer_size),
+              'bytes of the slot, use a smaller trailer size', file=sys.stderr)
+        sys.exit(Error.SIZE.value)
+
+    try:
+        port = SerialPort(params.port, params.baud)
+    except (OSError, termios.error, ValueError) as err:
+        print('Cannot open', params.port, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    start = time.monotonic()
+    try:
+        sent = send(port, params, slot, size, trailer_size)
+    except RemoteError as err:
+        print('Transfer rejected:', err, file=sys.stderr)
+        sys.exit(Error.REMOTE.value)
+    except (OSError, termios.error, ValueError) as err:
+        print('Transfer failed:', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+    finally:
+        port.close()
+    elapsed = time.monotonic() - start
+
+    print('{}: {} bytes in {:.2f} s ({:.0f} bytes/s)'.format(
+        params.in_file, sent, elapsed, sent / elapsed if elapsed else 0.0))
+
+
+if __name__ == '__main__':
+    main()
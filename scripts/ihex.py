@@ -0,0 +1,83 @@
+"""Minimal Intel HEX Reader and Writer
+Copyright (c) 2026 Infineon Technologies AG
+
+Converts between Intel HEX files and (start address, bytes) pairs for the
+scripts in this directory. Uses only the Python standard library.
+"""
+
+import struct
+
+
+class HexError(Exception):
+    ''' Malformed Intel HEX file '''
+
+
+def read_hex(path, fill=0xFF):
+    """Returns (start address, bytes) of an Intel HEX file. Gaps between the
+    data records are filled with 'fill'."""
+    chunks = {}
+    base = 0
+
+    with open(path, 'r', encoding='ascii') as hex_f:
+        for num, line in enumerate(hex_f, 1):
+            line = line.strip()
+            if not line:
+                continue
+            if not line.startswith(':'):
+                raise HexError(f'{path}:{num}: not an Intel HEX record')
+            try:
+                rec = bytes.fromhex(line[1:])
+            except ValueError as err:
+                raise HexError(f'{path}:{num}: {err}') from err
+            if len(rec) < 5 or len(rec) != rec[0] + 5 or sum(rec) & 0xFF:
+                raise HexError(f'{path}:{num}: bad length or checksum')
+
+            count, offset, rtype = rec[0], struct.unpack('>H', rec[1:3])[0], rec[3]
+            data = rec[4:4 + count]
+            if rtype == 0x00:
+                chunks[base + offset] = data
+            elif rtype == 0x01:
+                break
+            elif rtype == 0x02:
+                base = struct.unpack('>H', data)[0] << 4
+            elif rtype == 0x04:
+                base = struct.unpack('>H', data)[0] << 16
+
+    if not chunks:
+        raise HexError(f'{path}: no data')
+
+    start = min(chunks)
+    end = max(addr + len(data) for addr, data in chunks.items())
+    image = bytearray([fill]) * (end - start)
+    for addr, data in chunks.items():
+        image[addr - start:addr - start + len(data)] = data
+    return start, bytes(image)
+
+
+def _record(rtype, offset, data):
+    rec = bytes([len(data)]) + struct.pack('>H', offset) + bytes([rtype]) + data
+    return ':' + (rec + bytes([-sum(rec) & 0xFF])).hex().upper() + '\n'
+
+
+def write_hex(path, start, data, width=16):
+    """Writes bytes to an Intel HEX file at the given start address"""
+    write_hex_segments(path, [(start, data)], width)
+
+
+def write_hex_segments(path, segments, width=16):
+    """Writes [(start address, bytes)] to an Intel HEX file. The gaps between
+    the segments get no data records, like objcopy -O ihex."""
+    upper = None
+    with open(path, 'w', encoding='ascii') as hex_f:
+        for start, data in sorted(segments):
+            pos = 0
+            while pos < len(data):
+                addr = start + pos
+                if addr >> 16 != upper:
+                    upper = addr >> 16
+                    hex_f.write(_record(0x04, 0, struct.pack('>H', upper)))
+                # Records do not cross a 64 KB boundary
+                size = min(width, len(data) - pos, 0x10000 - (addr & 0xFFFF))
+                hex_f.write(_record(0x00, addr & 0xFFFF, data[pos:pos + size]))
+                pos += size
+        hex_f.write(_record(0x01, 0, b''))
@@ -0,0 +1,120 @@
+"""MCUBoot Signed Image Size Check
+Copyright (c) 2026 Infineon Technologies AG
+
+Checks that a signed image, from its header up to the end of its TLV area,
+fits in a given size. The padding and the trailer that the imgtool adds with
+--pad are not counted. Used by the post-build step of blinky_app/Makefile for
+swap using move, which needs one free sector at the end of the primary slot.
+"""
+
+import sys
+import getopt
+import struct
+from enum import Enum
+
+from ihex import read_hex, HexError
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+    SIZE    = 4
+
+
+IMAGE_MAGIC = 0x96f3b83d
+TLV_INFO_MAGIC = 0x6907
+
+# ih_magic, ih_load_addr, ih_hdr_size, ih_protect_tlv_size, ih_img_size
+IMAGE_HEADER = '<IIHHI'
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.in_file = ''
+        self.max_size = None
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -i <signed.hex> -m <max_size>
+
+OPTIONS:
+-h  --help       Display the usage information
+-i  --ifile=     Signed image, Intel HEX or binary
+-m  --max-size=  Largest allowed image size, header and TLVs included
+'''
+
+        try:
+            opts, unused = getopt.getopt(sys.argv[1:], 'hi:m:',
+                                         ['help', 'ifile=', 'max-size='])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        try:
+            for opt, arg in opts:
+                if opt in ('-h', '--help'):
+                    print(usage, file=sys.stderr)
+                    sys.exit()
+                elif opt in ('-i', '--ifile'):
+                    self.in_file = arg
+                elif opt in ('-m', '--max-size'):
+                    self.max_size = int(arg, 0)
+        except ValueError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if len(self.in_file) == 0 or self.max_size is None:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def image_size(image):
+    """Returns the size of a signed image up to the end of its TLV area, or
+    None if it is not a signed MCUboot image"""
+    if len(image) < struct.calcsize(IMAGE_HEADER):
+        return None
+    magic, _, hdr_size, prot_size, img_size = struct.unpack_from(IMAGE_HEADER, image)
+    if magic != IMAGE_MAGIC:
+        return None
+
+    off = hdr_size + img_size + prot_size
+    if off + 4 > len(image):
+        return None
+    magic, tlv_size = struct.unpack_from('<HH', image, off)
+    if magic != TLV_INFO_MAGIC:
+        return None
+    return off + tlv_size
+
+
+def main():
+    """Signed image size check"""
+    params = CmdLineParams()
+
+    try:
+        if params.in_file.lower().endswith('.hex'):
+            _, image = read_hex(params.in_file)
+        else:
+            with open(params.in_file, 'rb') as in_f:
+                image = in_f.read()
+    except (OSError, HexError) as err:
+        print('Cannot read', params.in_file, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    size = image_size(image)
+    if size is None:
+        print(params.in_file, 'is not a signed MCUboot image', file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    if size > params.max_size:
+        print(f'{params.in_file}: image of 0x{size:x} bytes exceeds 0x{params.max_size:x} bytes',
+              file=sys.stderr)
+        sys.exit(Error.SIZE.value)
+
+    print(f'{params.in_file}: 0x{size:x} of 0x{params.max_size:x} bytes')
+
+
+if __name__ == '__main__':
+    main()
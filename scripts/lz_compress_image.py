@@ -0,0 +1,222 @@
+"""MCUBoot Compressed Upgrade Image Generator
+Copyright (c) 2026 Infineon Technologies AG
+
+Compresses a signed upgrade image (USE_COMPRESSED_UPGRADE=1) for the secondary
+slot. The output starts with the container header of
+bootloader_app/source/lz_upgrade.h, followed by the LZSS stream of the whole
+signed image. The Bootloader app checks the signature of the decompressed
+image and decompresses it into the primary slot.
+"""
+
+import sys
+import getopt
+import struct
+from enum import Enum
+
+from ihex import read_hex, write_hex, HexError
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+    SIZE    = 4
+
+
+# Container header, see lz_upgrade_header_t
+LZ_UPGRADE_MAGIC = 0x5A4C4D43
+LZ_UPGRADE_VERSION = 1
+LZ_UPGRADE_HEADER = '<IHHII'
+
+# LZSS parameters, see lz_upgrade.h
+LZ_WINDOW_SIZE = 4096
+LZ_MIN_MATCH = 3
+LZ_MAX_MATCH = 18
+
+# Longest hash chain searched per position, trades speed for ratio
+MAX_CHAIN = 256
+
+IMAGE_MAGIC = 0x96f3b83d
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.in_file = ''
+        self.out_file = ''
+        self.address = None
+        self.slot_size = None
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -i <signed.hex> -o <compressed.hex> [-a <address>] [-s <slot_size>]
+
+OPTIONS:
+-h  --help       Display the usage information
+-i  --ifile=     Signed image, Intel HEX or binary
+-o  --ofile=     Compressed image, Intel HEX or binary (by extension)
+-a  --address=   Address of the output (default: address of the input)
+-s  --slot-size= Secondary slot size, to check that the image fits
+'''
+
+        try:
+            opts, unused = getopt.getopt(sys.argv[1:], 'hi:o:a:s:',
+                                         ['help', 'ifile=', 'ofile=',
+                                          'address=', 'slot-size='])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        try:
+            for opt, arg in opts:
+                if opt in ('-h', '--help'):
+                    print(usage, file=sys.stderr)
+                    sys.exit()
+                elif opt in ('-i', '--ifile'):
+                    self.in_file = arg
+                elif opt in ('-o', '--ofile'):
+                    self.out_file = arg
+                elif opt in ('-a', '--address'):
+                    self.address = int(arg, 0)
+                elif opt in ('-s', '--slot-size'):
+                    self.slot_size = int(arg, 0)
+        except ValueError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if len(self.in_file) == 0 or len(self.out_file) == 0:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+
+def lzss_compress(data):
+    """LZSS with a 4 KB window and 3..18 byte matches, greedy parsing with
+    hash chains over 3-byte prefixes"""
+    out = bytearray()
+    head = {}
+    prev = [0] * len(data)
+    pos = 0
+    flags_pos = 0
+    bit = 8
+
+    def insert(i):
+        if i + LZ_MIN_MATCH <= len(data):
+            key = data[i:i + LZ_MIN_MATCH]
+            prev[i] = head.get(key, -1)
+            head[key] = i
+
+    while pos < len(data):
+        if bit == 8:
+            flags_pos = len(out)
+            out.append(0)
+            bit = 0
+
+        best_len = 0
+        best_dist = 0
+        max_len = min(LZ_MAX_MATCH, len(data) - pos)
+        if max_len >= LZ_MIN_MATCH:
+            cand = head.get(data[pos:pos + LZ_MIN_MATCH], -1)
+            chain = MAX_CHAIN
+            while cand >= 0 and pos - cand <= LZ_WINDOW_SIZE and chain > 0:
+                length = 0
+                while length < max_len and data[cand + length] == data[pos + length]:
+                    length += 1
+                if length > best_len:
+                    best_len = length
+                    best_dist = pos - cand
+                    if length == max_len:
+                        break
+                cand = prev[cand]
+                chain -= 1
+
+        if best_len >= LZ_MIN_MATCH:
+            token = (best_dist - 1) | ((best_len - LZ_MIN_MATCH) << 12)
+            out += struct.pack('<H', token)
+            for i in range(pos, pos + best_len):
+                insert(i)
+            pos += best_len
+        else:
+            out[flags_pos] |= 1 << bit
+            out.append(data[pos])
+            insert(pos)
+            pos += 1
+        bit += 1
+
+    return bytes(out)
+
+
+def lzss_decompress(comp, raw_size):
+    """Reference decoder, used to check the output"""
+    out = bytearray()
+    pos = 0
+    flags = 0
+    while len(out) < raw_size:
+        if flags <= 1:
+            flags = 0x100 | comp[pos]
+            pos += 1
+        if flags & 1:
+            out.append(comp[pos])
+            pos += 1
+        else:
+            token = struct.unpack_from('<H', comp, pos)[0]
+            pos += 2
+            dist = (token & 0xFFF) + 1
+            for _ in range((token >> 12) + LZ_MIN_MATCH):
+                out.append(out[-dist])
+        flags >>= 1
+    return bytes(out)
+
+
+def main():
+    """Compressed image generator"""
+    params = CmdLineParams()
+
+    try:
+        if params.in_file.lower().endswith('.hex'):
+            address, image = read_hex(params.in_file)
+        else:
+            address = 0
+            with open(params.in_file, 'rb') as in_f:
+                image = in_f.read()
+    except (OSError, HexError) as err:
+        print('Cannot read', params.in_file, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    if len(image) < 32 or struct.unpack_from('<I', image)[0] != IMAGE_MAGIC:
+        print(params.in_file, 'is not a signed MCUboot image', file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    comp = lzss_compress(image)
+    if lzss_decompress(comp, len(image)) != image:
+        print('Internal error: round trip mismatch', file=sys.stderr)
+        sys.exit(Error.FORMAT.value)
+
+    hdr_size = struct.calcsize(LZ_UPGRADE_HEADER)
+    out = struct.pack(LZ_UPGRADE_HEADER, LZ_UPGRADE_MAGIC, LZ_UPGRADE_VERSION,
+                      hdr_size, len(image), len(comp)) + comp
+
+    if params.slot_size is not None and len(out) > params.slot_size:
+        print('Compressed image of', len(out), 'bytes does not fit the slot',
+              file=sys.stderr)
+        sys.exit(Error.SIZE.value)
+
+    if params.address is not None:
+        address = params.address
+
+    try:
+        if params.out_file.lower().endswith('.hex'):
+            write_hex(params.out_file, address, out)
+        else:
+            with open(params.out_file, 'wb') as out_f:
+                out_f.write(out)
+    except OSError as err:
+        print('Cannot write', params.out_file, '-', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    print(f'{params.in_file}: {len(image)} -> {len(out)} bytes '
+          f'({100 * len(out) // len(image)}%)')
+
+
+if __name__ == '__main__':
+    main()
@@ -5,6 +5,11 @@ Copyright (c) 2022 Infineon Technologies AG
 import sys
 import getopt
 import json
+import copy
+import hashlib
+import io
+import contextlib
+import tempfile
 from enum import Enum
 import os.path
 
@@ -20,6 +25,16 @@ class Error(Enum):
 
 SERVICE_APP_SZ = 0x20
 
+# MCUboot image header, the vector table of the application follows it
+CY_IMG_HDR_SIZE = 0x400
+
+# Upgrade modes of the layout solver
+SOLVE_MODES = ('overwrite', 'swap', 'swap_move', 'direct_xip')
+
+# Default scratch area of the solved swap layouts in erase sectors, as in
+# psoc61_swap_single.json
+SOLVE_SCRATCH_SECTORS = 16
+
 c_array = 'flash_areas'
 
 # Supported Platforms
@@ -233,6 +248,31 @@ def is_same_mem(fa1addr, fa2addr):
     return (fa1addr & mask) == (fa2addr & mask)
 
 
+def file_digest(path):
+    """SHA-256 of a file, empty when there is no such file"""
+    if not path:
+        return ''
+    try:
+        with open(path, 'rb') as in_f:
+            return hashlib.sha256(in_f.read()).hexdigest()
+    except OSError:
+        return ''
+
+
+def write_if_changed(path, content):
+    """Write a generated file, unless it already has this content. Keeping
+    the timestamp of an unchanged file avoids rebuilding its dependents"""
+    try:
+        with open(path, encoding='UTF-8') as in_f:
+            if in_f.read() == content:
+                return
+    except (FileNotFoundError, OSError):
+        pass
+
+    with open(path, "w", encoding='UTF-8') as out_f:
+        out_f.write(content)
+
+
 class CmdLineParams:
     """Command line parameters"""
 
@@ -245,9 +285,20 @@ class CmdLineParams:
         self.policy = None
         self.set_core = False
         self.image_boot_config = False
+        self.mk_file = None
+        self.apps = []
+        self.solve = None
+        self.boot_size = None
+        self.images = 1
+        self.weights = None
+        self.reserve = 0
+        self.scratch_size = None
 
         usage = 'USAGE:\n' + sys.argv[0] + \
                 ''' -p <platform> -i <flash_map.json> -o <memorymap.c> -a <memorymap.h> -d <img_id> -c <policy.json>
+                 [-k <memorymap.mk>] [-b <img_id>,<memorymap.h>,<memorymap.mk>]
+       ''' + sys.argv[0] + ''' -p <platform> -S <mode> --boot_size=<size> [-o <flash_map.json>]
+                 [--images=<n>] [--weights=<w1,w2,...>] [--reserve=<size>] [--scratch_size=<size>]
 
 OPTIONS:
 -h  --help       Display the usage information
@@ -259,12 +310,29 @@ OPTIONS:
 -c  --policy     Policy file in JSON format
 -m  --core       Detect and set Cortex-M CORE
 -x  --image_boot_config Generate image boot config structure
+-k  --mk_file=   Write the make variables to this file instead of stdout.
+                 The inputs are fingerprinted in <mk_file>.stamp, and nothing
+                 is generated again while they do not change
+-b  --app=       Also generate the files of an application in the same run:
+                 <img_id>,<memorymap.h>,<memorymap.mk>. Can be repeated
+
+LAYOUT SOLVER:
+-S  --solve=     Write the JSON flash map with the largest slots for this
+                 upgrade mode to -o, or to stdout: overwrite, swap,
+                 swap_move or direct_xip
+    --boot_size= Size of the bootloader
+    --images=    Number of images (default 1)
+    --weights=   Relative slot sizes of the images, e.g. 2,1 (default equal)
+    --reserve=   Bytes to leave free at the end of the internal flash
+    --scratch_size= Size of the swap scratch area (default 16 erase sectors)
 '''
 
         try:
             opts, unused = getopt.getopt(
-                sys.argv[1:], 'hi:o:a:p:d:c:x:m',
-                ['help', 'platform=', 'ifile=', 'ofile=', "fa_file=", 'img_id=', 'policy=', 'core', 'image_boot_config'])
+                sys.argv[1:], 'hi:o:a:p:d:c:x:mk:b:S:',
+                ['help', 'platform=', 'ifile=', 'ofile=', "fa_file=", 'img_id=', 'policy=', 'core', 'image_boot_config',
+                 'mk_file=', 'app=', 'solve=', 'boot_size=', 'images=', 'weights=', 'reserve=',
+                 'scratch_size='])
         except getopt.GetoptError:
             print(usage, file=sys.stderr)
             sys.exit(Error.ARG)
@@ -289,11 +357,72 @@ OPTIONS:
                 self.set_core = True
             elif opt in ('x', '--image_boot_config'):
                 self.image_boot_config = True
+            elif opt in ('-k', '--mk_file'):
+                self.mk_file = arg
+            elif opt in ('-b', '--app'):
+                app = arg.split(',')
+                if len(app) != 3 or not all(app):
+                    print(usage, file=sys.stderr)
+                    sys.exit(Error.ARG)
+                self.apps.append(app)
+            elif opt in ('-S', '--solve'):
+                self.solve = arg
+            elif opt == '--boot_size':
+                self.boot_size = cvt_dec_or_hex(arg, opt)
+            elif opt == '--images':
+                self.images = cvt_dec_or_hex(arg, opt)
+            elif opt == '--weights':
+                self.weights = [cvt_dec_or_hex(w, opt) for w in arg.split(',')]
+            elif opt == '--reserve':
+                self.reserve = cvt_dec_or_hex(arg, opt)
+            elif opt == '--scratch_size':
+                self.scratch_size = cvt_dec_or_hex(arg, opt)
+
+        if self.solve is not None:
+            if self.weights is None:
+                self.weights = [1] * self.images
+            if self.solve not in SOLVE_MODES or self.boot_size is None or \
+                    self.images < 1 or len(self.weights) != self.images or \
+                    min(self.weights) < 1 or self.reserve < 0 or \
+                    (self.scratch_size is not None and self.solve != 'swap'):
+                print(usage, file=sys.stderr)
+                sys.exit(Error.ARG)
+            return
 
         if len(self.in_file) == 0 or len(self.out_file) == 0 or len(self.fa_file) == 0:
             print(usage, file=sys.stderr)
             sys.exit(Error.ARG)
 
+    def app_params(self, app):
+        """Parameters of an application given with --app"""
+        params = copy.copy(self)
+        params.img_id, params.fa_file, params.mk_file = app
+        params.apps = []
+        return params
+
+    def outputs(self):
+        """Files written for these parameters"""
+        files = [self.fa_file]
+        if self.img_id is None:
+            files.append(self.out_file)
+        if self.image_boot_config:
+            files += ['image_boot_config.c', 'image_boot_config.h']
+        if self.mk_file is not None:
+            files.append(self.mk_file)
+        return files
+
+    def fingerprint(self):
+        """Hash of everything the generated files depend on: this script,
+        the flash map, the policy and the options"""
+        digest = hashlib.sha256()
+        for path in (os.path.abspath(__file__), self.in_file, self.policy):
+            digest.update(file_digest(path).encode())
+        digest.update(json.dumps([self.plat_id, self.img_id, self.set_core,
+                                  self.image_boot_config]
+                                 + [os.path.abspath(f) for f in self.outputs()]
+                                 ).encode())
+        return digest.hexdigest()
+
 
 class AreaList:
     '''
@@ -660,35 +789,34 @@ class AreaList:
         '''
         c_array = 'flash_areas'
 
-        try:
-            with open(params.out_file, "w", encoding='UTF-8') as out_f:
-
-                out_f.write(f'#include "{params.fa_file}"\n')
-                out_f.write(f'#include "flash_map_backend.h"\n\n')
-                out_f.write(f'#include "flash_map_backend_platform.h"\n\n')
-                out_f.write(f'struct flash_area {c_array}[] = {{\n')
-                comma = len(self.areas)
-                area_count = 0
-                for area in self.areas:
-                    comma -= 1
-                    if area['fa_id'] is not None:
-                        sss = ' /* Shared secondary slot */' \
-                            if area['shared_slot'] else ''
-                        out_f.writelines('\n'.join([
-                            '    {' + sss,
-                            f"        .fa_id        = {area['fa_id']},",
-                            f"        .fa_device_id = {area['fa_device_id']},",
-                            f"        .fa_off       = {hex(area['fa_off'])}U,",
-                            f"        .fa_size      = {hex(area['fa_size'])}U",
-                            '    },' if comma else '    }', '']))
-                        area_count += 1
-                out_f.write('};\n\n'
-                            'struct flash_area *boot_area_descs[] = {\n')
-                for area_index in range(area_count):
-                    out_f.write(f'    &{c_array}[{area_index}U],\n')
-                out_f.write('    NULL\n};\n')                
-                out_f.close()
+        out_f = io.StringIO()
+        out_f.write(f'#include "{params.fa_file}"\n')
+        out_f.write(f'#include "flash_map_backend.h"\n\n')
+        out_f.write(f'#include "flash_map_backend_platform.h"\n\n')
+        out_f.write(f'struct flash_area {c_array}[] = {{\n')
+        comma = len(self.areas)
+        area_count = 0
+        for area in self.areas:
+            comma -= 1
+            if area['fa_id'] is not None:
+                sss = ' /* Shared secondary slot */' \
+                    if area['shared_slot'] else ''
+                out_f.writelines('\n'.join([
+                    '    {' + sss,
+                    f"        .fa_id        = {area['fa_id']},",
+                    f"        .fa_device_id = {area['fa_device_id']},",
+                    f"        .fa_off       = {hex(area['fa_off'])}U,",
+                    f"        .fa_size      = {hex(area['fa_size'])}U",
+                    '    },' if comma else '    }', '']))
+                area_count += 1
+        out_f.write('};\n\n'
+                    'struct flash_area *boot_area_descs[] = {\n')
+        for area_index in range(area_count):
+            out_f.write(f'    &{c_array}[{area_index}U],\n')
+        out_f.write('    NULL\n};\n')
 
+        try:
+            write_if_changed(params.out_file, out_f.getvalue())
         except (FileNotFoundError, OSError):
             print('Cannot create', params.out_file, file=sys.stderr)
             sys.exit(Error.IO)
@@ -696,70 +824,57 @@ class AreaList:
     def create_flash_area_id(self, img_number, params):
         """ Get 'img_number' and generate flash_area_id.h file' """
 
-        #check if params.fa_file already exists and it has FLASH_AREA_ID
-        if os.path.exists(params.fa_file):
-            with open(params.fa_file, "r", encoding='UTF-8') as fa_f:
-                content = fa_f.read()
-                res = content.find(f"FLASH_AREA_IMG_{img_number}_SECONDARY")
-                if res != -1:
-                    fa_f.close()
-                    return
-
-                fa_f.close()
+        fa_f = io.StringIO()
+        fa_f.write("#ifndef MEMORYMAP_H\n")
+        fa_f.write("#define MEMORYMAP_H\n\n")
+        fa_f.write('/* AUTO-GENERATED FILE, DO NOT EDIT.'
+                    ' ALL CHANGES WILL BE LOST! */\n')
+        fa_f.write(f'#include "flash_map_backend.h"\n\n')
+
+        fa_f.write(f'extern struct flash_area {c_array}[];\n')
+        fa_f.write(f'extern struct flash_area *boot_area_descs[];\n')
+
+        #we always have BOOTLOADER and IMG_1_
+        fa_f.write("#define FLASH_AREA_BOOTLOADER          ( 0u)\n\n")
+        fa_f.write("#define FLASH_AREA_IMG_1_PRIMARY       ( 1u)\n")
+        fa_f.write("#define FLASH_AREA_IMG_1_SECONDARY     ( 2u)\n\n")
+
+        fa_f.write("#define FLASH_AREA_IMAGE_SCRATCH       ( 3u)\n")
+        fa_f.write("#define FLASH_AREA_IMAGE_SWAP_STATUS   ( 7u)\n\n")
+
+        for img in range(2, img_number + 1):
+            """ img_id_primary and img_id_secondary must be aligned with the
+                flash_area_id, calculated in the functions
+                __STATIC_INLINE uint8_t FLASH_AREA_IMAGE_PRIMARY(uint32_t img_idx) and
+                __STATIC_INLINE uint8_t FLASH_AREA_IMAGE_SECONDARY(uint32_t img_idx),
+                in boot/cypress/platforms/memory/sysflash/sysflash.h
+            """
+
+            slots_for_image = 2
+            img_id_primary = None
+            img_id_secondary = None
+
+            if img == 2:
+                img_id_primary = int(slots_for_image * img)
+                img_id_secondary = int(slots_for_image * img + 1)
+
+            #number 7 is used for FLASH_AREA_IMAGE_SWAP_STATUS, so the next is 8
+            if img >= 3:
+                img_id_primary = int(slots_for_image * img + 2)
+                img_id_secondary = int(slots_for_image * img + 3)
+
+            fa_f.write(f"#define FLASH_AREA_IMG_{img}_PRIMARY       ( {img_id_primary}u)\n")
+            fa_f.write(f"#define FLASH_AREA_IMG_{img}_SECONDARY     ( {img_id_secondary}u)\n\n")
+
+        if self.plat.get('bitsPerCnt'):
+            list_counters = process_policy_20829(params.policy)
+            if list_counters is not None:
+                fa_f.write(form_max_counter_array(list_counters))
+            fa_f.write("\n")
+        fa_f.write("#endif /* MEMORYMAP_H */")
 
         try:
-            with open(params.fa_file, "w", encoding='UTF-8') as fa_f:
-                fa_f.write("#ifndef MEMORYMAP_H\n")
-                fa_f.write("#define MEMORYMAP_H\n\n")
-                fa_f.write('/* AUTO-GENERATED FILE, DO NOT EDIT.'
-                            ' ALL CHANGES WILL BE LOST! */\n')
-                fa_f.write(f'#include "flash_map_backend.h"\n\n')
-
-                fa_f.write(f'extern struct flash_area {c_array}[];\n')
-                fa_f.write(f'extern struct flash_area *boot_area_descs[];\n')
-
-                #we always have BOOTLOADER and IMG_1_
-                fa_f.write("#define FLASH_AREA_BOOTLOADER          ( 0u)\n\n")
-                fa_f.write("#define FLASH_AREA_IMG_1_PRIMARY       ( 1u)\n")
-                fa_f.write("#define FLASH_AREA_IMG_1_SECONDARY     ( 2u)\n\n")
-
-                fa_f.write("#define FLASH_AREA_IMAGE_SCRATCH       ( 3u)\n")
-                fa_f.write("#define FLASH_AREA_IMAGE_SWAP_STATUS   ( 7u)\n\n")
-
-                for img in range(2, img_number + 1):
-                    """ img_id_primary and img_id_secondary must be aligned with the
-                        flash_area_id, calculated in the functions
-                        __STATIC_INLINE uint8_t FLASH_AREA_IMAGE_PRIMARY(uint32_t img_idx) and
-                        __STATIC_INLINE uint8_t FLASH_AREA_IMAGE_SECONDARY(uint32_t img_idx),
-                        in boot/cypress/platforms/memory/sysflash/sysflash.h
-                    """
-
-                    slots_for_image = 2
-                    img_id_primary = None
-                    img_id_secondary = None
-
-                    if img == 2:
-                        img_id_primary = int(slots_for_image * img)
-                        img_id_secondary = int(slots_for_image * img + 1)
-
-                    #number 7 is used for FLASH_AREA_IMAGE_SWAP_STATUS, so the next is 8
-                    if img >= 3:
-                        img_id_primary = int(slots_for_image * img + 2)
-                        img_id_secondary = int(slots_for_image * img + 3)
-
-                    fa_f.write(f"#define FLASH_AREA_IMG_{img}_PRIMARY       ( {img_id_primary}u)\n")
-                    fa_f.write(f"#define FLASH_AREA_IMG_{img}_SECONDARY     ( {img_id_secondary}u)\n\n")
-                
-                if self.plat.get('bitsPerCnt'):
-                    fa_f.close()
-                    
-                    list_counters = process_policy_20829(params.policy)
-                    if list_counters is not None:
-                        form_max_counter_array(list_counters, params.fa_file)
-                else:
-                    fa_f.write("#endif /* MEMORYMAP_H */")
-                fa_f.close()
-
+            write_if_changed(params.fa_file, fa_f.getvalue())
         except (FileNotFoundError, OSError):
             print('\nERROR: Cannot create ', params.fa_file, file=sys.stderr)
             sys.exit(Error.IO)
@@ -1152,9 +1267,8 @@ def process_policy_20829(in_policy):
     return list_counters
 
 
-def form_max_counter_array(in_list, out_file):
-    '''Write bit_per_count array to output file
-    There is expected, that "out_file" already exists'''
+def form_max_counter_array(in_list):
+    '''Return the bit_per_count array for the memorymap.h file'''
 
     #ifdef here is needed to fix Rule 12.2 MISRA violation
     out_array_str = "\n#ifdef NEED_MAX_COUNTERS\nstatic const uint8_t bits_per_cnt[] = {"
@@ -1166,19 +1280,12 @@ def form_max_counter_array(in_list, out_file):
             out_array_str += ", "
     out_array_str += "};\n#endif\n"
 
-    try:
-        with open(out_file, "a", encoding='UTF-8') as out_f:
-            out_f.write(out_array_str)
-            out_f.write("\n#endif /* MEMORYMAP_H */")
-    except (FileNotFoundError, OSError):
-        print('\nERROR: Cannot open ', out_file, file=sys.stderr)
-        sys.exit(Error.CONFIG_MISMATCH)
+    return out_array_str
 
 
-def main():
-    """Flash map converter"""
-    params = CmdLineParams()
-
+def generate(params):
+    """Generate the files of one set of parameters, the make variables go
+    to stdout"""
     try:
         plat = platDict[params.plat_id]
     except KeyError:
@@ -1244,6 +1351,35 @@ def main():
     except KeyError:
         bootloader_startup = None
 
+    # Direct-XIP boots the newest image in place, nothing is copied between
+    # the slots, so there is no scratch area or swap status partition
+    direct_xip = get_bool(bootloader_config, 'direct_xip')
+    if direct_xip and (scratch is not None or swap_status is not None):
+        print('direct_xip does not use scratch and status partitions',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+
+    # Swap using move shifts the primary slot up by one sector and swaps the
+    # slots sector by sector by offset, so there is no scratch area. The swap
+    # status and image trailer still go to the status partition
+    swap_move = get_bool(bootloader_config, 'swap_move')
+    if swap_move and direct_xip:
+        print('swap_move and direct_xip cannot be combined',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+    if swap_move and scratch is not None:
+        print('swap_move does not use a scratch area',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+    if swap_move and swap_status is None:
+        print('swap_move requires a swap status partition',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+    if not swap_move and swap_status is not None and scratch is None:
+        print('Swap without scratch area requires swap_move',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+
     try:
         ram_app_area = AddrSize(bootloader_config['ram_boot'], 'address', 'size')
     except  KeyError:
@@ -1291,7 +1427,7 @@ def main():
         if image_boot_mode:
             generate_boot_type(image_boot_mode)
 
-    cy_img_hdr_size = 0x400
+    cy_img_hdr_size = CY_IMG_HDR_SIZE
     app_start = int(apps_flash_map[1].get("primary").get("address"), 0) + cy_img_hdr_size
 
     if app_start % plat['VTAlign'] != 0:
@@ -1301,6 +1437,45 @@ def main():
               file=sys.stderr)
         sys.exit(Error.CONFIG_MISMATCH)
 
+    if direct_xip:
+        # Images also run from the secondary slots, which therefore have to
+        # be executable and aligned like the primary ones
+        for app_flash_map in apps_flash_map[1:]:
+            secondary_addr = app_flash_map.get("secondary").get("address")
+            if (int(secondary_addr, 0) + cy_img_hdr_size) % plat['VTAlign'] != 0:
+                print('Starting address', secondary_addr,
+                      '+', hex(cy_img_hdr_size),
+                      'must be aligned to', hex(plat['VTAlign']),
+                      file=sys.stderr)
+                sys.exit(Error.CONFIG_MISMATCH)
+        if area_list.external_flash and not area_list.external_flash_xip:
+            print('direct_xip requires external flash in XIP mode',
+                  file=sys.stderr)
+            sys.exit(Error.CONFIG_MISMATCH)
+        if shared_slot:
+            print('Shared slot is not supported with direct_xip',
+                  file=sys.stderr)
+            sys.exit(Error.CONFIG_MISMATCH)
+
+    if swap_move:
+        # Both slots are swapped sector by sector with the same offsets, so
+        # they must have the same sectors. The padded UPGRADE image is
+        # SLOT_SIZE long, so the slots also have the same size
+        for app_flash_map in apps_flash_map[1:]:
+            if app_flash_map.get("primary").get("size") != \
+                    app_flash_map.get("secondary").get("size"):
+                print('swap_move requires primary and secondary slots '
+                      'of the same size', file=sys.stderr)
+                sys.exit(Error.CONFIG_MISMATCH)
+        if area_list.external_flash:
+            print('swap_move requires both slots in internal flash',
+                  file=sys.stderr)
+            sys.exit(Error.CONFIG_MISMATCH)
+        if shared_slot:
+            print('Shared slot is not supported with swap_move',
+                  file=sys.stderr)
+            sys.exit(Error.CONFIG_MISMATCH)
+
     slot_sectors_max = max(slot_sectors_max, 32)
 
     if swap_status is not None:
@@ -1393,6 +1568,15 @@ def main():
         print('PRIMARY_IMG_START := ' + primary_img_start)
         print('SECONDARY_IMG_START := ' + secondary_img_start)
         print('SLOT_SIZE := ' + slot_size)
+
+        if direct_xip:
+            # Offsets of the slots in their flash device, checked by MCUboot
+            # against the load address of images signed with --rom-fixed
+            for area in area_list.areas:
+                if area['fa_id'] == f'FLASH_AREA_IMG_{params.img_id}_PRIMARY':
+                    print('PRIMARY_IMG_OFFSET :=', hex(area['fa_off']))
+                elif area['fa_id'] == f'FLASH_AREA_IMG_{params.img_id}_SECONDARY':
+                    print('SECONDARY_IMG_OFFSET :=', hex(area['fa_off']))
     else:
         if apps_ram_map:
             ram_load_counter = 0
@@ -1416,8 +1600,12 @@ def main():
     if area_list.external_flash_xip:
         print('USE_XIP := 1')
 
-    if area_list.use_overwrite:
+    if direct_xip:
+        print('USE_DIRECT_XIP := 1')
+    elif area_list.use_overwrite:
         print('USE_OVERWRITE := 1')
+    elif swap_move:
+        print('USE_SWAP_MOVE := 1')
     if shared_slot:
         print('USE_SHARED_SLOT := 1')
     if service_app is not None:
@@ -1430,5 +1618,244 @@ def main():
         print('USE_HW_ROLLBACK_PROT := 1')
 
 
+def is_up_to_date(params, stamp_file, fingerprint):
+    """Check the stamp of an earlier run against the inputs and outputs"""
+    try:
+        with open(stamp_file, encoding='UTF-8') as stamp_f:
+            stamp = json.load(stamp_f)
+    except (FileNotFoundError, OSError, ValueError):
+        return False
+
+    if stamp.get('fingerprint') != fingerprint:
+        return False
+
+    # Outputs that were deleted or edited are generated again
+    outputs = stamp.get('outputs', {})
+    return all(outputs.get(os.path.abspath(path)) == file_digest(path) != ''
+               for path in params.outputs())
+
+
+def generate_incremental(params):
+    """Generate the files of one set of parameters, unless the stamp shows
+    that they were generated from the same inputs"""
+    if params.mk_file is None:
+        generate(params)
+        return
+
+    stamp_file = params.mk_file + '.stamp'
+    fingerprint = params.fingerprint()
+    if is_up_to_date(params, stamp_file, fingerprint):
+        return
+
+    make_vars = io.StringIO()
+    with contextlib.redirect_stdout(make_vars):
+        generate(params)
+
+    try:
+        write_if_changed(params.mk_file, make_vars.getvalue())
+        stamp = {'fingerprint': fingerprint,
+                 'outputs': {os.path.abspath(path): file_digest(path)
+                             for path in params.outputs()}}
+        write_if_changed(stamp_file, json.dumps(stamp, indent=4) + '\n')
+    except (FileNotFoundError, OSError):
+        print('Cannot create', params.mk_file, file=sys.stderr)
+        sys.exit(Error.IO)
+
+
+def align_up(val, align):
+    """Round up to a multiple of align"""
+    return (val + align - 1) // align * align
+
+
+def align_down(val, align):
+    """Round down to a multiple of align"""
+    return val // align * align
+
+
+def solve_slots(params, plat, slot_size):
+    """Place the areas of a layout whose largest slot is slot_size bytes:
+    bootloader, primary slots, secondary slots, swap status partition and
+    scratch area. Returns None if they do not fit"""
+    erase = plat['eraseSize']
+    flash_end = plat['flashAddr'] + plat['flashSize'] - params.reserve
+    weight_max = max(params.weights)
+    sizes = [align_down(slot_size * w // weight_max, erase)
+             for w in params.weights]
+    if min(sizes) <= CY_IMG_HDR_SIZE:
+        return None
+
+    def place(addr, executable):
+        addr = align_up(addr, erase)
+        # The vector table follows the image header
+        while executable and (addr + CY_IMG_HDR_SIZE) % plat['VTAlign'] != 0:
+            addr += erase
+        return addr
+
+    layout = {'bootloader': (plat['flashAddr'],
+                             align_up(params.boot_size, erase)),
+              'primary': [], 'secondary': []}
+    addr = plat['flashAddr'] + layout['bootloader'][1]
+    for size in sizes:
+        addr = place(addr, True)
+        layout['primary'].append((addr, size))
+        addr += size
+    for size in sizes:
+        addr = place(addr, params.solve == 'direct_xip')
+        layout['secondary'].append((addr, size))
+        addr += size
+
+    if params.solve in ('swap', 'swap_move'):
+        status_size = align_up(
+            calc_status_size(erase, max(max(sizes) // erase, 32),
+                             params.images, params.solve == 'swap'), erase)
+        layout['status'] = (addr, status_size)
+        addr += status_size
+    if params.solve == 'swap':
+        scratch_size = params.scratch_size
+        if scratch_size is None:
+            scratch_size = SOLVE_SCRATCH_SECTORS * erase
+        layout['scratch'] = (addr, align_up(scratch_size, erase))
+        addr += layout['scratch'][1]
+
+    return layout if addr <= flash_end else None
+
+
+def solve_layout(params, plat):
+    """Find the layout with the largest slots in the internal flash"""
+    erase = plat['eraseSize']
+    free = plat['flashSize'] - params.reserve - \
+        align_up(params.boot_size, erase)
+    # Two slots per image, the largest image takes weight_max of every
+    # sum(weights) bytes. The search starts there and goes down by a sector
+    # until the alignment padding and the status and scratch areas also fit
+    slot_size = align_down(free * max(params.weights) //
+                           (2 * sum(params.weights)), erase)
+    while slot_size > 0:
+        layout = solve_slots(params, plat, slot_size)
+        if layout is not None:
+            return layout
+        slot_size -= erase
+    return None
+
+
+def layout_json(params, layout):
+    """Flash map JSON of a solved layout"""
+    def entry(desc, val):
+        return {'description': desc, 'value': hex(val)}
+
+    bootloader = {'address': entry('Address of the bootloader',
+                                   layout['bootloader'][0]),
+                  'size': entry('Size of the bootloader',
+                                layout['bootloader'][1])}
+    if 'scratch' in layout:
+        bootloader['scratch_address'] = entry('Address of the scratch area',
+                                              layout['scratch'][0])
+        bootloader['scratch_size'] = entry('Size of the scratch area',
+                                           layout['scratch'][1])
+    if 'status' in layout:
+        bootloader['status_address'] = \
+            entry('Address of the swap status partition', layout['status'][0])
+        bootloader['status_size'] = \
+            entry('Size of the swap status partition', layout['status'][1])
+    if params.solve == 'swap_move':
+        bootloader['swap_move'] = {
+            'description': 'Swap the slots by moving sectors, without a scratch area',
+            'value': True}
+    elif params.solve == 'direct_xip':
+        bootloader['direct_xip'] = {
+            'description': 'Boot the newest image in place from either slot',
+            'value': True}
+
+    boot_and_upgrade = {'bootloader': bootloader}
+    for img, (primary, secondary) in enumerate(zip(layout['primary'],
+                                                   layout['secondary'])):
+        name = 'application' if img == 0 else 'image ' + str(img + 1)
+        boot_and_upgrade['application_' + str(img + 1)] = {
+            'address': entry('Address of the ' + name + ' primary slot',
+                             primary[0]),
+            'size': entry('Size of the ' + name + ' primary slot',
+                          primary[1]),
+            'upgrade_address': entry('Address of the ' + name +
+                                     ' secondary slot', secondary[0]),
+            'upgrade_size': entry('Size of the ' + name + ' secondary slot',
+                                  secondary[1])}
+    return json.dumps({'boot_and_upgrade': boot_and_upgrade}, indent=4) + '\n'
+
+
+def solve(params):
+    """Write the flash map with the largest slots for the upgrade mode"""
+    try:
+        plat = platDict[params.plat_id]
+    except KeyError:
+        print('Supported platforms are:', ', '.join(platDict.keys()),
+              file=sys.stderr)
+        sys.exit(Error.POLICY)
+
+    if plat.get('flashSize', 0) == 0:
+        print('The solver lays out the internal flash, which',
+              params.plat_id, 'does not have', file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+
+    layout = solve_layout(params, plat)
+    if layout is None:
+        print('The bootloader and the areas of', params.solve,
+              'do not fit into', hex(plat['flashSize']), 'bytes',
+              file=sys.stderr)
+        sys.exit(Error.CONFIG_MISMATCH)
+    content = layout_json(params, layout)
+
+    # The solved flash map must pass the checks of the generator itself
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        check = copy.copy(params)
+        check.in_file = os.path.join(tmp_dir, 'flash_map.json')
+        check.out_file = os.path.join(tmp_dir, 'memorymap.c')
+        check.fa_file = os.path.join(tmp_dir, 'memorymap.h')
+        check.img_id = None
+        check.image_boot_config = False
+        write_if_changed(check.in_file, content)
+        with contextlib.redirect_stdout(io.StringIO()):
+            generate(check)
+
+    areas = [('bootloader', layout['bootloader'])]
+    for img in range(params.images):
+        areas.append(('primary slot ' + str(img + 1), layout['primary'][img]))
+    for img in range(params.images):
+        areas.append(('secondary slot ' + str(img + 1),
+                      layout['secondary'][img]))
+    for area in ('status', 'scratch'):
+        if area in layout:
+            areas.append((area, layout[area]))
+    used = 0
+    for title, (addr, size) in areas:
+        print('{:16} {:#010x} {:#09x}'.format(title, addr, size),
+              file=sys.stderr)
+        used += size
+    print('Slots take', hex(2 * sum(size for unused, size in layout['primary'])),
+          'bytes,', hex(plat['flashSize'] - params.reserve - used),
+          'bytes of the flash are unused', file=sys.stderr)
+
+    if params.out_file:
+        try:
+            write_if_changed(params.out_file, content)
+        except (FileNotFoundError, OSError):
+            print('Cannot create', params.out_file, file=sys.stderr)
+            sys.exit(Error.IO)
+    else:
+        sys.stdout.write(content)
+
+
+def main():
+    """Flash map converter"""
+    params = CmdLineParams()
+
+    if params.solve is not None:
+        solve(params)
+        return
+
+    generate_incremental(params)
+    for app in params.apps:
+        generate_incremental(params.app_params(app))
+
+
 if __name__ == '__main__':
     main()
@@ -0,0 +1,507 @@
+"""MCUBoot Release Image Signing
+Copyright (c) 2026 Infineon Technologies AG
+
+Signs many Blinky app builds for a release in one run. The loadable segments
+of every ELF file are converted to the binary that the post-build step of
+blinky_app/Makefile passes to the imgtool as Intel HEX, and signed for each
+selected slot and upgrade mode by parallel worker processes. Every worker
+imports the imgtool of the mcuboot library and loads the keys once. The
+signed images are cached by a hash of the binary, the keys and the signing
+parameters, so only the builds that changed are signed again. Optionally,
+every signed image is checked against the output of the imgtool command line
+for an Intel HEX file of the same ELF file.
+"""
+
+import os
+import re
+import sys
+import time
+import getopt
+import shutil
+import struct
+import hashlib
+import tempfile
+import subprocess
+import multiprocessing
+from enum import Enum
+
+from elffile import ElfFile, ElfError
+from ihex import write_hex, write_hex_segments
+
+
+class Error(Enum):
+    ''' Application error codes '''
+    ARG     = 1
+    IO      = 2
+    FORMAT  = 3
+    SIGN    = 4
+    CHECK   = 5
+
+
+SLOTS = ('primary', 'secondary')
+MODES = ('overwrite', 'swap')
+
+# Bumped when the cached output of the same inputs changes
+CACHE_FORMAT = 2
+
+# Fill of the gaps between the loadable segments. The imgtool pads an Intel
+# HEX file with 0xff, whatever the erased value of the slot is.
+GAP_FILL = 0xff
+
+IMAGE_MAGIC = 0x96f3b83d
+IMAGE_F_ENCRYPTED = 0x04
+TLV_INFO_MAGIC = 0x6907
+
+# TLVs that differ between two runs of the imgtool: the ECDSA and RSA-PSS
+# signatures and the wrapped random AES key
+RANDOM_TLVS = (0x20, 0x21, 0x22, 0x23, 0x30, 0x31, 0x32, 0x33)
+
+VERSION_RE = re.compile(r'^\d+(\.\d+){0,2}(\+\d+)?$')
+DEPENDENCY_RE = re.compile(r'^\(\s*(\d+)\s*,\s*([0-9.+]+)\s*\)$')
+
+DEFAULT_IMGTOOL = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..',
+                               'mtb_shared', 'mcuboot', 'v1.9.1-cypress', 'scripts')
+
+
+class CmdLineParams:
+    """Command line parameters"""
+
+    def __init__(self):
+        self.key_file = ''
+        self.enc_key_file = None
+        self.out_dir = ''
+        self.slot_size = None
+        self.version = '0.0.0'
+        self.header_size = 0x400
+        self.erased_val = 0
+        self.max_sectors = 512
+        self.align = 8
+        self.dependency = None
+        self.slots = list(SLOTS)
+        self.modes = list(MODES)
+        self.addresses = None
+        self.jobs = os.cpu_count() or 1
+        self.cache_dir = None
+        self.imgtool_dir = DEFAULT_IMGTOOL
+        self.check = False
+        self.inputs = []
+
+        usage = 'USAGE:\n' + sys.argv[0] + \
+                ''' -k <key.pem> -o <out_dir> -S <slot_size> [options] <app.elf[@version]>...
+
+Signs every ELF file for each slot and upgrade mode. The outputs are written
+to <out_dir>, in the directories of the ELF files relative to their common
+parent, as <name>_<slot>_<mode>.bin.
+
+OPTIONS:
+-h  --help          Display the usage information
+-k  --key=          Signing key, PEM
+-E  --encrypt=      Public key to encrypt the secondary slot images with
+-o  --out-dir=      Output directory
+-S  --slot-size=    Slot size
+-v  --version=      Version of the ELF files without @version (default: 0.0.0)
+-H  --header-size=  Image header size (default: 0x400)
+-R  --erased-val=   Erased value of the flash, 0 or 0xff, for the padding of
+                    the secondary slot images (default: 0)
+-M  --max-sectors=  Maximum number of sectors in a slot (default: 512)
+-A  --align=        Flash write alignment (default: 8)
+-d  --dependency=   Dependency "(image_index, version)", as for the imgtool
+-s  --slots=        Comma-separated slots (default: primary,secondary)
+-m  --modes=        Comma-separated upgrade modes (default: overwrite,swap)
+-a  --addresses=    Start of the primary and secondary slot, e.g.
+                    0x10018000,0x10028000: also write Intel HEX files there
+-j  --jobs=         Worker processes (default: number of CPUs)
+-c  --cache=        Cache directory (default: <out_dir>/.sign_cache)
+-t  --imgtool=      Directory of the imgtool package (default: scripts of
+                    the mcuboot library in mtb_shared)
+-C  --check         Also sign every image with the imgtool command line from
+                    an Intel HEX file of the ELF file, as the post-build step
+                    does, and fail unless both match. The signatures, the
+                    wrapped AES key and the encrypted payload are random and
+                    are not compared
+'''
+
+        try:
+            opts, self.inputs = getopt.getopt(sys.argv[1:], 'hk:E:o:S:v:H:R:M:A:d:s:m:a:j:c:t:C',
+                                              ['help', 'key=', 'encrypt=', 'out-dir=',
+                                               'slot-size=', 'version=', 'header-size=',
+                                               'erased-val=', 'max-sectors=', 'align=',
+                                               'dependency=', 'slots=', 'modes=',
+                                               'addresses=', 'jobs=', 'cache=', 'imgtool=',
+                                               'check'])
+        except getopt.GetoptError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        try:
+            for opt, arg in opts:
+                if opt in ('-h', '--help'):
+                    print(usage, file=sys.stderr)
+                    sys.exit()
+                elif opt in ('-k', '--key'):
+                    self.key_file = arg
+                elif opt in ('-E', '--encrypt'):
+                    self.enc_key_file = arg
+                elif opt in ('-o', '--out-dir'):
+                    self.out_dir = arg
+                elif opt in ('-S', '--slot-size'):
+                    self.slot_size = int(arg, 0)
+                elif opt in ('-v', '--version'):
+                    self.version = arg
+                elif opt in ('-H', '--header-size'):
+                    self.header_size = int(arg, 0)
+                elif opt in ('-R', '--erased-val'):
+                    self.erased_val = int(arg, 0)
+                elif opt in ('-M', '--max-sectors'):
+                    self.max_sectors = int(arg, 0)
+                elif opt in ('-A', '--align'):
+                    self.align = int(arg, 0)
+                elif opt in ('-d', '--dependency'):
+                    match = DEPENDENCY_RE.match(arg.strip())
+                    if match is None or not VERSION_RE.match(match.group(2)):
+                        raise ValueError(arg)
+                    self.dependency = (int(match.group(1)), match.group(2))
+                elif opt in ('-s', '--slots'):
+                    self.slots = arg.split(',')
+                elif opt in ('-m', '--modes'):
+                    self.modes = arg.split(',')
+                elif opt in ('-a', '--addresses'):
+                    self.addresses = dict(zip(SLOTS, (int(a, 0) for a in arg.split(','))))
+                    if len(self.addresses) != len(SLOTS):
+                        raise ValueError(arg)
+                elif opt in ('-j', '--jobs'):
+                    self.jobs = int(arg, 0)
+                elif opt in ('-c', '--cache'):
+                    self.cache_dir = arg
+                elif opt in ('-t', '--imgtool'):
+                    self.imgtool_dir = arg
+                elif opt in ('-C', '--check'):
+                    self.check = True
+        except ValueError:
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if (len(self.key_file) == 0 or len(self.out_dir) == 0 or not self.inputs or
+                self.slot_size is None or self.jobs < 1 or
+                self.erased_val not in (0, 0xff) or
+                not VERSION_RE.match(self.version) or
+                not self.slots or any(s not in SLOTS for s in self.slots) or
+                not self.modes or any(m not in MODES for m in self.modes)):
+            print(usage, file=sys.stderr)
+            sys.exit(Error.ARG.value)
+
+        if self.cache_dir is None:
+            self.cache_dir = os.path.join(self.out_dir, '.sign_cache')
+
+
+def split_input(arg, default_version):
+    """Returns (ELF path, version) of an app.elf[@version] argument"""
+    path, sep, ver = arg.rpartition('@')
+    if sep and VERSION_RE.match(ver):
+        return path, ver
+    return arg, default_version
+
+
+def elf_to_bin(path, slot_size):
+    """Returns (start address, bytes) of the loadable segments of an ELF file,
+    with the gaps filled like the imgtool fills them in the Intel HEX file of
+    objcopy -O ihex"""
+    segments = ElfFile(path).load_segments()
+    if not segments:
+        raise ElfError('no loadable segments')
+
+    start = min(addr for addr, _ in segments)
+    end = max(addr + len(data) for addr, data in segments)
+    if end - start > slot_size:
+        raise ElfError(f'0x{end - start:x} bytes from 0x{start:08x} do not fit the slot')
+
+    image = bytearray([GAP_FILL]) * (end - start)
+    for addr, data in segments:
+        image[addr - start:addr - start + len(data)] = data
+    return start, bytes(image)
+
+
+def cache_key(payload, key_hash, enc_hash, job, params):
+    """Hash of everything that the signed image depends on"""
+    sha = hashlib.sha256()
+    secondary = job['slot'] == 'secondary'
+    # The mode only changes the trailer that pads the secondary slot image
+    sha.update(repr((CACHE_FORMAT, job['slot'], job['mode'] if secondary else None,
+                     job['version'],
+                     params.dependency, params.header_size, params.slot_size,
+                     params.erased_val, params.max_sectors, params.align,
+                     key_hash, enc_hash if secondary else None)).encode())
+    sha.update(payload)
+    return sha.hexdigest()
+
+
+# Loaded once per worker process by worker_init()
+_IMGTOOL = {}
+
+
+def worker_init(imgtool_dir, key_file, enc_key_file):
+    """Imports the imgtool and loads the keys for the signing jobs"""
+    if imgtool_dir not in sys.path:
+        sys.path.insert(0, imgtool_dir)
+    # pylint: disable=import-outside-toplevel,import-error
+    from imgtool import image, keys, version
+    _IMGTOOL['image'] = image
+    _IMGTOOL['version'] = version
+    _IMGTOOL['key'] = keys.load(key_file)
+    _IMGTOOL['enc_key'] = keys.load(enc_key_file) if enc_key_file else None
+
+
+def sign_job(job):
+    """Signs one binary into the cache. Returns (cache key, error or None)"""
+    image = _IMGTOOL['image']
+    version = _IMGTOOL['version']
+    secondary = job['slot'] == 'secondary'
+    dependencies = None
+    if job['dependency'] is not None:
+        dependencies = {image.DEP_IMAGES_KEY: [job['dependency'][0]],
+                        image.DEP_VERSIONS_KEY: [version.decode_version(job['dependency'][1])]}
+
+    fd_in, tmp_in = tempfile.mkstemp(suffix='.bin', dir=job['cache_dir'])
+    fd_out, tmp_out = tempfile.mkstemp(suffix='.bin', dir=job['cache_dir'])
+    try:
+        with os.fdopen(fd_in, 'wb') as in_f:
+            in_f.write(job['payload'])
+        os.close(fd_out)
+
+        img = image.Image(version=version.decode_version(job['version']),
+                          header_size=job['header_size'], pad_header=True,
+                          pad=secondary, align=job['align'], slot_size=job['slot_size'],
+                          max_sectors=job['max_sectors'],
+                          overwrite_only=job['mode'] == 'overwrite', endian='little',
+                          erased_val=hex(job['erased_val']))
+        img.load(tmp_in)
+        img.create(_IMGTOOL['key'], 'hash',
+                   _IMGTOOL['enc_key'] if secondary else None, dependencies)
+        img.save(tmp_out)
+        os.replace(tmp_out, os.path.join(job['cache_dir'], job['hash'] + '.bin'))
+        return job['hash'], None
+    except Exception as err:    # pylint: disable=broad-except
+        return job['hash'], f'{type(err).__name__}: {err}'
+    finally:
+        for tmp in (tmp_in, tmp_out):
+            if os.path.exists(tmp):
+                os.remove(tmp)
+
+
+def sign_all(pending, params):
+    """Signs the jobs that are not cached, in parallel. Returns the errors"""
+    initargs = (params.imgtool_dir, params.key_file, params.enc_key_file)
+
+    # Checked here once, a failing pool initializer is restarted forever
+    worker_init(*initargs)
+
+    if params.jobs == 1 or len(pending) == 1:
+        results = [sign_job(job) for job in pending]
+    else:
+        with multiprocessing.Pool(min(params.jobs, len(pending)), worker_init, initargs) as pool:
+            results = list(pool.imap_unordered(sign_job, pending))
+
+    return {job_hash: err for job_hash, err in results if err is not None}
+
+
+def imgtool_cmd(job, params, hex_path, out_path):
+    """Returns the imgtool command line that signs an Intel HEX file like
+    sign_job() signs the binary, with the arguments of the post-build step"""
+    secondary = job['slot'] == 'secondary'
+    cmd = [sys.executable, os.path.join(params.imgtool_dir, 'imgtool.py'), 'sign',
+           '--header-size', hex(params.header_size), '--pad-header', '--align', str(params.align),
+           '-M', str(params.max_sectors), '-v', job['version'],
+           '-S', hex(params.slot_size), '-R', hex(params.erased_val), '-k', params.key_file]
+    if params.dependency is not None:
+        cmd += ['-d', f'({params.dependency[0]}, {params.dependency[1]})']
+    if job['mode'] == 'overwrite':
+        cmd.append('--overwrite-only')
+    if secondary:
+        cmd.append('--pad')
+        if params.enc_key_file:
+            cmd += ['-E', params.enc_key_file]
+    return cmd + [hex_path, out_path]
+
+
+def image_parts(data):
+    """Splits a signed image into (header, payload, protected TLVs, TLVs,
+    end of the TLVs). The payload of an encrypted image and the values of
+    RANDOM_TLVS are None."""
+    if len(data) < 32:
+        raise ValueError('no image header')
+    magic, _, hdr_size, prot_size, img_size, flags = struct.unpack_from('<IIHHII', data)
+    if magic != IMAGE_MAGIC:
+        raise ValueError('bad image magic')
+
+    off = hdr_size + img_size
+    payload = None if flags & IMAGE_F_ENCRYPTED else data[hdr_size:off]
+    protected = data[off:off + prot_size]
+    off += prot_size
+
+    if off + 4 > len(data):
+        raise ValueError('no TLV area')
+    magic, tot = struct.unpack_from('<HH', data, off)
+    if magic != TLV_INFO_MAGIC or off + tot > len(data):
+        raise ValueError('bad TLV area')
+
+    tlvs = []
+    end = off + tot
+    off += 4
+    while off < end:
+        kind, size = struct.unpack_from('<HH', data, off)
+        value = data[off + 4:off + 4 + size]
+        tlvs.append((kind, None if kind in RANDOM_TLVS else value))
+        off += 4 + size
+    return data[:hdr_size], payload, protected, tlvs, end
+
+
+def compare_images(image, ref):
+    """Returns None if a signed image matches the one of the imgtool command
+    line, otherwise what differs"""
+    try:
+        parts = image_parts(image)
+        ref_parts = image_parts(ref)
+    except (ValueError, struct.error) as err:
+        return f'cannot parse the images - {err}'
+
+    for name, part, ref_part in zip(('header', 'payload', 'protected TLVs', 'TLVs'),
+                                    parts, ref_parts):
+        if part != ref_part:
+            return f'{name} mismatch'
+
+    # The signatures vary in length, so the padding up to the trailer does too
+    tail, ref_tail = image[parts[-1]:], ref[ref_parts[-1]:]
+    size = min(len(tail), len(ref_tail))
+    if (tail or ref_tail) and (len(image) != len(ref) or
+                               tail[len(tail) - size:] != ref_tail[len(ref_tail) - size:]):
+        return 'padding or trailer mismatch'
+    return None
+
+
+def check_job(args):
+    """Signs one image with the imgtool command line and compares it with the
+    cached one. Returns (cache key, error or None)"""
+    job, cmd, ref_path = args
+    try:
+        proc = subprocess.run(cmd, capture_output=True, text=True, check=False)
+        if proc.returncode != 0:
+            return job['hash'], f'imgtool failed - {proc.stderr.strip()}'
+        with open(os.path.join(job['cache_dir'], job['hash'] + '.bin'), 'rb') as in_f:
+            image = in_f.read()
+        with open(ref_path, 'rb') as in_f:
+            ref = in_f.read()
+        return job['hash'], compare_images(image, ref)
+    except OSError as err:
+        return job['hash'], str(err)
+
+
+def check_all(jobs, hex_paths, params, tmp_dir):
+    """Checks every signed image, in parallel. Returns the errors"""
+    unique = {}
+    for job in jobs:
+        unique.setdefault(job['hash'], job)
+    args = []
+    for job_hash, job in unique.items():
+        ref_path = os.path.join(tmp_dir, job_hash + '.bin')
+        args.append((job, imgtool_cmd(job, params, hex_paths[job['elf']], ref_path), ref_path))
+
+    with multiprocessing.Pool(min(params.jobs, len(args))) as pool:
+        results = list(pool.imap_unordered(check_job, args))
+    return {job_hash: err for job_hash, err in results if err is not None}
+
+
+def main():
+    """Release image signing"""
+    params = CmdLineParams()
+    started = time.monotonic()
+
+    try:
+        with open(params.key_file, 'rb') as key_f:
+            key_hash = hashlib.sha256(key_f.read()).hexdigest()
+        enc_hash = None
+        if params.enc_key_file:
+            with open(params.enc_key_file, 'rb') as key_f:
+                enc_hash = hashlib.sha256(key_f.read()).hexdigest()
+        os.makedirs(params.cache_dir, exist_ok=True)
+    except OSError as err:
+        print('Cannot read the keys or create the cache -', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    inputs = [split_input(arg, params.version) for arg in params.inputs]
+    root = os.path.commonpath([os.path.dirname(os.path.abspath(p)) for p, _ in inputs])
+
+    jobs = []
+    for path, ver in inputs:
+        try:
+            _, payload = elf_to_bin(path, params.slot_size)
+        except (OSError, ElfError) as err:
+            print('Cannot convert', path, '-', err, file=sys.stderr)
+            sys.exit(Error.FORMAT.value)
+
+        rel_dir = os.path.relpath(os.path.dirname(os.path.abspath(path)), root)
+        name = os.path.splitext(os.path.basename(path))[0]
+        for slot in params.slots:
+            for mode in params.modes:
+                job = {'slot': slot, 'mode': mode, 'version': ver, 'payload': payload, 'elf': path,
+                       'dependency': params.dependency, 'header_size': params.header_size,
+                       'slot_size': params.slot_size, 'erased_val': params.erased_val,
+                       'max_sectors': params.max_sectors, 'align': params.align,
+                       'cache_dir': params.cache_dir}
+                job['hash'] = cache_key(payload, key_hash, enc_hash, job, params)
+                job['out'] = os.path.join(params.out_dir, rel_dir, f'{name}_{slot}_{mode}')
+                jobs.append(job)
+
+    # Identical inputs are signed once
+    pending = {}
+    for job in jobs:
+        if not os.path.exists(os.path.join(params.cache_dir, job['hash'] + '.bin')):
+            pending.setdefault(job['hash'], job)
+
+    try:
+        errors = sign_all(list(pending.values()), params) if pending else {}
+    except Exception as err:    # pylint: disable=broad-except
+        print('Cannot load the imgtool from', params.imgtool_dir, 'or the keys -',
+              f'{type(err).__name__}: {err}', file=sys.stderr)
+        sys.exit(Error.SIGN.value)
+    for job_hash, err in errors.items():
+        print('Cannot sign', pending[job_hash]['out'], '-', err, file=sys.stderr)
+    if errors:
+        sys.exit(Error.SIGN.value)
+
+    if params.check:
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            hex_paths = {}
+            try:
+                for path, _ in inputs:
+                    hex_paths[path] = os.path.join(tmp_dir, f'{len(hex_paths)}.hex')
+                    write_hex_segments(hex_paths[path], ElfFile(path).load_segments())
+            except (OSError, ElfError) as err:
+                print('Cannot convert', path, '-', err, file=sys.stderr)
+                sys.exit(Error.FORMAT.value)
+            errors = check_all(jobs, hex_paths, params, tmp_dir)
+        for job in jobs:
+            if job['hash'] in errors:
+                print('Check of', job['out'], 'failed -', errors[job['hash']], file=sys.stderr)
+        if errors:
+            sys.exit(Error.CHECK.value)
+
+    try:
+        for job in jobs:
+            cached = os.path.join(params.cache_dir, job['hash'] + '.bin')
+            os.makedirs(os.path.dirname(job['out']), exist_ok=True)
+            shutil.copyfile(cached, job['out'] + '.bin')
+            if params.addresses is not None:
+                with open(cached, 'rb') as in_f:
+                    write_hex(job['out'] + '.hex', params.addresses[job['slot']], in_f.read())
+            print(f"{job['out']}.bin: {os.path.getsize(cached)} bytes, "
+                  f"{'signed' if job['hash'] in pending else 'cached'}")
+    except OSError as err:
+        print('Cannot write the outputs -', err, file=sys.stderr)
+        sys.exit(Error.IO.value)
+
+    print(f'{len(jobs)} images, {len(pending)} signed with {min(params.jobs, max(len(pending), 1))} '
+          f'workers, {len(jobs) - len(pending)} from the cache, {time.monotonic() - started:.1f} s')
+
+
+if __name__ == '__main__':
+    main()
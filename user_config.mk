@@ -86,13 +86,122 @@ PLATFORM_MEMORY_ALIGN=0x200
 # Maximum trailer page size for PSoC6 devices
 PLATFORM_MAX_TRAILER_PAGE_SIZE=0x200
 
-# Encrypted image support
-# This code example not supported the encrypted image at the moment
-ENC_IMG=0
+# RAM area where the Bootloader app passes data to the user app (MCUboot
+# boot records, boot phase timing). Overridden by the "shared_data" object of
+# the bootloader in the flashmap JSON, if present. The Bootloader app linker
+# script keeps its own data out of this area.
+BOOT_SHARED_DATA_ADDRESS?=0x08000800
+BOOT_SHARED_DATA_SIZE?=0x200
+
+# Boot phase timing
+# When set to `1`, the Bootloader app measures the duration of every boot phase
+# with the DWT cycle counter and passes the result to the Blinky app through
+# the shared data area. See README.md.
+USE_BOOT_TIMING?=0
+
+# Tokenized boot log
+# When set to `1`, the Bootloader app stores its log messages as binary records
+# in RAM instead of printing them, and the Blinky app prints the records for
+# scripts/boot_log_detokenize.py. See README.md.
+USE_BOOT_LOG_TOKENIZED?=0
+
+# Compressed upgrade images
+# When set to `1`, the UPGRADE image of the Blinky app is stored LZSS-compressed
+# in the secondary slot, and the Bootloader app decompresses it into the
+# primary slot. Requires the overwrite upgrade mode. See README.md.
+USE_COMPRESSED_UPGRADE?=0
+
+# Delta upgrade images
+# When set to `1`, the UPGRADE image of the Blinky app is a patch against the
+# BOOT image, and the Bootloader app applies it to the primary slot in place.
+# Requires the overwrite upgrade mode with both slots in internal flash. See
+# README.md.
+USE_DELTA_UPGRADE?=0
+
+# Sector-skip copy
+# When set to `1`, the Bootloader app installs an overwrite upgrade itself and
+# does not erase or program the sectors of the primary slot that already match.
+# Requires the overwrite upgrade mode. See README.md.
+USE_SECTOR_SKIP_COPY?=0
+
+# Pipelined copy
+# When set to `1`, the sector-skip copy reads and compares the next sector while
+# the previous one is being programmed. Requires USE_SECTOR_SKIP_COPY. See
+# README.md.
+USE_PIPELINED_COPY?=0
+
+# SFDP cache
+# When set to `1`, the Bootloader app keeps the memory configuration that the
+# SFDP discovery of the external flash produces in an internal flash record
+# and reuses it on later boots. Requires USE_EXTERNAL_FLASH. The record takes
+# 1 KB at the end of the working flash (em_eeprom region) unless
+# SFDP_CACHE_ADDRESS is set. See README.md.
+USE_SFDP_CACHE?=0
+SFDP_CACHE_ADDRESS?=
+
+# Flash read cache
+# When set to `1`, reads of MCUboot from the flash areas in external flash go
+# through a cache of FLASH_READ_CACHE_BLOCKS blocks of PLATFORM_CHUNK_SIZE
+# bytes in RAM. Writes and erases invalidate the blocks they touch. See
+# README.md.
+USE_FLASH_READ_CACHE?=0
+FLASH_READ_CACHE_BLOCKS?=8
+
+# Crypto arena
+# When set to `1`, mbedTLS allocates its working memory for the signature
+# verification from a static arena of CRYPTO_ARENA_SIZE bytes instead of the
+# heap. The Bootloader app logs the peak arena use and the stack high-water
+# mark after boot_go(). See README.md.
+USE_CRYPTO_ARENA?=0
+CRYPTO_ARENA_SIZE?=0x3000
+
+# Minimal crypto
+# When set to `1`, mbedTLS is built with a configuration that only supports
+# the ECDSA P-256 signature verification and SHA-256, from the library files
+# that this configuration needs instead of the whole library. See README.md.
+USE_MINIMAL_CRYPTO?=0
+
+# Validated-image cache
+# When set to `1`, a warm boot (a reset that keeps the RAM, such as a watchdog
+# or software reset) skips the hash and signature check of boot_go() if the
+# primary slot still holds the image that was fully validated last. It checks
+# the image header, the hash TLV and IMAGE_CACHE_SAMPLES of IMAGE_CACHE_BLOCKS
+# CRC-checked blocks instead. boot_go() validates the image again after
+# IMAGE_CACHE_FULL_PERIOD warm boots. The record is authenticated with a key
+# that the user app cannot read. Requires the overwrite upgrade mode.
+# See README.md.
+USE_IMAGE_CACHE?=0
+IMAGE_CACHE_BLOCKS?=32
+IMAGE_CACHE_SAMPLES?=4
+IMAGE_CACHE_FULL_PERIOD?=16
+
+# Firmware receiver
+# When set to `1`, the Blinky app receives an UPGRADE image sent by
+# scripts/fw_send.py over the debug UART, writes it into the secondary slot
+# and resets to install it. FW_RECEIVER_BLOCK_SIZE is the size of each of the
+# two receive buffers. Requires both slots in internal flash and the padded
+# UPGRADE image of the swap or overwrite upgrade mode. See README.md.
+USE_FW_RECEIVER?=0
+FW_RECEIVER_BLOCK_SIZE?=2048
+
+# Footprint report
+# When set to `1`, the Bootloader app build reports the flash, RAM, and largest
+# stack frame of every component (MCUboot, mbedTLS, HAL/PDL, retarget-io, ...)
+# and fails when one of them grew by more than FOOTPRINT_THRESHOLD bytes over
+# FOOTPRINT_BASELINE, relative to the bootloader_app directory. See README.md.
+USE_FOOTPRINT_REPORT?=0
+FOOTPRINT_BASELINE?=footprint_baseline.json
+FOOTPRINT_THRESHOLD?=256
 
-ifneq ($(ENC_IMG), 0)
-$(error This code example not supported the encrypted image at the moment)
-endif
+# Encrypted image support
+# When set to `1`, the UPGRADE image is encrypted with AES-CTR, its key wrapped
+# with ECIES-P256 for ENC_KEY_FILE, and stays encrypted in the secondary slot.
+# The Bootloader app decrypts and checks it, and only then programs it into the
+# primary slot. Requires the overwrite upgrade mode and a single image flash map.
+# ENC_KEY_FILE must be the public key of the private key built into the
+# Bootloader app by MCUboot. See README.md.
+ENC_IMG?=0
+ENC_KEY_FILE?=$(MCUBOOT_CY_PATH)/keys/enc-ec256-pub.pem
 
 ################################################################################
 # Bootloader App Configuration
@@ -126,9 +235,10 @@ $(error Set IMG_TYPE to be either BOOT or UPGRADE)
 endif
 
 # Image ID
-# Below flag value should correspond to the `application_#` number of JSON flash map file used for the build
-IMG_ID=1
+# Below flag value should correspond to the `application_#` number of JSON flash map file used for the build.
+# Values above 1 need a multi-image flash map, e.g. psoc61_overwrite_multi.json. See README.md.
+IMG_ID?=1
 
-ifneq ($(IMG_ID), 1)
-$(error This code example not supported the multi-image configuration at the moment)
-endif
+# Dependency of the image on another image of a multi-image flash map, passed to the imgtool
+# as "(image_index, version)", e.g. "(1, 1.0.0)". Empty for no dependency. See README.md.
+IMG_DEPENDENCY?=